@@ -161,6 +161,25 @@ LOCAL_CFLAGS := -I$(LOCAL_PATH)/include -I$(LOCAL_PATH)/celt -I$(LOCAL_PATH)/sil
 
 include $(MY_DIR)/a-arch-$(TARGET_ARCH).mk
 
+# SIMD kernels: SSE4.1 is detected at run time on x86, NEON builds use the
+# NEON kernels unconditionally.
+ifeq ($(TARGET_ARCH),$(filter $(TARGET_ARCH),x86 x86_64))
+LOCAL_SRC_FILES += \
+celt/x86/x86cpu.c \
+celt/x86/x86_celt_map.c \
+celt/x86/pitch_sse4_1.c \
+celt/x86/mdct_sse4_1.c \
+silk/x86/x86_silk_map.c \
+silk/x86/decode_core_sse4_1.c
+LOCAL_CFLAGS += -DOPUS_HAVE_RTCD -DOPUS_X86_MAY_HAVE_SSE4_1
+else ifeq ($(VFP),neon)
+LOCAL_SRC_FILES += \
+celt/arm/pitch_neon_intr.c \
+celt/arm/mdct_neon_intr.c \
+silk/arm/decode_core_neon_intr.c
+LOCAL_CFLAGS += -DOPUS_ARM_PRESUME_NEON_INTR
+endif
+
 LOCAL_MODULE    := opus
 include $(BUILD_STATIC_LIBRARY)
 
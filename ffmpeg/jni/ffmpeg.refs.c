@@ -627,4 +627,9 @@ void dummy_main()
     av_stristr();
     av_strlcatf();
     ff_webvtt_secondary_decoder();
+    av_threadpool_init();
+    av_threadpool_uninit();
+    av_buffer_cache_set_limit();
+    av_buffer_cache_trim();
+    av_buffer_cache_get_stats();
 }
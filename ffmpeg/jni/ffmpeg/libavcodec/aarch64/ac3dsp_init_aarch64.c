@@ -0,0 +1,69 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <stdint.h>
+
+#include "libavutil/attributes.h"
+#include "libavutil/cpu.h"
+#include "libavutil/aarch64/cpu.h"
+#include "libavcodec/ac3dsp.h"
+
+void ff_ac3_exponent_min_neon(uint8_t *exp, int num_reuse_blocks, int nb_coefs);
+void ff_float_to_fixed24_neon(int32_t *dst, const float *src, unsigned int len);
+void ff_ac3_extract_exponents_neon(uint8_t *exp, int32_t *coef, int nb_coefs);
+
+#define DOWNMIX_FUNCS(ch)                                                     \
+void ff_ac3_downmix_ ## ch ## _to_1_neon(float **samples, float **matrix,     \
+                                         int len);                            \
+void ff_ac3_downmix_ ## ch ## _to_2_neon(float **samples, float **matrix,     \
+                                         int len);
+
+DOWNMIX_FUNCS(3)
+DOWNMIX_FUNCS(4)
+DOWNMIX_FUNCS(5)
+DOWNMIX_FUNCS(6)
+
+av_cold void ff_ac3dsp_init_aarch64(AC3DSPContext *c, int bit_exact)
+{
+    int cpu_flags = av_get_cpu_flags();
+
+    if (have_neon(cpu_flags)) {
+        c->ac3_exponent_min  = ff_ac3_exponent_min_neon;
+        c->float_to_fixed24  = ff_float_to_fixed24_neon;
+        c->extract_exponents = ff_ac3_extract_exponents_neon;
+    }
+}
+
+void ff_ac3dsp_set_downmix_aarch64(AC3DSPContext *c)
+{
+    int cpu_flags = av_get_cpu_flags();
+
+    if (!have_neon(cpu_flags))
+        return;
+
+#define SET_DOWNMIX(ch)                                                 \
+    if (c->in_channels == ch)                                           \
+        c->downmix = c->out_channels == 1 ?                             \
+                     ff_ac3_downmix_ ## ch ## _to_1_neon :              \
+                     ff_ac3_downmix_ ## ch ## _to_2_neon;
+
+    SET_DOWNMIX(3)
+    SET_DOWNMIX(4)
+    SET_DOWNMIX(5)
+    SET_DOWNMIX(6)
+}
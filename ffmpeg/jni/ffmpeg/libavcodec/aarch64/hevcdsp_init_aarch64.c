@@ -0,0 +1,157 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <stdint.h>
+
+#include "libavutil/attributes.h"
+#include "libavutil/cpu.h"
+#include "libavutil/aarch64/cpu.h"
+#include "libavcodec/hevcdsp.h"
+
+#define HEVC_DSP_FUNCS(depth)                                                                   \
+void ff_hevc_add_residual_4x4_   ## depth ## _neon(uint8_t *dst, int16_t *res, ptrdiff_t stride); \
+void ff_hevc_add_residual_8x8_   ## depth ## _neon(uint8_t *dst, int16_t *res, ptrdiff_t stride); \
+void ff_hevc_add_residual_16x16_ ## depth ## _neon(uint8_t *dst, int16_t *res, ptrdiff_t stride); \
+void ff_hevc_add_residual_32x32_ ## depth ## _neon(uint8_t *dst, int16_t *res, ptrdiff_t stride); \
+void ff_hevc_idct_4x4_   ## depth ## _neon(int16_t *coeffs, int col_limit);                    \
+void ff_hevc_idct_8x8_   ## depth ## _neon(int16_t *coeffs, int col_limit);                    \
+void ff_hevc_idct_16x16_ ## depth ## _neon(int16_t *coeffs, int col_limit);                    \
+void ff_hevc_idct_32x32_ ## depth ## _neon(int16_t *coeffs, int col_limit);                    \
+void ff_hevc_idct_4x4_dc_   ## depth ## _neon(int16_t *coeffs);                                \
+void ff_hevc_idct_8x8_dc_   ## depth ## _neon(int16_t *coeffs);                                \
+void ff_hevc_idct_16x16_dc_ ## depth ## _neon(int16_t *coeffs);                                \
+void ff_hevc_idct_32x32_dc_ ## depth ## _neon(int16_t *coeffs);                                \
+void ff_hevc_transform_luma_4x4_ ## depth ## _neon(int16_t *coeffs);                           \
+void ff_hevc_sao_band_filter_ ## depth ## _neon(uint8_t *dst, uint8_t *src,                    \
+                                                ptrdiff_t stride_dst, ptrdiff_t stride_src,    \
+                                                int16_t *sao_offset_val, int sao_left_class,   \
+                                                int width, int height);                        \
+void ff_hevc_sao_edge_filter_ ## depth ## _neon(uint8_t *dst, uint8_t *src,                    \
+                                                ptrdiff_t stride_dst, int16_t *sao_offset_val, \
+                                                int eo, int width, int height);                \
+void ff_hevc_h_loop_filter_luma_ ## depth ## _neon(uint8_t *pix, ptrdiff_t stride, int beta,   \
+                                                   int32_t *tc, uint8_t *no_p, uint8_t *no_q); \
+void ff_hevc_v_loop_filter_luma_ ## depth ## _neon(uint8_t *pix, ptrdiff_t stride, int beta,   \
+                                                   int32_t *tc, uint8_t *no_p, uint8_t *no_q); \
+void ff_hevc_h_loop_filter_chroma_ ## depth ## _neon(uint8_t *pix, ptrdiff_t stride,           \
+                                                     int32_t *tc, uint8_t *no_p,               \
+                                                     uint8_t *no_q);                           \
+void ff_hevc_v_loop_filter_chroma_ ## depth ## _neon(uint8_t *pix, ptrdiff_t stride,           \
+                                                     int32_t *tc, uint8_t *no_p,               \
+                                                     uint8_t *no_q)
+
+#define MC_FUNCS(type, fn, depth)                                                               \
+void ff_hevc_put_hevc_ ## type ## _ ## fn ## _ ## depth ## _neon(int16_t *dst, uint8_t *src,    \
+                                                                ptrdiff_t srcstride, int height, \
+                                                                intptr_t mx, intptr_t my,       \
+                                                                int width);                     \
+void ff_hevc_put_hevc_ ## type ## _uni_ ## fn ## _ ## depth ## _neon(uint8_t *dst,              \
+                                                                    ptrdiff_t dststride,        \
+                                                                    uint8_t *src,               \
+                                                                    ptrdiff_t srcstride,        \
+                                                                    int height, intptr_t mx,    \
+                                                                    intptr_t my, int width);    \
+void ff_hevc_put_hevc_ ## type ## _bi_ ## fn ## _ ## depth ## _neon(uint8_t *dst,               \
+                                                                   ptrdiff_t dststride,         \
+                                                                   uint8_t *src,                \
+                                                                   ptrdiff_t srcstride,         \
+                                                                   int16_t *src2, int height,   \
+                                                                   intptr_t mx, intptr_t my,    \
+                                                                   int width)
+
+#define HEVC_MC_FUNCS(depth)       \
+    MC_FUNCS(pel,  pixels, depth); \
+    MC_FUNCS(qpel, h,      depth); \
+    MC_FUNCS(qpel, v,      depth); \
+    MC_FUNCS(qpel, hv,     depth); \
+    MC_FUNCS(epel, h,      depth); \
+    MC_FUNCS(epel, v,      depth); \
+    MC_FUNCS(epel, hv,     depth)
+
+HEVC_DSP_FUNCS(8);
+HEVC_DSP_FUNCS(10);
+HEVC_MC_FUNCS(8);
+HEVC_MC_FUNCS(10);
+
+/* The MC functions handle any of the block widths, so the same function
+ * goes into all width slots of the tables. */
+#define MC_SET(tab, idx1, idx2, fn)                 \
+    do {                                            \
+        int i;                                      \
+        for (i = 0; i < 10; i++)                    \
+            c->tab[i][idx1][idx2] = fn;             \
+    } while (0)
+
+#define MC_INIT(type, depth)                                                             \
+    do {                                                                                 \
+        MC_SET(put_hevc_ ## type,        0, 0, ff_hevc_put_hevc_pel_pixels_     ## depth ## _neon); \
+        MC_SET(put_hevc_ ## type ## _uni, 0, 0, ff_hevc_put_hevc_pel_uni_pixels_ ## depth ## _neon); \
+        MC_SET(put_hevc_ ## type ## _bi,  0, 0, ff_hevc_put_hevc_pel_bi_pixels_  ## depth ## _neon); \
+        MC_SET(put_hevc_ ## type,        0, 1, ff_hevc_put_hevc_ ## type ## _h_      ## depth ## _neon); \
+        MC_SET(put_hevc_ ## type ## _uni, 0, 1, ff_hevc_put_hevc_ ## type ## _uni_h_  ## depth ## _neon); \
+        MC_SET(put_hevc_ ## type ## _bi,  0, 1, ff_hevc_put_hevc_ ## type ## _bi_h_   ## depth ## _neon); \
+        MC_SET(put_hevc_ ## type,        1, 0, ff_hevc_put_hevc_ ## type ## _v_      ## depth ## _neon); \
+        MC_SET(put_hevc_ ## type ## _uni, 1, 0, ff_hevc_put_hevc_ ## type ## _uni_v_  ## depth ## _neon); \
+        MC_SET(put_hevc_ ## type ## _bi,  1, 0, ff_hevc_put_hevc_ ## type ## _bi_v_   ## depth ## _neon); \
+        MC_SET(put_hevc_ ## type,        1, 1, ff_hevc_put_hevc_ ## type ## _hv_     ## depth ## _neon); \
+        MC_SET(put_hevc_ ## type ## _uni, 1, 1, ff_hevc_put_hevc_ ## type ## _uni_hv_ ## depth ## _neon); \
+        MC_SET(put_hevc_ ## type ## _bi,  1, 1, ff_hevc_put_hevc_ ## type ## _bi_hv_  ## depth ## _neon); \
+    } while (0)
+
+#define HEVC_DSP_INIT(depth)                                                          \
+    do {                                                                              \
+        int i;                                                                        \
+        c->add_residual[0]           = ff_hevc_add_residual_4x4_   ## depth ## _neon; \
+        c->add_residual[1]           = ff_hevc_add_residual_8x8_   ## depth ## _neon; \
+        c->add_residual[2]           = ff_hevc_add_residual_16x16_ ## depth ## _neon; \
+        c->add_residual[3]           = ff_hevc_add_residual_32x32_ ## depth ## _neon; \
+        c->idct[0]                   = ff_hevc_idct_4x4_   ## depth ## _neon;         \
+        c->idct[1]                   = ff_hevc_idct_8x8_   ## depth ## _neon;         \
+        c->idct[2]                   = ff_hevc_idct_16x16_ ## depth ## _neon;         \
+        c->idct[3]                   = ff_hevc_idct_32x32_ ## depth ## _neon;         \
+        c->idct_dc[0]                = ff_hevc_idct_4x4_dc_   ## depth ## _neon;      \
+        c->idct_dc[1]                = ff_hevc_idct_8x8_dc_   ## depth ## _neon;      \
+        c->idct_dc[2]                = ff_hevc_idct_16x16_dc_ ## depth ## _neon;      \
+        c->idct_dc[3]                = ff_hevc_idct_32x32_dc_ ## depth ## _neon;      \
+        c->transform_4x4_luma        = ff_hevc_transform_luma_4x4_ ## depth ## _neon; \
+        for (i = 0; i < 5; i++) {                                                     \
+            c->sao_band_filter[i]    = ff_hevc_sao_band_filter_ ## depth ## _neon;    \
+            c->sao_edge_filter[i]    = ff_hevc_sao_edge_filter_ ## depth ## _neon;    \
+        }                                                                             \
+        c->hevc_h_loop_filter_luma   = ff_hevc_h_loop_filter_luma_   ## depth ## _neon; \
+        c->hevc_v_loop_filter_luma   = ff_hevc_v_loop_filter_luma_   ## depth ## _neon; \
+        c->hevc_h_loop_filter_chroma = ff_hevc_h_loop_filter_chroma_ ## depth ## _neon; \
+        c->hevc_v_loop_filter_chroma = ff_hevc_v_loop_filter_chroma_ ## depth ## _neon; \
+        MC_INIT(qpel, depth);                                                         \
+        MC_INIT(epel, depth);                                                         \
+    } while (0)
+
+/* Not called from ff_hevc_dsp_init() yet: enable it once the hevc_* checkasm
+ * tests pass under qemu-aarch64 or on hardware. */
+av_cold void ff_hevc_dsp_init_aarch64(HEVCDSPContext *c, const int bit_depth)
+{
+    int cpu_flags = av_get_cpu_flags();
+
+    if (!have_neon(cpu_flags))
+        return;
+
+    if (bit_depth == 8)
+        HEVC_DSP_INIT(8);
+    else if (bit_depth == 10)
+        HEVC_DSP_INIT(10);
+}
@@ -719,6 +719,59 @@ static inline void do_imdct(AC3DecodeContext *s, int channels, int offset)
     }
 }
 
+#if !USE_FIXED
+/**
+ * Downmix and inverse MDCT of a block which mixes long and short transforms.
+ * The short transform channels are transformed on their own and downmixed in
+ * the time domain, the long transform channels are downmixed before the
+ * transform. This only needs out_channels 512 point transforms and keeps the
+ * delay downmixed.
+ */
+static void do_imdct_downmix(AC3DecodeContext *s, int offset)
+{
+    int ch, i;
+
+    for (i = 0; i < s->out_channels; i++)
+        memset(s->short_mix[i], 0, sizeof(s->short_mix[i]));
+
+    for (ch = 1; ch <= s->fbw_channels; ch++) {
+        FFTSample *x = s->tmp_output + 128;
+        if (!s->block_switch[ch])
+            continue;
+        for (i = 0; i < 128; i++)
+            x[i] = s->transform_coeffs[ch][2 * i];
+        s->imdct_256.imdct_half(&s->imdct_256, s->tmp_output, x);
+        for (i = 0; i < s->out_channels; i++)
+            s->fdsp->vector_fmac_scalar(s->short_mix[i], s->tmp_output,
+                                        s->downmix_coeffs[i][ch - 1], 128);
+        for (i = 0; i < 128; i++)
+            x[i] = s->transform_coeffs[ch][2 * i + 1];
+        s->imdct_256.imdct_half(&s->imdct_256, s->tmp_output, x);
+        for (i = 0; i < s->out_channels; i++)
+            s->fdsp->vector_fmac_scalar(s->short_mix[i] + 128, s->tmp_output,
+                                        s->downmix_coeffs[i][ch - 1], 128);
+        memset(s->transform_coeffs[ch], 0, sizeof(s->transform_coeffs[ch]));
+    }
+
+    ff_ac3dsp_downmix(&s->ac3dsp, s->xcfptr + 1, s->downmix_coeffs,
+                      s->out_channels, s->fbw_channels, 256);
+    if (!s->downmixed) {
+        s->downmixed = 1;
+        ff_ac3dsp_downmix(&s->ac3dsp, s->dlyptr, s->downmix_coeffs,
+                          s->out_channels, s->fbw_channels, 128);
+    }
+
+    for (ch = 1; ch <= s->out_channels; ch++) {
+        s->imdct_512.imdct_half(&s->imdct_512, s->tmp_output, s->transform_coeffs[ch]);
+        for (i = 0; i < 256; i++)
+            s->tmp_output[i] += s->short_mix[ch - 1][i];
+        s->fdsp->vector_fmul_window(s->outptr[ch - 1], s->delay[ch - 1 + offset],
+                                    s->tmp_output, s->window, 128);
+        memcpy(s->delay[ch - 1 + offset], s->tmp_output + 128, 128 * sizeof(FFTSample));
+    }
+}
+#endif
+
 /**
  * Upmix delay samples from stereo to original channel layout.
  */
@@ -1419,6 +1472,11 @@ static int decode_audio_block(AC3DecodeContext *s, int blk, int offset)
     downmix_output = s->channels != s->out_channels &&
                      !((s->output_mode & AC3_OUTPUT_LFEON) &&
                      s->fbw_channels == s->out_channels);
+#if !USE_FIXED
+    if (different_transforms && downmix_output) {
+        do_imdct_downmix(s, offset);
+    } else
+#endif
     if (different_transforms) {
         /* the delay samples have already been downmixed, so we upmix the delay
            samples in order to reconstruct all channels before downmixing. */
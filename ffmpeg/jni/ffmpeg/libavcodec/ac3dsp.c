@@ -409,6 +409,8 @@ void ff_ac3dsp_downmix(AC3DSPContext *c, float **samples, float **matrix,
             c->downmix = ac3_downmix_5_to_1_symmetric_c;
         }
 
+        if (ARCH_AARCH64)
+            ff_ac3dsp_set_downmix_aarch64(c);
         if (ARCH_X86)
             ff_ac3dsp_set_downmix_x86(c);
     }
@@ -438,6 +440,8 @@ av_cold void ff_ac3dsp_init(AC3DSPContext *c, int bit_exact)
     c->downmix_fixed         = NULL;
     c->apply_window_int16 = apply_window_int16_c;
 
+    if (ARCH_AARCH64)
+        ff_ac3dsp_init_aarch64(c, bit_exact);
     if (ARCH_ARM)
         ff_ac3dsp_init_arm(c, bit_exact);
     if (ARCH_X86)
@@ -153,6 +153,7 @@ typedef struct AC3DSPContext {
 } AC3DSPContext;
 
 void ff_ac3dsp_init    (AC3DSPContext *c, int bit_exact);
+void ff_ac3dsp_init_aarch64(AC3DSPContext *c, int bit_exact);
 void ff_ac3dsp_init_arm(AC3DSPContext *c, int bit_exact);
 void ff_ac3dsp_init_x86(AC3DSPContext *c, int bit_exact);
 void ff_ac3dsp_init_mips(AC3DSPContext *c, int bit_exact);
@@ -162,6 +163,7 @@ void ff_ac3dsp_downmix(AC3DSPContext *c, float **samples, float **matrix,
 void ff_ac3dsp_downmix_fixed(AC3DSPContext *c, int32_t **samples, int16_t **matrix,
                              int out_ch, int in_ch, int len);
 
+void ff_ac3dsp_set_downmix_aarch64(AC3DSPContext *c);
 void ff_ac3dsp_set_downmix_x86(AC3DSPContext *c);
 
 #endif /* AVCODEC_AC3DSP_H */
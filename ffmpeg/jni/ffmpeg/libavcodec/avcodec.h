@@ -2891,6 +2891,14 @@ typedef struct AVCodecContext {
      * Which multithreading methods to use.
      * Use of FF_THREAD_FRAME will increase decoding delay by one frame per thread,
      * so clients which cannot provide future frames should not use it.
+     * With FF_THREAD_ADAPTIVE, frame threading starts without delay after
+     * opening and flushing, and adds one frame of delay every other packet
+     * until all threads are busy. Thread contexts are only created as they
+     * are needed.
+     * With FF_THREAD_HYBRID, decoders supporting it also split each frame
+     * of a frame thread across thread_count slice threads, e.g. the CTU rows
+     * of HEVC streams coded with wavefront parallel processing. These run on
+     * the process-wide pool when it is enabled (see av_threadpool_init()).
      *
      * - encoding: Set by user, otherwise the default is used.
      * - decoding: Set by user, otherwise the default is used.
@@ -2898,6 +2906,8 @@ typedef struct AVCodecContext {
     int thread_type;
 #define FF_THREAD_FRAME   1 ///< Decode more than one frame at once
 #define FF_THREAD_SLICE   2 ///< Decode more than one part of a single frame at once
+#define FF_THREAD_ADAPTIVE 4 ///< Ramp up frame threading after open and flush
+#define FF_THREAD_HYBRID   8 ///< Use slice threading within each frame thread
 
     /**
      * Which multithreading methods are in use by the codec.
@@ -3452,6 +3462,35 @@ typedef struct AVCodecContext {
      * - encoding: set by user
      */
     int export_side_data;
+
+    /**
+     * Video decoding only. Presentation timestamp, in pkt_timebase units,
+     * the caller wants to catch up to after falling behind, or
+     * AV_NOPTS_VALUE to decode normally.
+     *
+     * Packets with an earlier timestamp are decoded at a reduced quality
+     * that depends on how far behind they are: non-reference frames are
+     * skipped first, then the loop filter is skipped on the reference
+     * frames, and from 2 seconds on only keyframes are decoded until a
+     * keyframe is reached again. Without pkt_timebase, only the
+     * non-reference frames are skipped. skip_frame and skip_loop_filter are
+     * only ever raised by this. The decoders must support those options.
+     *
+     * - decoding: set by user, may be changed between decoding calls
+     * - encoding: unused
+     */
+    int64_t catchup_pts;
+
+    /**
+     * Number of packets decoded while catching up since the decoder was
+     * opened. Index 0 counts the packets decoded without non-reference
+     * frames. Index 1 counts those also decoded without the loop filter.
+     * Index 2 counts those decoded while only keyframes were decoded.
+     *
+     * - decoding: set by libavcodec
+     * - encoding: unused
+     */
+    int64_t catchup_packets[3];
 } AVCodecContext;
 
 #if FF_API_CODEC_GET_SET
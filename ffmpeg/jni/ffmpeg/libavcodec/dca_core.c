@@ -2157,11 +2157,57 @@ static int filter_frame_fixed(DCACoreDecoder *s, AVFrame *frame)
     return 0;
 }
 
+// Extra precision bits of the downmixed subband samples
+#define DMIX_SUBBAND_BITS   4
+
+/**
+ * Downmix the primary channel subband samples to stereo, so that only two
+ * channels have to go through the filter bank. The filter bank is linear,
+ * this is the same as downmixing its output.
+ */
+static int downmix_subbands(DCACoreDecoder *s)
+{
+    int *coeff_l = s->prim_dmix_coeff;
+    int *coeff_r = coeff_l + av_popcount(s->ch_mask);
+    int coeff[2][DCA_CHANNELS];
+    int i, n, ch, band, spkr, pos;
+
+    av_fast_malloc(&s->dmix_subband_buffer, &s->dmix_subband_size,
+                   2 * DCA_SUBBANDS * s->npcmblocks * sizeof(int32_t));
+    if (!s->dmix_subband_buffer)
+        return AVERROR(ENOMEM);
+
+    for (ch = 0; ch < s->nchannels; ch++) {
+        spkr = map_prm_ch_to_spkr(s, ch);
+        if (spkr < 0)
+            return AVERROR(EINVAL);
+        pos = av_popcount(s->ch_mask & ((1U << spkr) - 1));
+        coeff[0][ch] = coeff_l[pos];
+        coeff[1][ch] = coeff_r[pos];
+    }
+
+    for (i = 0; i < 2; i++) {
+        for (band = 0; band < DCA_SUBBANDS; band++) {
+            int32_t *dst = s->dmix_subband_buffer + (i * DCA_SUBBANDS + band) * s->npcmblocks;
+
+            s->dmix_subband_samples[i][band] = dst;
+            for (n = 0; n < s->npcmblocks; n++) {
+                int64_t acc = 0;
+                for (ch = 0; ch < s->nchannels; ch++)
+                    acc += (int64_t)coeff[i][ch] * s->subband_samples[ch][band][n];
+                dst[n] = av_clipl_int32((acc + (1 << (14 - DMIX_SUBBAND_BITS))) >> (15 - DMIX_SUBBAND_BITS));
+            }
+        }
+    }
+
+    return 0;
+}
+
 static int filter_frame_float(DCACoreDecoder *s, AVFrame *frame)
 {
     AVCodecContext *avctx = s->avctx;
     int x96_nchannels = 0, x96_synth = 0;
-    int i, n, ch, ret, spkr, nsamples, nchannels;
+    int i, n, ch, ret, spkr, nsamples, nchannels, dmix;
     float *output_samples[DCA_SPEAKER_COUNT] = { NULL }, *ptr;
     const float *filter_coeff;
 
@@ -2201,8 +2247,17 @@ static int filter_frame_float(DCACoreDecoder *s, AVFrame *frame)
         }
     }
 
+    // Downmix to stereo before the filter bank unless something has to be
+    // done with the individual channels between the filter bank and the
+    // downmix
+    dmix = s->request_mask != s->ch_mask && !x96_synth
+        && !(s->ext_audio_mask & (DCA_CSS_XXCH | DCA_CSS_XCH | DCA_EXSS_XXCH))
+        && !(s->sumdiff_front && s->audio_mode > DCA_AMODE_MONO)
+        && !(s->sumdiff_surround && s->audio_mode >= DCA_AMODE_2F2R)
+        && s->audio_mode != DCA_AMODE_STEREO_SUMDIFF;
+
     // Handle change of filtering mode
-    set_filter_mode(s, x96_synth);
+    set_filter_mode(s, x96_synth | (dmix ? DCA_FILTER_MODE_DMIX : 0));
 
     // Select filter
     if (x96_synth)
@@ -2212,26 +2267,47 @@ static int filter_frame_float(DCACoreDecoder *s, AVFrame *frame)
     else
         filter_coeff = ff_dca_fir_32bands_nonperfect;
 
-    // Filter primary channels
-    for (ch = 0; ch < s->nchannels; ch++) {
-        // Map this primary channel to speaker
-        spkr = map_prm_ch_to_spkr(s, ch);
-        if (spkr < 0)
-            return AVERROR(EINVAL);
+    if (dmix) {
+        if ((ret = downmix_subbands(s)) < 0)
+            return ret;
 
-        // Filter bank reconstruction
-        s->dcadsp->sub_qmf_float[x96_synth](
-            &s->synth,
-            &s->imdct[x96_synth],
-            output_samples[spkr],
-            s->subband_samples[ch],
-            ch < x96_nchannels ? s->x96_subband_samples[ch] : NULL,
-            s->dcadsp_data[ch].u.flt.hist1,
-            &s->dcadsp_data[ch].offset,
-            s->dcadsp_data[ch].u.flt.hist2,
-            filter_coeff,
-            s->npcmblocks,
-            1.0f / (1 << (17 - x96_synth)));
+        // Filter downmixed channels
+        for (ch = 0; ch < 2; ch++) {
+            s->dcadsp->sub_qmf_float[0](
+                &s->synth,
+                &s->imdct[0],
+                output_samples[DCA_SPEAKER_L + ch],
+                s->dmix_subband_samples[ch],
+                NULL,
+                s->dcadsp_data[ch].u.flt.hist1,
+                &s->dcadsp_data[ch].offset,
+                s->dcadsp_data[ch].u.flt.hist2,
+                filter_coeff,
+                s->npcmblocks,
+                1.0f / (1 << (17 + DMIX_SUBBAND_BITS)));
+        }
+    } else {
+        // Filter primary channels
+        for (ch = 0; ch < s->nchannels; ch++) {
+            // Map this primary channel to speaker
+            spkr = map_prm_ch_to_spkr(s, ch);
+            if (spkr < 0)
+                return AVERROR(EINVAL);
+
+            // Filter bank reconstruction
+            s->dcadsp->sub_qmf_float[x96_synth](
+                &s->synth,
+                &s->imdct[x96_synth],
+                output_samples[spkr],
+                s->subband_samples[ch],
+                ch < x96_nchannels ? s->x96_subband_samples[ch] : NULL,
+                s->dcadsp_data[ch].u.flt.hist1,
+                &s->dcadsp_data[ch].offset,
+                s->dcadsp_data[ch].u.flt.hist2,
+                filter_coeff,
+                s->npcmblocks,
+                1.0f / (1 << (17 - x96_synth)));
+        }
     }
 
     // Filter LFE channel
@@ -2266,8 +2342,29 @@ static int filter_frame_float(DCACoreDecoder *s, AVFrame *frame)
         // Update LFE history
         for (n = DCA_LFE_HISTORY - 1; n >= 0; n--)
             s->lfe_samples[n] = s->lfe_samples[nlfesamples + n];
+
+        // Mix LFE into the downmixed channels
+        if (dmix) {
+            int *coeff_l = s->prim_dmix_coeff;
+            int *coeff_r = coeff_l + av_popcount(s->ch_mask);
+            int pos = av_popcount(s->ch_mask & (DCA_SPEAKER_MASK_LFE1 - 1));
+
+            if (coeff_l[pos])
+                s->float_dsp->vector_fmac_scalar(output_samples[DCA_SPEAKER_L],
+                                                 output_samples[DCA_SPEAKER_LFE1],
+                                                 coeff_l[pos] * (1.0f / (1 << 15)),
+                                                 nsamples);
+            if (coeff_r[pos])
+                s->float_dsp->vector_fmac_scalar(output_samples[DCA_SPEAKER_R],
+                                                 output_samples[DCA_SPEAKER_LFE1],
+                                                 coeff_r[pos] * (1.0f / (1 << 15)),
+                                                 nsamples);
+        }
     }
 
+    if (dmix)
+        return 0;
+
     // Undo embedded XCH downmix
     if (s->es_format && (s->ext_audio_mask & DCA_CSS_XCH)
         && s->audio_mode >= DCA_AMODE_2F2R) {
@@ -2441,6 +2538,9 @@ av_cold void ff_dca_core_close(DCACoreDecoder *s)
     av_freep(&s->x96_subband_buffer);
     s->x96_subband_size = 0;
 
+    av_freep(&s->dmix_subband_buffer);
+    s->dmix_subband_size = 0;
+
     av_freep(&s->output_buffer);
     s->output_size = 0;
 }
@@ -55,6 +55,7 @@
 
 #define DCA_FILTER_MODE_X96     0x01
 #define DCA_FILTER_MODE_FIXED   0x02
+#define DCA_FILTER_MODE_DMIX    0x04
 
 enum DCACoreAudioMode {
     DCA_AMODE_MONO,             // Mode 0: A (mono)
@@ -188,6 +189,10 @@ typedef struct DCACoreDecoder {
     int32_t         *subband_samples[DCA_CHANNELS][DCA_SUBBANDS];   ///< Subband samples
     int32_t         *lfe_samples;    ///< Decimated LFE samples
 
+    unsigned int    dmix_subband_size;
+    int32_t         *dmix_subband_buffer;   ///< Stereo downmixed subband sample buffer base
+    int32_t         *dmix_subband_samples[2][DCA_SUBBANDS]; ///< Stereo downmixed subband samples
+
     // DSP contexts
     DCADSPData              dcadsp_data[DCA_CHANNELS];    ///< FIR history buffers
     DCADSPContext           *dcadsp;
@@ -485,6 +485,8 @@ av_cold void ff_dcadsp_init(DCADSPContext *s)
     s->lbr_bank = lbr_bank_c;
     s->lfe_iir = lfe_iir_c;
 
+    if (ARCH_AARCH64)
+        ff_dcadsp_init_aarch64(s);
     if (ARCH_X86)
         ff_dcadsp_init_x86(s);
 }
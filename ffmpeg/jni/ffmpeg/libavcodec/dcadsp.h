@@ -94,6 +94,7 @@ typedef struct DCADSPContext {
 } DCADSPContext;
 
 av_cold void ff_dcadsp_init(DCADSPContext *s);
+av_cold void ff_dcadsp_init_aarch64(DCADSPContext *s);
 av_cold void ff_dcadsp_init_x86(DCADSPContext *s);
 
 #endif
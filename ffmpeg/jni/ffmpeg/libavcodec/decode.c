@@ -37,6 +37,7 @@
 #include "libavutil/internal.h"
 #include "libavutil/intmath.h"
 #include "libavutil/opt.h"
+#include "libavutil/timestamp.h"
 
 #include "avcodec.h"
 #include "bytestream.h"
@@ -325,6 +326,107 @@ static int bsfs_poll(AVCodecContext *avctx, AVPacket *pkt)
     return AVERROR(EAGAIN);
 }
 
+/* how far behind, in seconds, the loop filter is skipped too, and from
+ * which on only keyframes are decoded */
+#define CATCHUP_LOOP_FILTER_LAG 0.5
+#define CATCHUP_KEYFRAME_LAG    2.0
+
+static void catchup_set_discard(AVCodecContext *avctx)
+{
+    static const enum AVDiscard skip_frame[] = {
+        AVDISCARD_DEFAULT, AVDISCARD_NONREF, AVDISCARD_NONREF, AVDISCARD_NONKEY,
+    };
+    static const enum AVDiscard skip_loop_filter[] = {
+        AVDISCARD_DEFAULT, AVDISCARD_DEFAULT, AVDISCARD_ALL, AVDISCARD_ALL,
+    };
+    AVCodecInternal *avci = avctx->internal;
+    int level = avci->catchup_level;
+
+    avctx->skip_frame       = !level ? avci->catchup_user_skip_frame :
+                              FFMAX(avci->catchup_user_skip_frame, skip_frame[level]);
+    avctx->skip_loop_filter = !level ? avci->catchup_user_skip_loop_filter :
+                              FFMAX(avci->catchup_user_skip_loop_filter, skip_loop_filter[level]);
+}
+
+/* the discard options are raised while the decoder runs and restored
+ * afterwards, so that the values set by the user are kept */
+static void catchup_apply(AVCodecContext *avctx)
+{
+    AVCodecInternal *avci = avctx->internal;
+
+    if (avctx->catchup_pts == AV_NOPTS_VALUE && !avci->catchup_level)
+        return;
+
+    avci->catchup_user_skip_frame       = avctx->skip_frame;
+    avci->catchup_user_skip_loop_filter = avctx->skip_loop_filter;
+    avci->catchup_applied = 1;
+    catchup_set_discard(avctx);
+}
+
+static void catchup_restore(AVCodecContext *avctx)
+{
+    AVCodecInternal *avci = avctx->internal;
+
+    if (!avci->catchup_applied)
+        return;
+
+    avctx->skip_frame       = avci->catchup_user_skip_frame;
+    avctx->skip_loop_filter = avci->catchup_user_skip_loop_filter;
+    avci->catchup_applied = 0;
+}
+
+static void catchup_update(AVCodecContext *avctx, const AVPacket *pkt)
+{
+    AVCodecInternal *avci = avctx->internal;
+    int64_t pts = pkt->pts != AV_NOPTS_VALUE ? pkt->pts : pkt->dts;
+    int level = 0, i;
+
+    if (avctx->codec_type != AVMEDIA_TYPE_VIDEO || !pkt->size)
+        return;
+
+    /* reordered frames may be earlier than a frame that reached the target */
+    if (avctx->catchup_pts != AV_NOPTS_VALUE &&
+        !(avci->catchup_reached && avci->catchup_reached_pts == avctx->catchup_pts)) {
+        if (pts == AV_NOPTS_VALUE) {
+            level = avci->catchup_level;
+        } else if (pts >= avctx->catchup_pts) {
+            avci->catchup_reached     = 1;
+            avci->catchup_reached_pts = avctx->catchup_pts;
+        } else {
+            level = 1;
+            if (avctx->pkt_timebase.num > 0 && avctx->pkt_timebase.den > 0) {
+                double lag = (avctx->catchup_pts - pts) * av_q2d(avctx->pkt_timebase);
+                if (lag >= CATCHUP_KEYFRAME_LAG)
+                    level = 3;
+                else if (lag >= CATCHUP_LOOP_FILTER_LAG)
+                    level = 2;
+            }
+        }
+    }
+    /* the references of the following frames are missing up to the next
+     * keyframe */
+    if (avci->catchup_level == 3 && !(pkt->flags & AV_PKT_FLAG_KEY))
+        level = 3;
+
+    if (level && !avci->catchup_level) {
+        for (i = 0; i < 3; i++)
+            avci->catchup_start_packets[i] = avctx->catchup_packets[i];
+    } else if (!level && avci->catchup_level) {
+        av_log(avctx, AV_LOG_VERBOSE, "Caught up at pts %s: %"PRId64" packets "
+               "without non-reference frames, %"PRId64" without loop filter, "
+               "%"PRId64" keyframes only\n", av_ts2str(pts),
+               avctx->catchup_packets[0] - avci->catchup_start_packets[0],
+               avctx->catchup_packets[1] - avci->catchup_start_packets[1],
+               avctx->catchup_packets[2] - avci->catchup_start_packets[2]);
+    }
+    if (level)
+        avctx->catchup_packets[level - 1]++;
+    avci->catchup_level = level;
+
+    if (avci->catchup_applied)
+        catchup_set_discard(avctx);
+}
+
 int ff_decode_get_packet(AVCodecContext *avctx, AVPacket *pkt)
 {
     AVCodecInternal *avci = avctx->internal;
@@ -350,6 +452,8 @@ int ff_decode_get_packet(AVCodecContext *avctx, AVPacket *pkt)
     if (avctx->codec->receive_frame)
         avci->compat_decode_consumed += pkt->size;
 
+    catchup_update(avctx, pkt);
+
     return 0;
 finish:
     av_packet_unref(pkt);
@@ -640,10 +744,12 @@ static int decode_receive_frame_internal(AVCodecContext *avctx, AVFrame *frame)
 
     av_assert0(!frame->buf[0]);
 
+    catchup_apply(avctx);
     if (avctx->codec->receive_frame)
         ret = avctx->codec->receive_frame(avctx, frame);
     else
         ret = decode_simple_receive_frame(avctx, frame);
+    catchup_restore(avctx);
 
     if (ret == AVERROR_EOF)
         avci->draining_done = 1;
@@ -1554,7 +1660,7 @@ static int update_frame_pool(AVCodecContext *avctx, AVFrame *frame)
                 pool->pools[i] = av_buffer_pool_init(size[i] + 16 + STRIDE_ALIGN - 1,
                                                      CONFIG_MEMORY_POISONING ?
                                                         NULL :
-                                                        av_buffer_allocz);
+                                                        av_buffer_cache_alloc);
                 if (!pool->pools[i]) {
                     ret = AVERROR(ENOMEM);
                     goto fail;
@@ -2043,6 +2149,9 @@ void avcodec_flush_buffers(AVCodecContext *avctx)
 
     av_packet_unref(avci->ds.in_pkt);
 
+    avci->catchup_level   = 0;
+    avci->catchup_reached = 0;
+
     if (HAVE_THREADS && avctx->active_thread_type & FF_THREAD_FRAME)
         ff_thread_flush(avctx);
     else if (avctx->codec->flush)
@@ -258,6 +258,7 @@ static int decode_dvd_subtitles(DVDSubContext *ctx, AVSubtitle *sub_header,
     int is_menu = 0;
     uint32_t size;
     int64_t offset1, offset2;
+    int64_t bitmap_offset1 = -1, bitmap_offset2 = -1; // RLE data of the decoded bitmap
 
     if (buf_size < 10)
         return -1;
@@ -397,7 +398,14 @@ static int decode_dvd_subtitles(DVDSubContext *ctx, AVSubtitle *sub_header,
             h = y2 - y1 + 1;
             if (h < 0)
                 h = 0;
-            if (w > 0 && h > 1) {
+            if (w > 0 && h > 1 && sub_header->num_rects &&
+                offset1 == bitmap_offset1 && offset2 == bitmap_offset2 &&
+                sub_header->rects[0]->w == w && sub_header->rects[0]->h == h &&
+                sub_header->rects[0]->nb_colors == (is_8bit ? 256 : 4)) {
+                /* a later command sequence which only changes the colors or
+                 * the position, e.g. to fade the subtitle, keeps the bitmap */
+                bitmap = sub_header->rects[0]->data[0];
+            } else if (w > 0 && h > 1) {
                 reset_rects(sub_header);
                 memset(ctx->used_color, 0, sizeof(ctx->used_color));
                 sub_header->rects = av_mallocz(sizeof(*sub_header->rects));
@@ -419,6 +427,10 @@ static int decode_dvd_subtitles(DVDSubContext *ctx, AVSubtitle *sub_header,
                 sub_header->rects[0]->data[1] = av_mallocz(AVPALETTE_SIZE);
                 if (!sub_header->rects[0]->data[1])
                     goto fail;
+                bitmap_offset1 = offset1;
+                bitmap_offset2 = offset2;
+            }
+            if (w > 0 && h > 1) {
                 if (is_8bit) {
                     if (!yuv_palette)
                         goto fail;
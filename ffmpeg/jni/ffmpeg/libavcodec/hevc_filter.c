@@ -24,6 +24,8 @@
 
 #include "libavutil/common.h"
 #include "libavutil/internal.h"
+#include "libavutil/mem.h"
+#include "libavutil/thread.h"
 
 #include "cabac_functions.h"
 #include "hevcdec.h"
@@ -875,14 +877,290 @@ void ff_hevc_hls_filter(HEVCContext *s, int x, int y, int ctb_size)
         ff_thread_report_progress(&s->ref->tf, y + ctb_size - 4, 0);
 }
 
+#if HAVE_THREADS
+/**
+ * The loop filters of a frame run on a separate thread, one CTB row at a
+ * time. A row is filtered once it and the row below it are decoded, which
+ * keeps the filters off the unfiltered samples intra prediction still reads.
+ * Since the filters are done in raster order like in the inline case, the
+ * output is identical.
+ */
+typedef struct HEVCFilterPipeline {
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+
+    HEVCContext *s;             ///< copy of the decoder context used by the filters
+    HEVCLocalContext *lc;       ///< scratch buffers of the filters
+    AVBufferRef *sps_buf;       ///< keep the parameter sets of the frame alive
+    AVBufferRef *pps_buf;
+
+    uint8_t *ctb_done;          ///< decoded CTBs of the frame, in raster order
+    unsigned int ctb_done_size;
+    uint8_t *row_done;          ///< completely decoded CTB rows of the frame
+    unsigned int row_done_size;
+    int ctb_width;
+    int nb_rows;
+    int next_row;               ///< next CTB row to filter
+
+    int active;                 ///< the frame is filtered by the pipeline, only set by the decoder
+    int busy;                   ///< the frame has rows left to filter
+    int finish;                 ///< the frame is decoded, filter what is left of it
+    int die;
+} HEVCFilterPipeline;
+
+static int pipeline_row_ready(HEVCFilterPipeline *p)
+{
+    int row = p->next_row;
+
+    if (!p->busy)
+        return 0;
+    return p->finish || (p->row_done[row] &&
+                         (row == p->nb_rows - 1 || p->row_done[row + 1]));
+}
+
+/**
+ * @return 1 if the inline filters would have filtered the CTB at x, y in CTB
+ *         units by now, i.e. if the CTB which triggers it is decoded
+ */
+static int pipeline_ctb_filtered(HEVCFilterPipeline *p, int x, int y)
+{
+    const uint8_t *done = p->ctb_done;
+    int w = p->ctb_width;
+
+    if (y < p->nb_rows - 1)
+        return done[(y + 1) * w + FFMIN(x + 1, w - 1)];
+    return done[y * w + FFMIN(x + 1, w - 1)];
+}
+
+static void *attribute_align_arg pipeline_worker(void *arg)
+{
+    HEVCFilterPipeline *p = arg;
+
+    pthread_mutex_lock(&p->mutex);
+    for (;;) {
+        HEVCContext *s;
+        int ctb_size, finish, x, y;
+
+        while (!p->die && !pipeline_row_ready(p))
+            pthread_cond_wait(&p->cond, &p->mutex);
+        if (p->die)
+            break;
+
+        s        = p->s;
+        ctb_size = 1 << s->ps.sps->log2_ctb_size;
+        y        = p->next_row << s->ps.sps->log2_ctb_size;
+        finish   = p->finish;
+        pthread_mutex_unlock(&p->mutex);
+
+        /* after an error or a missing slice, only filter the CTBs the inline
+         * filters would have; the others have stale deblocking and SAO
+         * parameters */
+        for (x = 0; x < s->ps.sps->width; x += ctb_size)
+            if (!finish || pipeline_ctb_filtered(p, x >> s->ps.sps->log2_ctb_size,
+                                                 p->next_row))
+                ff_hevc_hls_filter(s, x, y, ctb_size);
+
+        pthread_mutex_lock(&p->mutex);
+        if (++p->next_row == p->nb_rows) {
+            p->busy = 0;
+            pthread_cond_broadcast(&p->cond);
+        }
+    }
+    pthread_mutex_unlock(&p->mutex);
+
+    return NULL;
+}
+
+/* ctb_done is only read by the filter thread once the frame is finished */
+static void pipeline_ctb_done(HEVCFilterPipeline *p, int x, int y)
+{
+    uint8_t *row = p->ctb_done + y * p->ctb_width;
+
+    row[x] = 1;
+    if (x < p->ctb_width - 1 || memchr(row, 0, p->ctb_width))
+        return;
+
+    pthread_mutex_lock(&p->mutex);
+    p->row_done[y] = 1;
+    pthread_cond_broadcast(&p->cond);
+    pthread_mutex_unlock(&p->mutex);
+}
+
+static av_cold int pipeline_init(HEVCContext *s)
+{
+    HEVCFilterPipeline *p = av_mallocz(sizeof(*p));
+    int ret;
+
+    if (!p)
+        return AVERROR(ENOMEM);
+
+    p->s  = av_malloc(sizeof(*p->s));
+    p->lc = av_mallocz(sizeof(*p->lc));
+    if (!p->s || !p->lc) {
+        ret = AVERROR(ENOMEM);
+        goto fail;
+    }
+
+    if ((ret = pthread_mutex_init(&p->mutex, NULL))) {
+        ret = AVERROR(ret);
+        goto fail;
+    }
+    if ((ret = pthread_cond_init(&p->cond, NULL))) {
+        pthread_mutex_destroy(&p->mutex);
+        ret = AVERROR(ret);
+        goto fail;
+    }
+    if ((ret = pthread_create(&p->thread, NULL, pipeline_worker, p))) {
+        pthread_cond_destroy(&p->cond);
+        pthread_mutex_destroy(&p->mutex);
+        ret = AVERROR(ret);
+        goto fail;
+    }
+
+    s->filter_pipe = p;
+    return 0;
+fail:
+    av_freep(&p->s);
+    av_freep(&p->lc);
+    av_freep(&p);
+    return ret;
+}
+
+int ff_hevc_filter_pipeline_start(HEVCContext *s)
+{
+    HEVCFilterPipeline *p;
+    int ret;
+
+    if (!s->filter_pipeline)
+        return 0;
+
+    /* created before any slice data is decoded, so that the WPP contexts
+     * copied from this one see it */
+    if (!s->filter_pipe) {
+        ret = pipeline_init(s);
+        if (ret < 0) {
+            av_log(s->avctx, AV_LOG_WARNING,
+                   "Could not start the loop filter thread, filtering inline.\n");
+            s->filter_pipeline = 0;
+            return 0;
+        }
+    }
+    p = s->filter_pipe;
+
+    ff_hevc_filter_pipeline_finish(s);
+
+    /* tiles are not decoded in raster order and skip_loop_filter depends on
+     * the slice being decoded */
+    if (s->avctx->hwaccel || s->ps.pps->tiles_enabled_flag ||
+        s->avctx->skip_loop_filter >= AVDISCARD_NONREF)
+        return 0;
+
+    av_fast_malloc(&p->ctb_done, &p->ctb_done_size, s->ps.sps->ctb_size);
+    av_fast_malloc(&p->row_done, &p->row_done_size, s->ps.sps->ctb_height);
+    if (!p->ctb_done || !p->row_done)
+        return AVERROR(ENOMEM);
+
+    p->sps_buf = av_buffer_ref(s->ps.sps_list[s->ps.pps->sps_id]);
+    p->pps_buf = av_buffer_ref(s->ps.pps_list[s->sh.pps_id]);
+    if (!p->sps_buf || !p->pps_buf) {
+        av_buffer_unref(&p->sps_buf);
+        av_buffer_unref(&p->pps_buf);
+        return AVERROR(ENOMEM);
+    }
+
+    pthread_mutex_lock(&p->mutex);
+    memcpy(p->s, s, sizeof(*s));
+    p->s->HEVClc = p->lc;
+    memset(p->ctb_done, 0, s->ps.sps->ctb_size);
+    memset(p->row_done, 0, s->ps.sps->ctb_height);
+    p->ctb_width = s->ps.sps->ctb_width;
+    p->nb_rows   = s->ps.sps->ctb_height;
+    p->next_row = 0;
+    p->finish   = 0;
+    p->busy     = 1;
+    p->active   = 1;
+    pthread_mutex_unlock(&p->mutex);
+
+    return 0;
+}
+
+void ff_hevc_filter_pipeline_finish(HEVCContext *s)
+{
+    HEVCFilterPipeline *p = s->filter_pipe;
+
+    if (!p || !p->active)
+        return;
+
+    pthread_mutex_lock(&p->mutex);
+    p->finish = 1;
+    pthread_cond_broadcast(&p->cond);
+    while (p->busy)
+        pthread_cond_wait(&p->cond, &p->mutex);
+    p->active = 0;
+    pthread_mutex_unlock(&p->mutex);
+
+    av_buffer_unref(&p->sps_buf);
+    av_buffer_unref(&p->pps_buf);
+}
+
+av_cold void ff_hevc_filter_pipeline_free(HEVCContext *s)
+{
+    HEVCFilterPipeline *p = s->filter_pipe;
+
+    if (!p)
+        return;
+
+    ff_hevc_filter_pipeline_finish(s);
+
+    pthread_mutex_lock(&p->mutex);
+    p->die = 1;
+    pthread_cond_broadcast(&p->cond);
+    pthread_mutex_unlock(&p->mutex);
+    pthread_join(p->thread, NULL);
+
+    pthread_cond_destroy(&p->cond);
+    pthread_mutex_destroy(&p->mutex);
+    av_freep(&p->ctb_done);
+    av_freep(&p->row_done);
+    av_freep(&p->s);
+    av_freep(&p->lc);
+    av_freep(&s->filter_pipe);
+}
+#else
+int ff_hevc_filter_pipeline_start(HEVCContext *s)
+{
+    return 0;
+}
+
+void ff_hevc_filter_pipeline_finish(HEVCContext *s)
+{
+}
+
+void ff_hevc_filter_pipeline_free(HEVCContext *s)
+{
+}
+#endif
+
 void ff_hevc_hls_filters(HEVCContext *s, int x_ctb, int y_ctb, int ctb_size)
 {
     int x_end = x_ctb >= s->ps.sps->width  - ctb_size;
     int y_end = y_ctb >= s->ps.sps->height - ctb_size;
+
+#if HAVE_THREADS
+    if (s->filter_pipe && s->filter_pipe->active) {
+        pipeline_ctb_done(s->filter_pipe, x_ctb >> s->ps.sps->log2_ctb_size,
+                          y_ctb >> s->ps.sps->log2_ctb_size);
+        return;
+    }
+#endif
+
     if (y_ctb && x_ctb)
         ff_hevc_hls_filter(s, x_ctb - ctb_size, y_ctb - ctb_size, ctb_size);
     if (y_ctb && x_end)
         ff_hevc_hls_filter(s, x_ctb, y_ctb - ctb_size, ctb_size);
     if (x_ctb && y_end)
         ff_hevc_hls_filter(s, x_ctb - ctb_size, y_ctb, ctb_size);
+    if (x_end && y_end)
+        ff_hevc_hls_filter(s, x_ctb, y_ctb, ctb_size);
 }
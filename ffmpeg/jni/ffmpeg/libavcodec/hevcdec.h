@@ -481,6 +481,8 @@ typedef struct HEVCContext {
     int is_nalff;           ///< this flag is != 0 if bitstream is encapsulated
                             ///< as a format defined in 14496-15
     int apply_defdispwin;
+    int filter_pipeline;    ///< run the loop filters on a separate thread
+    struct HEVCFilterPipeline *filter_pipe;
 
     int nal_length_size;    ///< Number of bytes used for nal length (1, 2 or 4)
     int nuh_layer_id;
@@ -595,6 +597,22 @@ int ff_hevc_cu_chroma_qp_offset_flag(HEVCContext *s);
 int ff_hevc_cu_chroma_qp_offset_idx(HEVCContext *s);
 void ff_hevc_hls_filter(HEVCContext *s, int x, int y, int ctb_size);
 void ff_hevc_hls_filters(HEVCContext *s, int x_ctb, int y_ctb, int ctb_size);
+
+/**
+ * Hand the loop filtering of the current frame to the filter thread if the
+ * filter_pipeline option is set. Must be called once the frame is set up and
+ * before its slices are decoded.
+ */
+int ff_hevc_filter_pipeline_start(HEVCContext *s);
+
+/**
+ * Wait until the filter thread has filtered the current frame. Of a frame
+ * which was not completely decoded, only the CTBs the inline filters would
+ * have filtered are.
+ */
+void ff_hevc_filter_pipeline_finish(HEVCContext *s);
+void ff_hevc_filter_pipeline_free(HEVCContext *s);
+
 void ff_hevc_hls_residual_coding(HEVCContext *s, int x0, int y0,
                                  int log2_trafo_size, enum ScanType scan_idx,
                                  int c_idx);
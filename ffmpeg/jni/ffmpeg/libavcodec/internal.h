@@ -68,6 +68,12 @@
  * Codec initializes slice-based threading with a main function
  */
 #define FF_CODEC_CAP_SLICE_THREAD_HAS_MF    (1 << 5)
+/**
+ * The decoder supports slice threading within the contexts of frame
+ * threading (FF_THREAD_HYBRID). Jobs of its execute() calls may only wait
+ * for other jobs of the same call and for progress of earlier frames.
+ */
+#define FF_CODEC_CAP_HYBRID_THREADS         (1 << 6)
 
 /**
  * AVCodec.codec_tags termination value
@@ -168,6 +174,12 @@ typedef struct AVCodecInternal {
 
     void *thread_ctx;
 
+    /**
+     * Slice threading context of a frame thread with FF_THREAD_HYBRID,
+     * whose thread_ctx is taken by frame threading.
+     */
+    void *slice_thread_ctx;
+
     DecodeSimpleContext ds;
     DecodeFilterContext filter;
 
@@ -232,6 +244,15 @@ typedef struct AVCodecInternal {
     int initial_sample_rate;
     int initial_channels;
     uint64_t initial_channel_layout;
+
+    /* catch-up state, see AVCodecContext.catchup_pts */
+    int catchup_level;
+    int catchup_applied;
+    int catchup_reached;
+    int64_t catchup_reached_pts;
+    enum AVDiscard catchup_user_skip_frame;
+    enum AVDiscard catchup_user_skip_loop_filter;
+    int64_t catchup_start_packets[3];
 } AVCodecInternal;
 
 struct AVCodecDefault {
@@ -37,8 +37,11 @@ typedef struct Libdav1dContext {
     int pool_size;
 
     Dav1dData data;
+    int stride_align;
+    int padding;
     int tile_threads;
     int frame_threads;
+    int max_frame_delay;
     int apply_grain;
     int operating_point;
     int all_layers;
@@ -66,19 +69,29 @@ static int libdav1d_picture_allocator(Dav1dPicture *p, void *cookie)
 {
     Libdav1dContext *dav1d = cookie;
     enum AVPixelFormat format = pix_fmt[p->p.layout][p->seq_hdr->hbd];
+    int align = dav1d->stride_align;
     int ret, linesize[4], h = FFALIGN(p->p.h, 128);
     uint8_t *aligned_ptr, *data[4];
     AVBufferRef *buf;
 
-    ret = av_image_fill_arrays(data, linesize, NULL, format, FFALIGN(p->p.w, 128),
-                               h, DAV1D_PICTURE_ALIGNMENT);
+    ret = av_image_check_size(p->p.w, p->p.h, 0, NULL);
+    if (ret < 0)
+        return ret;
+
+    ret = av_image_fill_linesizes(linesize, format, FFALIGN(p->p.w, 128));
+    if (ret < 0)
+        return ret;
+    for (int i = 0; i < 4; i++)
+        linesize[i] = FFALIGN(linesize[i], align);
+
+    ret = av_image_fill_pointers(data, format, h, NULL, linesize);
     if (ret < 0)
         return ret;
 
     if (ret != dav1d->pool_size) {
         av_buffer_pool_uninit(&dav1d->pool);
         // Use twice the amount of required padding bytes for aligned_ptr below.
-        dav1d->pool = av_buffer_pool_init(ret + DAV1D_PICTURE_ALIGNMENT * 2, NULL);
+        dav1d->pool = av_buffer_pool_init(ret + align * 2 + dav1d->padding, NULL);
         if (!dav1d->pool) {
             dav1d->pool_size = 0;
             return AVERROR(ENOMEM);
@@ -91,9 +104,8 @@ static int libdav1d_picture_allocator(Dav1dPicture *p, void *cookie)
 
     // libdav1d requires DAV1D_PICTURE_ALIGNMENT aligned buffers, which av_malloc()
     // doesn't guarantee for example when AVX is disabled at configure time.
-    // Use the extra DAV1D_PICTURE_ALIGNMENT padding bytes in the buffer to align it
-    // if required.
-    aligned_ptr = (uint8_t *)FFALIGN((uintptr_t)buf->data, DAV1D_PICTURE_ALIGNMENT);
+    // Use the extra padding bytes in the buffer to align it if required.
+    aligned_ptr = (uint8_t *)FFALIGN((uintptr_t)buf->data, align);
     ret = av_image_fill_pointers(data, format, h, aligned_ptr, linesize);
     if (ret < 0) {
         av_buffer_unref(&buf);
@@ -117,15 +129,65 @@ static void libdav1d_picture_release(Dav1dPicture *p, void *cookie)
     av_buffer_unref(&buf);
 }
 
+static av_cold void libdav1d_plan_threads(AVCodecContext *c, Dav1dSettings *s)
+{
+    Libdav1dContext *dav1d = c->priv_data;
+    Dav1dSequenceHeader seq;
+    int threads = (c->thread_count ? c->thread_count : av_cpu_count()) * 3 / 2;
+    int max_delay = c->flags & AV_CODEC_FLAG_LOW_DELAY ? 1 : dav1d->max_frame_delay;
+    int64_t pixels = (int64_t)c->width * c->height;
+    int tiles = 1;
+
+    if (c->extradata_size > 0) {
+        // skip the av1C header in front of the configOBUs
+        int offset = c->extradata[0] & 0x80 ? 4 : 0;
+
+        if (c->extradata_size > offset &&
+            dav1d_parse_sequence_header(&seq, c->extradata + offset,
+                                        c->extradata_size - offset) >= 0)
+            pixels = (int64_t)seq.max_width * seq.max_height;
+    }
+
+    // The tiles are only signalled in the frame headers, so guess their
+    // number from the frame size. Encoders rarely use several tiles up to
+    // 1080p, tile threads beyond the number of tiles stay idle while frame
+    // threads always have work.
+    if (pixels > 2560 * 1440)
+        tiles = 4;
+    else if (pixels > 1920 * 1088)
+        tiles = 2;
+
+    s->n_tile_threads = dav1d->tile_threads
+                      ? dav1d->tile_threads
+                      : FFMIN3(tiles, threads, DAV1D_MAX_TILE_THREADS);
+    s->n_frame_threads = dav1d->frame_threads
+                       ? dav1d->frame_threads
+                       : FFMIN((threads + s->n_tile_threads - 1) / s->n_tile_threads,
+                               DAV1D_MAX_FRAME_THREADS);
+
+    // Each frame thread adds a frame of delay, give the rest of the threads
+    // to the tiles instead.
+    if (max_delay && !dav1d->frame_threads && s->n_frame_threads > max_delay) {
+        s->n_frame_threads = max_delay;
+        if (!dav1d->tile_threads)
+            s->n_tile_threads = FFMIN(FFMAX(s->n_tile_threads, threads / max_delay),
+                                      DAV1D_MAX_TILE_THREADS);
+    }
+}
+
 static av_cold int libdav1d_init(AVCodecContext *c)
 {
     Libdav1dContext *dav1d = c->priv_data;
     Dav1dSettings s;
-    int threads = (c->thread_count ? c->thread_count : av_cpu_count()) * 3 / 2;
     int res;
 
     av_log(c, AV_LOG_INFO, "libdav1d %s\n", dav1d_version());
 
+    if (dav1d->stride_align & (dav1d->stride_align - 1)) {
+        av_log(c, AV_LOG_ERROR, "stride_align must be a power of two\n");
+        return AVERROR(EINVAL);
+    }
+
     dav1d_default_settings(&s);
     s.logger.cookie = c;
     s.logger.callback = libdav1d_log_callback;
@@ -140,12 +202,7 @@ static av_cold int libdav1d_init(AVCodecContext *c)
     if (dav1d->operating_point >= 0)
         s.operating_point = dav1d->operating_point;
 
-    s.n_tile_threads = dav1d->tile_threads
-                     ? dav1d->tile_threads
-                     : FFMIN(floor(sqrt(threads)), DAV1D_MAX_TILE_THREADS);
-    s.n_frame_threads = dav1d->frame_threads
-                      ? dav1d->frame_threads
-                      : FFMIN(ceil(threads / s.n_tile_threads), DAV1D_MAX_FRAME_THREADS);
+    libdav1d_plan_threads(c, &s);
     av_log(c, AV_LOG_DEBUG, "Using %d frame threads, %d tile threads\n",
            s.n_frame_threads, s.n_tile_threads);
 
@@ -185,9 +242,20 @@ static int libdav1d_receive_frame(AVCodecContext *c, AVFrame *frame)
     if (!data->sz) {
         AVPacket pkt = { 0 };
 
-        res = ff_decode_get_packet(c, &pkt);
-        if (res < 0 && res != AVERROR_EOF)
-            return res;
+        /* dav1d cannot skip frames itself, so drop the packets before
+         * parsing; the decoder recovers at the next keyframe. An empty
+         * packet would put dav1d into draining, so get the next one. */
+        for (;;) {
+            res = ff_decode_get_packet(c, &pkt);
+            if (res < 0 && res != AVERROR_EOF)
+                return res;
+
+            if (!pkt.size || !(c->skip_frame >= AVDISCARD_ALL ||
+                               (c->skip_frame >= AVDISCARD_NONKEY && !(pkt.flags & AV_PKT_FLAG_KEY)) ||
+                               (c->skip_frame >= AVDISCARD_NONREF && pkt.flags & AV_PKT_FLAG_DISPOSABLE)))
+                break;
+            av_packet_unref(&pkt);
+        }
 
         if (pkt.size) {
             res = dav1d_data_wrap(data, pkt.data, pkt.size, libdav1d_data_free, pkt.buf);
@@ -383,9 +451,12 @@ static av_cold int libdav1d_close(AVCodecContext *c)
 static const AVOption libdav1d_options[] = {
     { "tilethreads", "Tile threads", OFFSET(tile_threads), AV_OPT_TYPE_INT, { .i64 = 0 }, 0, DAV1D_MAX_TILE_THREADS, VD },
     { "framethreads", "Frame threads", OFFSET(frame_threads), AV_OPT_TYPE_INT, { .i64 = 0 }, 0, DAV1D_MAX_FRAME_THREADS, VD },
+    { "max_frame_delay", "Max frame delay, limits the automatic frame threads", OFFSET(max_frame_delay), AV_OPT_TYPE_INT, { .i64 = 0 }, 0, DAV1D_MAX_FRAME_THREADS, VD },
     { "filmgrain", "Apply Film Grain", OFFSET(apply_grain), AV_OPT_TYPE_BOOL, { .i64 = -1 }, -1, 1, VD },
     { "oppoint",  "Select an operating point of the scalable bitstream", OFFSET(operating_point), AV_OPT_TYPE_INT, { .i64 = -1 }, -1, 31, VD },
     { "alllayers", "Output all spatial layers", OFFSET(all_layers), AV_OPT_TYPE_BOOL, { .i64 = 0 }, 0, 1, VD },
+    { "stride_align", "Alignment of the picture lines and planes in bytes", OFFSET(stride_align), AV_OPT_TYPE_INT, { .i64 = DAV1D_PICTURE_ALIGNMENT }, DAV1D_PICTURE_ALIGNMENT, 4096, VD },
+    { "padding", "Extra bytes allocated after each picture", OFFSET(padding), AV_OPT_TYPE_INT, { .i64 = 0 }, 0, 1 << 20, VD },
     { NULL }
 };
 
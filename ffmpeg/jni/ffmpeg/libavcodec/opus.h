@@ -129,6 +129,9 @@ typedef struct OpusStreamContext {
     int delayed_samples;
 
     OpusPacket packet;
+    /* start of this stream's sub-packet in the current packet, NULL when
+     * flushing */
+    const uint8_t *packet_data;
 
     int redundancy_idx;
 } OpusStreamContext;
@@ -331,8 +331,7 @@ static int opus_decode_frame(OpusStreamContext *s, const uint8_t *data, int size
 
 static int opus_decode_subpacket(OpusStreamContext *s,
                                  const uint8_t *buf, int buf_size,
-                                 float **out, int out_size,
-                                 int nb_samples)
+                                 float **out, int out_size)
 {
     int output_samples = 0;
     int flush_needed   = 0;
@@ -411,6 +410,16 @@ finish:
     return output_samples;
 }
 
+static int opus_decode_stream(AVCodecContext *avctx, void *arg,
+                              int jobnr, int threadnr)
+{
+    OpusContext        *c = avctx->priv_data;
+    OpusStreamContext  *s = &c->streams[jobnr];
+
+    return opus_decode_subpacket(s, s->packet_data, s->packet.data_size,
+                                 c->out + 2 * jobnr, c->out_size[jobnr]);
+}
+
 static int opus_decode_packet(AVCodecContext *avctx, void *data,
                               int *got_frame_ptr, AVPacket *avpkt)
 {
@@ -432,16 +441,31 @@ static int opus_decode_packet(AVCodecContext *avctx, void *data,
                                 s->delayed_samples + av_audio_fifo_size(c->sync_buffers[i]));
     }
 
-    /* decode the header of the first sub-packet to find out the sample count */
-    if (buf) {
-        OpusPacket *pkt = &c->streams[0].packet;
-        ret = ff_opus_parse_packet(pkt, buf, buf_size, c->nb_streams > 1);
+    /* decode the headers of all the sub-packets, so that the streams can be
+     * decoded independently of each other */
+    for (i = 0; i < c->nb_streams; i++) {
+        OpusStreamContext *s = &c->streams[i];
+
+        s->packet_data = buf;
+        if (!buf)
+            continue;
+
+        ret = ff_opus_parse_packet(&s->packet, buf, buf_size, i != c->nb_streams - 1);
         if (ret < 0) {
             av_log(avctx, AV_LOG_ERROR, "Error parsing the packet header.\n");
             return ret;
         }
-        coded_samples += pkt->frame_count * pkt->frame_duration;
-        c->streams[0].silk_samplerate = get_silk_samplerate(pkt->config);
+        if (!i) {
+            coded_samples = s->packet.frame_count * s->packet.frame_duration;
+        } else if (coded_samples != s->packet.frame_count * s->packet.frame_duration) {
+            av_log(avctx, AV_LOG_ERROR,
+                   "Mismatching coded sample count in substream %d.\n", i);
+            return AVERROR_INVALIDDATA;
+        }
+        s->silk_samplerate = get_silk_samplerate(s->packet.config);
+
+        buf      += s->packet.packet_size;
+        buf_size -= s->packet.packet_size;
     }
 
     frame->nb_samples = coded_samples + delayed_samples;
@@ -458,6 +482,7 @@ static int opus_decode_packet(AVCodecContext *avctx, void *data,
         return ret;
     frame->nb_samples = 0;
 
+    /* the streams decode straight into the planes of the frame */
     memset(c->out, 0, c->nb_streams * 2 * sizeof(*c->out));
     for (i = 0; i < avctx->channels; i++) {
         ChannelMap *map = &c->channel_maps[i];
@@ -465,7 +490,8 @@ static int opus_decode_packet(AVCodecContext *avctx, void *data,
             c->out[2 * map->stream_idx + map->channel_idx] = (float*)frame->extended_data[i];
     }
 
-    /* read the data from the sync buffers */
+    /* read the data from the sync buffers, they are only used when the
+     * resampler delays of the streams differ */
     for (i = 0; i < c->nb_streams; i++) {
         float          **out = c->out + 2 * i;
         int sync_size = av_audio_fifo_size(c->sync_buffers[i]);
@@ -473,6 +499,10 @@ static int opus_decode_packet(AVCodecContext *avctx, void *data,
         float sync_dummy[32];
         int out_dummy = (!out[0]) | ((!out[1]) << 1);
 
+        c->out_size[i] = frame->linesize[0];
+        if (!sync_size)
+            continue;
+
         if (!out[0])
             out[0] = sync_dummy;
         if (!out[1])
@@ -493,37 +523,21 @@ static int opus_decode_packet(AVCodecContext *avctx, void *data,
         else
             out[1] += ret;
 
-        c->out_size[i] = frame->linesize[0] - ret * sizeof(float);
+        c->out_size[i] -= ret * sizeof(float);
     }
 
-    /* decode each sub-packet */
-    for (i = 0; i < c->nb_streams; i++) {
-        OpusStreamContext *s = &c->streams[i];
-
-        if (i && buf) {
-            ret = ff_opus_parse_packet(&s->packet, buf, buf_size, i != c->nb_streams - 1);
-            if (ret < 0) {
-                av_log(avctx, AV_LOG_ERROR, "Error parsing the packet header.\n");
-                return ret;
-            }
-            if (coded_samples != s->packet.frame_count * s->packet.frame_duration) {
-                av_log(avctx, AV_LOG_ERROR,
-                       "Mismatching coded sample count in substream %d.\n", i);
-                return AVERROR_INVALIDDATA;
-            }
-
-            s->silk_samplerate = get_silk_samplerate(s->packet.config);
-        }
-
-        ret = opus_decode_subpacket(&c->streams[i], buf, s->packet.data_size,
-                                    c->out + 2 * i, c->out_size[i], coded_samples);
-        if (ret < 0)
-            return ret;
-        c->decoded_samples[i] = ret;
-        decoded_samples       = FFMIN(decoded_samples, ret);
+    /* decode each sub-packet, the streams are independent so they can run
+     * on the slice threads */
+    if (c->nb_streams > 1)
+        avctx->execute2(avctx, opus_decode_stream, NULL, c->decoded_samples,
+                        c->nb_streams);
+    else
+        c->decoded_samples[0] = opus_decode_stream(avctx, NULL, 0, 0);
 
-        buf      += s->packet.packet_size;
-        buf_size -= s->packet.packet_size;
+    for (i = 0; i < c->nb_streams; i++) {
+        if (c->decoded_samples[i] < 0)
+            return c->decoded_samples[i];
+        decoded_samples = FFMIN(decoded_samples, c->decoded_samples[i]);
     }
 
     /* buffer the extra samples */
@@ -547,9 +561,9 @@ static int opus_decode_packet(AVCodecContext *avctx, void *data,
         if (map->copy) {
             memcpy(frame->extended_data[i],
                    frame->extended_data[map->copy_idx],
-                   frame->linesize[0]);
+                   FFALIGN(decoded_samples, 8) * sizeof(float));
         } else if (map->silence) {
-            memset(frame->extended_data[i], 0, frame->linesize[0]);
+            memset(frame->extended_data[i], 0, FFALIGN(decoded_samples, 8) * sizeof(float));
         }
 
         if (c->gain_i && decoded_samples > 0) {
@@ -737,5 +751,6 @@ AVCodec ff_opus_decoder = {
     .close           = opus_decode_close,
     .decode          = opus_decode_packet,
     .flush           = opus_decode_flush,
-    .capabilities    = AV_CODEC_CAP_DR1 | AV_CODEC_CAP_DELAY,
+    .capabilities    = AV_CODEC_CAP_DR1 | AV_CODEC_CAP_DELAY |
+                       AV_CODEC_CAP_SLICE_THREADS,
 };
@@ -73,6 +73,9 @@ typedef struct PGSSubObject {
     uint8_t      *rle;
     unsigned int rle_buffer_size, rle_data_len;
     unsigned int rle_remaining_len;
+    uint8_t      *bitmap;       ///< decoded rle, NULL until the object is displayed
+    unsigned int bitmap_size;
+    int          bitmap_valid;  ///< bitmap matches the current rle data
 } PGSSubObject;
 
 typedef struct PGSSubObjects {
@@ -107,6 +110,9 @@ static void flush_cache(AVCodecContext *avctx)
         av_freep(&ctx->objects.object[i].rle);
         ctx->objects.object[i].rle_buffer_size  = 0;
         ctx->objects.object[i].rle_remaining_len  = 0;
+        av_freep(&ctx->objects.object[i].bitmap);
+        ctx->objects.object[i].bitmap_size  = 0;
+        ctx->objects.object[i].bitmap_valid = 0;
     }
     ctx->objects.count = 0;
     ctx->palettes.count = 0;
@@ -154,11 +160,13 @@ static av_cold int close_decoder(AVCodecContext *avctx)
  * The subtitle is stored as a Run Length Encoded image.
  *
  * @param avctx contains the current codec context
- * @param sub pointer to the processed subtitle data
+ * @param bitmap destination of the w * h pixels
+ * @param w width of the bitmap
+ * @param h height of the bitmap
  * @param buf pointer to the RLE data to process
  * @param buf_size size of the RLE data to process
  */
-static int decode_rle(AVCodecContext *avctx, AVSubtitleRect *rect,
+static int decode_rle(AVCodecContext *avctx, uint8_t *bitmap, int w, int h,
                       const uint8_t *buf, unsigned int buf_size)
 {
     const uint8_t *rle_bitmap_end;
@@ -166,40 +174,46 @@ static int decode_rle(AVCodecContext *avctx, AVSubtitleRect *rect,
 
     rle_bitmap_end = buf + buf_size;
 
-    rect->data[0] = av_malloc_array(rect->w, rect->h);
-
-    if (!rect->data[0])
-        return AVERROR(ENOMEM);
-
     pixel_count = 0;
     line_count  = 0;
 
-    while (buf < rle_bitmap_end && line_count < rect->h) {
+    while (buf < rle_bitmap_end && line_count < h) {
         uint8_t flags, color;
         int run;
 
         color = bytestream_get_byte(&buf);
         run   = 1;
 
-        if (color == 0x00) {
-            flags = bytestream_get_byte(&buf);
-            run   = flags & 0x3f;
-            if (flags & 0x40)
-                run = (run << 8) + bytestream_get_byte(&buf);
-            color = flags & 0x80 ? bytestream_get_byte(&buf) : 0;
+        if (color) {
+            /* Most of the data of text subtitles are single pixels,
+             * copy them up to the next escape code at once. */
+            const uint8_t *lit_end = memchr(buf, 0x00, rle_bitmap_end - buf);
+            int len = (lit_end ? lit_end : rle_bitmap_end) - buf + 1;
+
+            run = FFMIN(len, w * h - pixel_count);
+            memcpy(bitmap + pixel_count, buf - 1, run);
+            pixel_count += run;
+            buf         += len - 1;
+            continue;
         }
 
-        if (run > 0 && pixel_count + run <= rect->w * rect->h) {
-            memset(rect->data[0] + pixel_count, color, run);
+        flags = bytestream_get_byte(&buf);
+        run   = flags & 0x3f;
+        if (flags & 0x40)
+            run = (run << 8) + bytestream_get_byte(&buf);
+        color = flags & 0x80 ? bytestream_get_byte(&buf) : 0;
+
+        if (run > 0 && pixel_count + run <= w * h) {
+            memset(bitmap + pixel_count, color, run);
             pixel_count += run;
         } else if (!run) {
             /*
              * New Line. Check if correct pixels decoded, if not display warning
              * and adjust bitmap pointer to correct new line position.
              */
-            if (pixel_count % rect->w > 0) {
+            if (pixel_count % w > 0) {
                 av_log(avctx, AV_LOG_ERROR, "Decoded %d pixels, when line should be %d pixels\n",
-                       pixel_count % rect->w, rect->w);
+                       pixel_count % w, w);
                 if (avctx->err_recognition & AV_EF_EXPLODE) {
                     return AVERROR_INVALIDDATA;
                 }
@@ -208,13 +222,42 @@ static int decode_rle(AVCodecContext *avctx, AVSubtitleRect *rect,
         }
     }
 
-    if (pixel_count < rect->w * rect->h) {
+    if (pixel_count < w * h) {
         av_log(avctx, AV_LOG_ERROR, "Insufficient RLE data for subtitle\n");
         return AVERROR_INVALIDDATA;
     }
 
-    ff_dlog(avctx, "Pixel Count = %d, Area = %d\n", pixel_count, rect->w * rect->h);
+    ff_dlog(avctx, "Pixel Count = %d, Area = %d\n", pixel_count, w * h);
+
+    return 0;
+}
+
+/**
+ * Return the decoded bitmap of an object.
+ *
+ * Objects are often displayed by several presentations (e.g. when a
+ * subtitle is cropped, moved or faded by palette updates), the bitmap is
+ * only decoded the first time and kept until new object data arrives.
+ */
+static int get_object_bitmap(AVCodecContext *avctx, PGSSubObject *object,
+                             const uint8_t **bitmap)
+{
+    int ret;
 
+    if (!object->bitmap_valid) {
+        av_fast_malloc(&object->bitmap, &object->bitmap_size,
+                       (size_t)object->w * object->h);
+        if (!object->bitmap) {
+            object->bitmap_size = 0;
+            return AVERROR(ENOMEM);
+        }
+        ret = decode_rle(avctx, object->bitmap, object->w, object->h,
+                         object->rle, object->rle_data_len);
+        if (ret < 0)
+            return ret;
+        object->bitmap_valid = 1;
+    }
+    *bitmap = object->bitmap;
     return 0;
 }
 
@@ -252,6 +295,7 @@ static int parse_object_segment(AVCodecContext *avctx,
         object = &ctx->objects.object[ctx->objects.count++];
         object->id = id;
     }
+    object->bitmap_valid = 0;
 
     /* skip object version number */
     buf += 1;
@@ -532,6 +576,7 @@ static int display_end_segment(AVCodecContext *avctx, void *data,
     }
     for (i = 0; i < ctx->presentation.object_count; i++) {
         PGSSubObject *object;
+        const uint8_t *bitmap;
 
         sub->rects[i]  = av_mallocz(sizeof(*sub->rects[0]));
         if (!sub->rects[i]) {
@@ -574,7 +619,12 @@ static int display_end_segment(AVCodecContext *avctx, void *data,
                     return AVERROR_INVALIDDATA;
                 }
             }
-            ret = decode_rle(avctx, sub->rects[i], object->rle, object->rle_data_len);
+            ret = get_object_bitmap(avctx, object, &bitmap);
+            if (ret >= 0) {
+                sub->rects[i]->data[0] = av_memdup(bitmap, object->w * object->h);
+                if (!sub->rects[i]->data[0])
+                    ret = AVERROR(ENOMEM);
+            }
             if (ret < 0) {
                 if ((avctx->err_recognition & AV_EF_EXPLODE) ||
                     ret == AVERROR(ENOMEM)) {
@@ -128,13 +128,39 @@ typedef struct FrameThreadContext {
     pthread_cond_t async_cond;
     int async_lock;
 
-    int next_decoding;             ///< The next context to submit a packet to.
-    int next_finished;             ///< The next context to return output from.
+    int next_decoding;             ///< The next position in ring to submit a packet to.
+    int next_finished;             ///< The next position in ring to return output from.
 
     int delaying;                  /**<
                                     * Set for the first N packets, where N is the number of threads.
                                     * While it is set, ff_thread_en/decode_frame won't return any results.
                                     */
+
+    /**
+     * Order in which the contexts are used, and the number of them in use.
+     * Without FF_THREAD_ADAPTIVE, this is all threads in index order.
+     */
+    int *ring;
+    int nb_active;
+
+    /**
+     * With FF_THREAD_ADAPTIVE, the pipeline starts empty after init and
+     * flush, and every other packet is let in without returning a frame
+     * until max_depth frames are in flight. Thread contexts are created
+     * from the stashed state of the first one when the ring has to grow.
+     */
+    int adaptive;
+    int max_depth;
+    AVCodecContext *stash_avctx;
+    AVCodecInternal *stash_internal;
+    void *stash_priv;
+
+    /**
+     * Set with FF_THREAD_HYBRID for codecs supporting it: every thread
+     * context gets its own slice threading context, so the frame threads
+     * can split their frames further.
+     */
+    int hybrid;
 } FrameThreadContext;
 
 #define THREAD_SAFE_CALLBACKS(avctx) \
@@ -402,7 +428,8 @@ static int submit_packet(PerThreadContext *p, AVCodecContext *user_avctx,
 
     release_delayed_buffers(p);
 
-    if (prev_thread) {
+    /* with FF_THREAD_ADAPTIVE, a single context may follow itself */
+    if (prev_thread && prev_thread != p) {
         int err;
         if (atomic_load(&prev_thread->state) == STATE_SETTING_UP) {
             pthread_mutex_lock(&prev_thread->progress_mutex);
@@ -470,12 +497,109 @@ static int submit_packet(PerThreadContext *p, AVCodecContext *user_avctx,
     return 0;
 }
 
+/**
+ * Set up the context and worker of thread i. The first one is initialized
+ * by the codec, the others start as copies of the first one right after
+ * its initialization.
+ */
+static int init_thread(AVCodecContext *avctx, FrameThreadContext *fctx, int i)
+{
+    const AVCodec *codec = avctx->codec;
+    PerThreadContext *p  = &fctx->threads[i];
+    AVCodecContext *copy = av_malloc(sizeof(AVCodecContext));
+    int err = 0;
+
+    p->frame = av_frame_alloc();
+    if (!p->frame) {
+        av_freep(&copy);
+        return AVERROR(ENOMEM);
+    }
+
+    p->parent = fctx;
+    p->avctx  = copy;
+
+    if (!copy)
+        return AVERROR(ENOMEM);
+
+    *copy = i ? *fctx->stash_avctx : *avctx;
+
+    copy->internal = av_malloc(sizeof(AVCodecInternal));
+    if (!copy->internal) {
+        copy->priv_data = NULL;
+        return AVERROR(ENOMEM);
+    }
+    *copy->internal = i ? *fctx->stash_internal : *avctx->internal;
+    copy->internal->thread_ctx = p;
+    copy->internal->last_pkt_props = &p->avpkt;
+
+    if (i) {
+        copy->priv_data = av_malloc(codec->priv_data_size);
+        if (!copy->priv_data)
+            return AVERROR(ENOMEM);
+        memcpy(copy->priv_data, fctx->stash_priv, codec->priv_data_size);
+        copy->internal->is_copy = 1;
+
+        /* the stashed state refers to the slice threads of the first context */
+        copy->internal->slice_thread_ctx = NULL;
+        copy->active_thread_type         = avctx->active_thread_type;
+    }
+
+    if (fctx->hybrid && (err = ff_slice_thread_init(copy)) < 0)
+        return err;
+
+    if (!i) {
+        if (codec->init)
+            err = codec->init(copy);
+
+        update_context_from_thread(avctx, copy, 1);
+    } else if (codec->init_thread_copy) {
+        err = codec->init_thread_copy(copy);
+    }
+
+    if (err)
+        return err;
+
+    atomic_init(&p->debug_threads, (copy->debug & FF_DEBUG_THREADS) != 0);
+
+    err = AVERROR(pthread_create(&p->thread, NULL, frame_worker_thread, p));
+    p->thread_init= !err;
+    return err;
+}
+
+/**
+ * Add a new context to the ring, right after the one the last packet was
+ * submitted to.
+ */
+static int grow_ring(AVCodecContext *avctx, FrameThreadContext *fctx)
+{
+    int pos = fctx->next_decoding;
+    int err;
+
+    if (fctx->nb_active >= avctx->thread_count)
+        return AVERROR(EINVAL);
+
+    if ((err = init_thread(avctx, fctx, fctx->nb_active)) < 0) {
+        av_log(avctx, AV_LOG_WARNING, "Could not start decoding thread %d\n",
+               fctx->nb_active);
+        return err;
+    }
+
+    memmove(&fctx->ring[pos + 1], &fctx->ring[pos],
+            (fctx->nb_active - pos) * sizeof(*fctx->ring));
+    fctx->ring[pos] = fctx->nb_active++;
+    if (fctx->next_finished >= pos)
+        fctx->next_finished++;
+
+    return 0;
+}
+
 int ff_thread_decode_frame(AVCodecContext *avctx,
                            AVFrame *picture, int *got_picture_ptr,
                            AVPacket *avpkt)
 {
     FrameThreadContext *fctx = avctx->internal->thread_ctx;
     int finished = fctx->next_finished;
+    int in_flight = (fctx->next_decoding - finished + fctx->nb_active) % fctx->nb_active;
     PerThreadContext *p;
     int err;
 
@@ -487,7 +611,7 @@ int ff_thread_decode_frame(AVCodecContext *avctx,
      * Submit a packet to the next decoding thread.
      */
 
-    p = &fctx->threads[fctx->next_decoding];
+    p = &fctx->threads[fctx->ring[fctx->next_decoding]];
     err = submit_packet(p, avctx, avpkt);
     if (err)
         goto finish;
@@ -496,7 +620,17 @@ int ff_thread_decode_frame(AVCodecContext *avctx,
      * If we're still receiving the initial packets, don't return a frame.
      */
 
-    if (fctx->next_decoding > (avctx->thread_count-1-(avctx->codec_id == AV_CODEC_ID_FFV1)))
+    if (fctx->adaptive) {
+        fctx->delaying = avpkt->size && !fctx->delaying && in_flight < fctx->max_depth;
+        /* holding this frame back needs a free context for the next packet */
+        if (fctx->delaying && in_flight + 1 == fctx->nb_active &&
+            grow_ring(avctx, fctx) < 0) {
+            fctx->max_depth = in_flight;
+            fctx->delaying  = 0;
+        }
+        if (fctx->next_decoding >= fctx->nb_active)
+            fctx->next_decoding = 0;
+    } else if (fctx->next_decoding > (avctx->thread_count-1-(avctx->codec_id == AV_CODEC_ID_FFV1)))
         fctx->delaying = 0;
 
     if (fctx->delaying) {
@@ -515,7 +649,7 @@ int ff_thread_decode_frame(AVCodecContext *avctx,
      */
 
     do {
-        p = &fctx->threads[finished++];
+        p = &fctx->threads[fctx->ring[finished++]];
 
         if (atomic_load(&p->state) != STATE_INPUT_READY) {
             pthread_mutex_lock(&p->progress_mutex);
@@ -538,12 +672,12 @@ int ff_thread_decode_frame(AVCodecContext *avctx,
         p->got_frame = 0;
         p->result = 0;
 
-        if (finished >= avctx->thread_count) finished = 0;
+        if (finished >= fctx->nb_active) finished = 0;
     } while (!avpkt->size && !*got_picture_ptr && err >= 0 && finished != fctx->next_finished);
 
     update_context_from_thread(avctx, p->avctx, 1);
 
-    if (fctx->next_decoding >= avctx->thread_count) fctx->next_decoding = 0;
+    if (fctx->next_decoding >= fctx->nb_active) fctx->next_decoding = 0;
 
     fctx->next_finished = finished;
 
@@ -680,6 +814,9 @@ void ff_frame_thread_free(AVCodecContext *avctx, int thread_count)
         if (codec->close && p->avctx)
             codec->close(p->avctx);
 
+        if (p->avctx && p->avctx->internal && p->avctx->internal->slice_thread_ctx)
+            ff_slice_thread_free(p->avctx);
+
         release_delayed_buffers(p);
         av_frame_free(&p->frame);
     }
@@ -709,6 +846,10 @@ void ff_frame_thread_free(AVCodecContext *avctx, int thread_count)
     }
 
     av_freep(&fctx->threads);
+    av_freep(&fctx->ring);
+    av_freep(&fctx->stash_avctx);
+    av_freep(&fctx->stash_internal);
+    av_freep(&fctx->stash_priv);
     pthread_mutex_destroy(&fctx->buffer_mutex);
     pthread_mutex_destroy(&fctx->hwaccel_mutex);
     pthread_mutex_destroy(&fctx->async_mutex);
@@ -725,7 +866,6 @@ int ff_frame_thread_init(AVCodecContext *avctx)
 {
     int thread_count = avctx->thread_count;
     const AVCodec *codec = avctx->codec;
-    AVCodecContext *src = avctx;
     FrameThreadContext *fctx;
     int i, err = 0;
 
@@ -752,7 +892,10 @@ int ff_frame_thread_init(AVCodecContext *avctx)
         return AVERROR(ENOMEM);
 
     fctx->threads = av_mallocz_array(thread_count, sizeof(PerThreadContext));
-    if (!fctx->threads) {
+    fctx->ring    = av_malloc_array(thread_count, sizeof(*fctx->ring));
+    if (!fctx->threads || !fctx->ring) {
+        av_freep(&fctx->threads);
+        av_freep(&fctx->ring);
         av_freep(&avctx->internal->thread_ctx);
         return AVERROR(ENOMEM);
     }
@@ -764,78 +907,45 @@ int ff_frame_thread_init(AVCodecContext *avctx)
 
     fctx->async_lock = 1;
     fctx->delaying = 1;
+    fctx->adaptive = !!(avctx->thread_type & FF_THREAD_ADAPTIVE);
+    fctx->max_depth = thread_count - 1 - (avctx->codec_id == AV_CODEC_ID_FFV1);
+    fctx->hybrid    = (avctx->thread_type & FF_THREAD_HYBRID) &&
+                      (codec->caps_internal & FF_CODEC_CAP_HYBRID_THREADS);
 
     for (i = 0; i < thread_count; i++) {
-        AVCodecContext *copy = av_malloc(sizeof(AVCodecContext));
-        PerThreadContext *p  = &fctx->threads[i];
+        PerThreadContext *p = &fctx->threads[i];
 
         pthread_mutex_init(&p->mutex, NULL);
         pthread_mutex_init(&p->progress_mutex, NULL);
         pthread_cond_init(&p->input_cond, NULL);
         pthread_cond_init(&p->progress_cond, NULL);
         pthread_cond_init(&p->output_cond, NULL);
+        fctx->ring[i] = i;
+    }
 
-        p->frame = av_frame_alloc();
-        if (!p->frame) {
-            av_freep(&copy);
-            err = AVERROR(ENOMEM);
-            goto error;
-        }
-
-        p->parent = fctx;
-        p->avctx  = copy;
-
-        if (!copy) {
-            err = AVERROR(ENOMEM);
-            goto error;
-        }
-
-        *copy = *src;
-
-        copy->internal = av_malloc(sizeof(AVCodecInternal));
-        if (!copy->internal) {
-            copy->priv_data = NULL;
-            err = AVERROR(ENOMEM);
+    fctx->nb_active = fctx->adaptive ? 1 : thread_count;
+    for (i = 0; i < fctx->nb_active; i++) {
+        if ((err = init_thread(avctx, fctx, i)) < 0)
             goto error;
-        }
-        *copy->internal = *src->internal;
-        copy->internal->thread_ctx = p;
-        copy->internal->last_pkt_props = &p->avpkt;
 
         if (!i) {
-            src = copy;
+            AVCodecContext *first = fctx->threads[0].avctx;
 
-            if (codec->init)
-                err = codec->init(copy);
-
-            update_context_from_thread(avctx, copy, 1);
-        } else {
-            copy->priv_data = av_malloc(codec->priv_data_size);
-            if (!copy->priv_data) {
+            fctx->stash_avctx    = av_memdup(first, sizeof(*first));
+            fctx->stash_internal = av_memdup(first->internal, sizeof(*first->internal));
+            fctx->stash_priv     = av_memdup(first->priv_data, codec->priv_data_size);
+            if (!fctx->stash_avctx || !fctx->stash_internal ||
+                (codec->priv_data_size && !fctx->stash_priv)) {
                 err = AVERROR(ENOMEM);
                 goto error;
             }
-            memcpy(copy->priv_data, src->priv_data, codec->priv_data_size);
-            copy->internal->is_copy = 1;
-
-            if (codec->init_thread_copy)
-                err = codec->init_thread_copy(copy);
         }
-
-        if (err) goto error;
-
-        atomic_init(&p->debug_threads, (copy->debug & FF_DEBUG_THREADS) != 0);
-
-        err = AVERROR(pthread_create(&p->thread, NULL, frame_worker_thread, p));
-        p->thread_init= !err;
-        if(!p->thread_init)
-            goto error;
     }
 
     return 0;
 
 error:
-    ff_frame_thread_free(avctx, i+1);
+    ff_frame_thread_free(avctx, thread_count);
 
     return err;
 }
@@ -856,7 +966,7 @@ void ff_thread_flush(AVCodecContext *avctx)
     fctx->next_decoding = fctx->next_finished = 0;
     fctx->delaying = 1;
     fctx->prev_thread = NULL;
-    for (i = 0; i < avctx->thread_count; i++) {
+    for (i = 0; i < fctx->nb_active; i++) {
         PerThreadContext *p = &fctx->threads[i];
         // Make sure decode flush calls with size=0 won't return old frames
         p->got_frame = 0;
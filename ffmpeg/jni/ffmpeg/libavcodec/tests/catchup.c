@@ -0,0 +1,127 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "libavutil/log.h"
+
+#include "libavcodec/avcodec.h"
+
+/* discard options seen by the decoder for the last packet */
+static enum AVDiscard seen_skip_frame, seen_skip_loop_filter;
+
+static int dummy_decode(AVCodecContext *avctx, void *data, int *got_frame,
+                        AVPacket *avpkt)
+{
+    seen_skip_frame       = avctx->skip_frame;
+    seen_skip_loop_filter = avctx->skip_loop_filter;
+    *got_frame = 0;
+    return avpkt->size;
+}
+
+static AVCodec dummy_decoder = {
+    .name   = "dummy_catchup_decoder",
+    .type   = AVMEDIA_TYPE_VIDEO,
+    .id     = AV_CODEC_ID_RAWVIDEO,
+    .decode = dummy_decode,
+};
+
+typedef struct TestPacket {
+    int64_t pts;            ///< in ms
+    int key;
+    enum AVDiscard skip_frame, skip_loop_filter;
+} TestPacket;
+
+/* catching up to 5 s with the user's skip_loop_filter at nonref */
+static const TestPacket packets[] = {
+    /* 3 s behind: keyframes only */
+    { 2000, 1, AVDISCARD_NONKEY, AVDISCARD_ALL    },
+    /* still up to the next keyframe, whatever the lag */
+    { 4800, 0, AVDISCARD_NONKEY, AVDISCARD_ALL    },
+    /* 1 s behind: no loop filter and no non-reference frames */
+    { 4000, 1, AVDISCARD_NONREF, AVDISCARD_ALL    },
+    { 4400, 0, AVDISCARD_NONREF, AVDISCARD_ALL    },
+    /* 0.4 s behind: no non-reference frames */
+    { 4600, 0, AVDISCARD_NONREF, AVDISCARD_NONREF },
+    /* target reached, later reordered frames are decoded normally */
+    { 5000, 0, AVDISCARD_DEFAULT, AVDISCARD_NONREF },
+    { 4900, 0, AVDISCARD_DEFAULT, AVDISCARD_NONREF },
+};
+
+static const int64_t expected_packets[3] = { 1, 2, 2 };
+
+int main(void)
+{
+    AVCodecContext *avctx = avcodec_alloc_context3(&dummy_decoder);
+    AVPacket pkt;
+    uint8_t data[16] = { 0 };
+    int i, ret = 0;
+
+    if (!avctx)
+        return 1;
+    avctx->pkt_timebase     = (AVRational){ 1, 1000 };
+    avctx->skip_loop_filter = AVDISCARD_NONREF;
+    if (avcodec_open2(avctx, &dummy_decoder, NULL) < 0) {
+        avcodec_free_context(&avctx);
+        return 1;
+    }
+    avctx->catchup_pts = 5000;
+
+    for (i = 0; i < FF_ARRAY_ELEMS(packets); i++) {
+        const TestPacket *t = &packets[i];
+        AVFrame *frame = av_frame_alloc();
+
+        av_init_packet(&pkt);
+        pkt.data  = data;
+        pkt.size  = sizeof(data);
+        pkt.pts   = t->pts;
+        pkt.flags = t->key ? AV_PKT_FLAG_KEY : 0;
+
+        if (!frame || avcodec_send_packet(avctx, &pkt) < 0 ||
+            avcodec_receive_frame(avctx, frame) != AVERROR(EAGAIN)) {
+            av_frame_free(&frame);
+            ret = 1;
+            break;
+        }
+        av_frame_free(&frame);
+
+        if (seen_skip_frame != t->skip_frame ||
+            seen_skip_loop_filter != t->skip_loop_filter) {
+            av_log(NULL, AV_LOG_ERROR, "packet %d: skip_frame %d skip_loop_filter %d, "
+                   "expected %d %d\n", i, seen_skip_frame, seen_skip_loop_filter,
+                   t->skip_frame, t->skip_loop_filter);
+            ret = 1;
+        }
+        if (avctx->skip_frame != AVDISCARD_DEFAULT ||
+            avctx->skip_loop_filter != AVDISCARD_NONREF) {
+            av_log(NULL, AV_LOG_ERROR, "packet %d: options not restored: "
+                   "skip_frame %d skip_loop_filter %d\n",
+                   i, avctx->skip_frame, avctx->skip_loop_filter);
+            ret = 1;
+        }
+    }
+
+    for (i = 0; i < 3; i++) {
+        if (avctx->catchup_packets[i] != expected_packets[i]) {
+            av_log(NULL, AV_LOG_ERROR, "catchup_packets[%d] = %"PRId64", expected %"PRId64"\n",
+                   i, avctx->catchup_packets[i], expected_packets[i]);
+            ret = 1;
+        }
+    }
+
+    avcodec_free_context(&avctx);
+    return ret;
+}
@@ -0,0 +1,35 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "libavutil/aarch64/cpu.h"
+#include "libavfilter/af_atempodsp.h"
+
+void ff_atempo_xcorr_neon(float *dst, const float *a, const float *b,
+                          int len, int nb_lags);
+void ff_atempo_blend_float_neon(float *dst, const float *a, const float *b,
+                                const float *wa, const float *wb, int len);
+
+av_cold void ff_atempo_dsp_init_aarch64(ATempoDSPContext *dsp)
+{
+    int cpu_flags = av_get_cpu_flags();
+
+    if (have_neon(cpu_flags)) {
+        dsp->xcorr       = ff_atempo_xcorr_neon;
+        dsp->blend_float = ff_atempo_blend_float_neon;
+    }
+}
@@ -36,10 +36,13 @@
  * The advantage of WSOLA algorithm is that the overlap region size is
  * always the same, therefore the blending function is constant and
  * can be precomputed.
+ *
+ * Fragments are aligned by cross-correlation in time domain, first over
+ * the whole search window on a decimated down-mix of the fragments, then
+ * at full resolution around the best decimated match.
  */
 
 #include <float.h>
-#include "libavcodec/avfft.h"
 #include "libavutil/avassert.h"
 #include "libavutil/avstring.h"
 #include "libavutil/channel_layout.h"
@@ -50,6 +53,8 @@
 #include "audio.h"
 #include "internal.h"
 
+#include "af_atempodsp.h"
+
 /**
  * A fragment of audio waveform
  */
@@ -59,15 +64,23 @@ typedef struct AudioFragment {
     // 1: output sample position
     int64_t position[2];
 
-    // original packed multi-channel samples:
+    // original multi-channel samples, packed or one plane per channel:
     uint8_t *data;
 
     // number of samples in this fragment:
     int nsamples;
 
-    // rDFT transform of the down-mixed mono fragment, used for
-    // fast waveform alignment via correlation in frequency domain:
-    FFTSample *xdat;
+    // down-mixed mono fragment followed by as many zeros,
+    // used for waveform alignment via cross-correlation:
+    float *xdat;
+
+    // input sample position of the first sample of xdat when it holds
+    // the down-mix of a complete fragment, AV_NOPTS_VALUE otherwise:
+    int64_t xdat_position;
+
+    // down-mixed mono fragment decimated for the coarse alignment search,
+    // zero padded the same way:
+    float *xdec;
 } AudioFragment;
 
 /**
@@ -112,13 +125,23 @@ typedef struct ATempoContext {
     // number of channels:
     int channels;
 
-    // row of bytes to skip from one sample to next, across multple channels;
+    // number of planes, 1 for packed sample formats:
+    int planes;
+
+    // row of bytes to skip from one sample to next within a plane;
     // stride = (number-of-channels * bits-per-sample-per-channel) / 8
+    // for packed sample formats, bytes-per-sample for planar ones
     int stride;
 
+    // fragment window duration requested by the user, 0 for the default:
+    int64_t window_duration;
+
     // fragment window size, power-of-two integer:
     int window;
 
+    // decimation factor of the down-mix used by the coarse alignment search:
+    int decimation;
+
     // Hann window coefficients, for feathering
     // (blending) the overlapping fragment region:
     float *hann;
@@ -139,10 +162,16 @@ typedef struct ATempoContext {
     // current state:
     FilterState state;
 
-    // for fast correlation calculation in frequency domain:
-    RDFTContext *real_to_complex;
-    RDFTContext *complex_to_real;
-    FFTSample *correlation;
+    // cross-correlation of the current fragment with the previous one
+    // at the lags being searched:
+    float *correlation;
+
+    ATempoDSPContext dsp;
+
+    // planes of the input and output frames, src and dst pointers
+    // always point into the first plane:
+    uint8_t **src_planes;
+    uint8_t **dst_planes;
 
     // for managing AVFilterPad.request_frame and AVFilterPad.filter_frame
     AVFrame *dst_buffer;
@@ -155,6 +184,14 @@ typedef struct ATempoContext {
 #define YAE_ATEMPO_MIN 0.5
 #define YAE_ATEMPO_MAX 100.0
 
+// smallest fragment window size, in samples:
+#define YAE_WINDOW_MIN 128
+
+// the coarse alignment search runs at no less than this sample rate
+// and on no less than every YAE_DECIMATION_MAX sample:
+#define YAE_DECIMATED_RATE_MIN 4000
+#define YAE_DECIMATION_MAX 8
+
 #define OFFSET(x) offsetof(ATempoContext, x)
 
 static const AVOption atempo_options[] = {
@@ -163,6 +200,11 @@ static const AVOption atempo_options[] = {
       YAE_ATEMPO_MIN,
       YAE_ATEMPO_MAX,
       AV_OPT_FLAG_AUDIO_PARAM | AV_OPT_FLAG_FILTERING_PARAM | AV_OPT_FLAG_RUNTIME_PARAM },
+    { "window", "set fragment window duration, 0 for about 40ms",
+      OFFSET(window_duration), AV_OPT_TYPE_DURATION, { .i64 = 0 },
+      0,
+      1000000,
+      AV_OPT_FLAG_AUDIO_PARAM | AV_OPT_FLAG_FILTERING_PARAM },
     { NULL }
 };
 
@@ -200,10 +242,12 @@ static void yae_clear(ATempoContext *atempo)
     atempo->frag[0].position[0] = 0;
     atempo->frag[0].position[1] = 0;
     atempo->frag[0].nsamples    = 0;
+    atempo->frag[0].xdat_position = AV_NOPTS_VALUE;
 
     atempo->frag[1].position[0] = 0;
     atempo->frag[1].position[1] = 0;
     atempo->frag[1].nsamples    = 0;
+    atempo->frag[1].xdat_position = AV_NOPTS_VALUE;
 
     // shift left position of 1st fragment by half a window
     // so that no re-normalization would be required for
@@ -230,16 +274,12 @@ static void yae_release_buffers(ATempoContext *atempo)
     av_freep(&atempo->frag[1].data);
     av_freep(&atempo->frag[0].xdat);
     av_freep(&atempo->frag[1].xdat);
+    av_freep(&atempo->frag[0].xdec);
+    av_freep(&atempo->frag[1].xdec);
 
     av_freep(&atempo->buffer);
     av_freep(&atempo->hann);
     av_freep(&atempo->correlation);
-
-    av_rdft_end(atempo->real_to_complex);
-    atempo->real_to_complex = NULL;
-
-    av_rdft_end(atempo->complex_to_real);
-    atempo->complex_to_real = NULL;
 }
 
 /* av_realloc is not aligned enough; fortunately, the data does not need to
@@ -264,16 +304,23 @@ static int yae_reset(ATempoContext *atempo,
                      int channels)
 {
     const int sample_size = av_get_bytes_per_sample(format);
+    const int planar = av_sample_fmt_is_planar(format);
     uint32_t nlevels  = 0;
     uint32_t pot;
     int i;
 
     atempo->format   = format;
     atempo->channels = channels;
-    atempo->stride   = sample_size * channels;
+    atempo->planes   = planar ? channels : 1;
+    atempo->stride   = sample_size * (planar ? 1 : channels);
 
     // pick a segment window size:
-    atempo->window = sample_rate / 24;
+    if (atempo->window_duration)
+        atempo->window = av_rescale(atempo->window_duration, sample_rate,
+                                    AV_TIME_BASE);
+    else
+        atempo->window = sample_rate / 24;
+    atempo->window = FFMAX(atempo->window, YAE_WINDOW_MIN);
 
     // adjust window size to be a power-of-two integer:
     nlevels = av_log2(atempo->window);
@@ -285,35 +332,30 @@ static int yae_reset(ATempoContext *atempo,
         nlevels++;
     }
 
-    // initialize audio fragment buffers:
-    RE_MALLOC_OR_FAIL(atempo->frag[0].data, atempo->window * atempo->stride);
-    RE_MALLOC_OR_FAIL(atempo->frag[1].data, atempo->window * atempo->stride);
-    RE_MALLOC_OR_FAIL(atempo->frag[0].xdat, atempo->window * sizeof(FFTComplex));
-    RE_MALLOC_OR_FAIL(atempo->frag[1].xdat, atempo->window * sizeof(FFTComplex));
-
-    // initialize rDFT contexts:
-    av_rdft_end(atempo->real_to_complex);
-    atempo->real_to_complex = NULL;
-
-    av_rdft_end(atempo->complex_to_real);
-    atempo->complex_to_real = NULL;
+    // decimate as much as the sample rate allows, keeping at least
+    // 32 decimated samples per fragment:
+    atempo->decimation = 1 << av_log2(FFMAX(sample_rate / YAE_DECIMATED_RATE_MIN, 1));
+    atempo->decimation = FFMIN(atempo->decimation, YAE_DECIMATION_MAX);
+    atempo->decimation = FFMIN(atempo->decimation, atempo->window / 32);
 
-    atempo->real_to_complex = av_rdft_init(nlevels + 1, DFT_R2C);
-    if (!atempo->real_to_complex) {
-        yae_release_buffers(atempo);
-        return AVERROR(ENOMEM);
-    }
-
-    atempo->complex_to_real = av_rdft_init(nlevels + 1, IDFT_C2R);
-    if (!atempo->complex_to_real) {
-        yae_release_buffers(atempo);
-        return AVERROR(ENOMEM);
+    // initialize audio fragment buffers:
+    RE_MALLOC_OR_FAIL(atempo->frag[0].data, atempo->window * atempo->stride * atempo->planes);
+    RE_MALLOC_OR_FAIL(atempo->frag[1].data, atempo->window * atempo->stride * atempo->planes);
+    RE_MALLOC_OR_FAIL(atempo->frag[0].xdat, atempo->window * 2 * sizeof(float));
+    RE_MALLOC_OR_FAIL(atempo->frag[1].xdat, atempo->window * 2 * sizeof(float));
+    RE_MALLOC_OR_FAIL(atempo->frag[0].xdec, atempo->window / atempo->decimation * 2 * sizeof(float));
+    RE_MALLOC_OR_FAIL(atempo->frag[1].xdec, atempo->window / atempo->decimation * 2 * sizeof(float));
+
+    // the padding is never written to:
+    for (i = 0; i < 2; i++) {
+        memset(atempo->frag[i].xdat, 0, atempo->window * 2 * sizeof(float));
+        memset(atempo->frag[i].xdec, 0, atempo->window / atempo->decimation * 2 * sizeof(float));
     }
 
-    RE_MALLOC_OR_FAIL(atempo->correlation, atempo->window * sizeof(FFTComplex));
+    RE_MALLOC_OR_FAIL(atempo->correlation, atempo->window * sizeof(float));
 
     atempo->ring = atempo->window * 3;
-    RE_MALLOC_OR_FAIL(atempo->buffer, atempo->ring * atempo->stride);
+    RE_MALLOC_OR_FAIL(atempo->buffer, atempo->ring * atempo->stride * atempo->planes);
 
     // initialize the Hann window function:
     RE_MALLOC_OR_FAIL(atempo->hann, atempo->window * sizeof(float));
@@ -340,15 +382,15 @@ static int yae_update(AVFilterContext *ctx)
 }
 
 /**
- * A helper macro for initializing complex data buffer with scalar data
+ * A helper macro for initializing mono data buffer with packed scalar data
  * of a given type.
  */
 #define yae_init_xdat(scalar_type, scalar_max)                          \
     do {                                                                \
         const uint8_t *src_end = src +                                  \
-            frag->nsamples * atempo->channels * sizeof(scalar_type);    \
+            (end - start) * atempo->channels * sizeof(scalar_type);     \
                                                                         \
-        FFTSample *xdat = frag->xdat;                                   \
+        float *xdat = frag->xdat + start;                               \
         scalar_type tmp;                                                \
                                                                         \
         if (atempo->channels == 1) {                                    \
@@ -356,32 +398,32 @@ static int yae_update(AVFilterContext *ctx)
                 tmp = *(const scalar_type *)src;                        \
                 src += sizeof(scalar_type);                             \
                                                                         \
-                *xdat = (FFTSample)tmp;                                 \
+                *xdat = (float)tmp;                                     \
             }                                                           \
         } else {                                                        \
-            FFTSample s, max, ti, si;                                   \
+            float s, max, ti, si;                                       \
             int i;                                                      \
                                                                         \
             for (; src < src_end; xdat++) {                             \
                 tmp = *(const scalar_type *)src;                        \
                 src += sizeof(scalar_type);                             \
                                                                         \
-                max = (FFTSample)tmp;                                   \
-                s = FFMIN((FFTSample)scalar_max,                        \
-                          (FFTSample)fabsf(max));                       \
+                max = (float)tmp;                                       \
+                s = FFMIN((float)scalar_max,                            \
+                          (float)fabsf(max));                           \
                                                                         \
                 for (i = 1; i < atempo->channels; i++) {                \
                     tmp = *(const scalar_type *)src;                    \
                     src += sizeof(scalar_type);                         \
                                                                         \
-                    ti = (FFTSample)tmp;                                \
-                    si = FFMIN((FFTSample)scalar_max,                   \
-                               (FFTSample)fabsf(ti));                   \
+                    ti = (float)tmp;                                    \
+                    si = FFMIN((float)scalar_max,                       \
+                               (float)fabsf(ti));                       \
                                                                         \
-                    if (s < si) {                                       \
-                        s   = si;                                       \
-                        max = ti;                                       \
-                    }                                                   \
+                    /* select without branching, the loudest */         \
+                    /* channel is unpredictable */                      \
+                    max = s < si ? ti : max;                            \
+                    s   = s < si ? si : s;                              \
                 }                                                       \
                                                                         \
                 *xdat = max;                                            \
@@ -390,16 +432,76 @@ static int yae_update(AVFilterContext *ctx)
     } while (0)
 
 /**
- * Initialize complex data buffer of a given audio fragment
- * with down-mixed mono data of appropriate scalar type.
+ * A helper macro for initializing mono data buffer with planar scalar data
+ * of a given type, one plane at a time so that the loops vectorize.
+ */
+#define yae_init_xdat_planar(scalar_type, scalar_max)                   \
+    do {                                                                \
+        const scalar_type *plane = (const scalar_type *)src;            \
+        float *xdat = frag->xdat + start;                               \
+        int i, j;                                                       \
+                                                                        \
+        for (j = 0; j < end - start; j++)                               \
+            xdat[j] = (float)plane[j];                                  \
+                                                                        \
+        for (i = 1; i < atempo->channels; i++) {                        \
+            plane += atempo->window;                                    \
+                                                                        \
+            for (j = 0; j < end - start; j++) {                         \
+                float ti = (float)plane[j];                             \
+                float si = FFMIN((float)scalar_max, fabsf(ti));         \
+                float s  = FFMIN((float)scalar_max, fabsf(xdat[j]));    \
+                                                                        \
+                xdat[j] = s < si ? ti : xdat[j];                        \
+            }                                                           \
+        }                                                               \
+    } while (0)
+
+/**
+ * Initialize mono data buffers of a given audio fragment
+ * with down-mixed data of appropriate scalar type.
  */
 static void yae_downmix(ATempoContext *atempo, AudioFragment *frag)
 {
     // shortcuts:
-    const uint8_t *src = frag->data;
+    const int window = atempo->window;
+    const int decimation = atempo->decimation;
+    const uint8_t *src;
+    int i, j;
+
+    // a complete fragment without zeros substituted for missing data:
+    const int complete =
+        frag->nsamples == window &&
+        frag->position[0] >= atempo->position[0] - atempo->size;
+
+    const int64_t shift =
+        frag->xdat_position != AV_NOPTS_VALUE ?
+        frag->position[0] - frag->xdat_position : window;
+
+    // range of samples to down-mix:
+    int start = 0;
+    int end   = frag->nsamples;
+
+    // the buffers hold the down-mix of a complete fragment from the
+    // same input waveform, reuse what overlaps with this one, which
+    // is most of it after a position adjustment:
+    if (complete && FFABS(shift) < window) {
+        if (shift > 0) {
+            memmove(frag->xdat, frag->xdat + shift,
+                    sizeof(float) * (window - shift));
+            start = window - shift;
+        } else {
+            memmove(frag->xdat - shift, frag->xdat,
+                    sizeof(float) * (window + shift));
+            end = -shift;
+        }
+    }
+    frag->xdat_position = complete ? frag->position[0] : AV_NOPTS_VALUE;
+    src = frag->data + start * atempo->stride;
 
-    // init complex data buffer used for FFT and Correlation:
-    memset(frag->xdat, 0, sizeof(FFTComplex) * atempo->window);
+    // clear what the fragment does not cover:
+    memset(frag->xdat + frag->nsamples, 0,
+           sizeof(float) * (window - frag->nsamples));
 
     if (atempo->format == AV_SAMPLE_FMT_U8) {
         yae_init_xdat(uint8_t, 127);
@@ -411,6 +513,26 @@ static void yae_downmix(ATempoContext *atempo, AudioFragment *frag)
         yae_init_xdat(float, 1);
     } else if (atempo->format == AV_SAMPLE_FMT_DBL) {
         yae_init_xdat(double, 1);
+    } else if (atempo->format == AV_SAMPLE_FMT_U8P) {
+        yae_init_xdat_planar(uint8_t, 127);
+    } else if (atempo->format == AV_SAMPLE_FMT_S16P) {
+        yae_init_xdat_planar(int16_t, 32767);
+    } else if (atempo->format == AV_SAMPLE_FMT_S32P) {
+        yae_init_xdat_planar(int, 2147483647);
+    } else if (atempo->format == AV_SAMPLE_FMT_FLTP) {
+        yae_init_xdat_planar(float, 1);
+    } else if (atempo->format == AV_SAMPLE_FMT_DBLP) {
+        yae_init_xdat_planar(double, 1);
+    }
+
+    // box filter and decimate for the coarse alignment search:
+    for (i = 0; i < window / decimation; i++) {
+        float sum = 0.f;
+
+        for (j = 0; j < decimation; j++)
+            sum += frag->xdat[i * decimation + j];
+
+        frag->xdec[i] = sum;
     }
 }
 
@@ -426,9 +548,11 @@ static int yae_load_data(ATempoContext *atempo,
                          const uint8_t *src_end,
                          int64_t stop_here)
 {
-    // shortcut:
+    // shortcuts:
     const uint8_t *src = *src_ref;
     const int read_size = stop_here - atempo->position[0];
+    const int ring_size = atempo->ring * atempo->stride;
+    int p;
 
     if (stop_here <= atempo->position[0]) {
         return 0;
@@ -451,7 +575,11 @@ static int yae_load_data(ATempoContext *atempo,
 
         if (na) {
             uint8_t *a = atempo->buffer + atempo->tail * atempo->stride;
-            memcpy(a, src, na * atempo->stride);
+            const ptrdiff_t offset = src - atempo->src_planes[0];
+
+            for (p = 0; p < atempo->planes; p++)
+                memcpy(a + p * ring_size, atempo->src_planes[p] + offset,
+                       na * atempo->stride);
 
             src += na * atempo->stride;
             atempo->position[0] += na;
@@ -466,7 +594,11 @@ static int yae_load_data(ATempoContext *atempo,
 
         if (nb) {
             uint8_t *b = atempo->buffer;
-            memcpy(b, src, nb * atempo->stride);
+            const ptrdiff_t offset = src - atempo->src_planes[0];
+
+            for (p = 0; p < atempo->planes; p++)
+                memcpy(b + p * ring_size, atempo->src_planes[p] + offset,
+                       nb * atempo->stride);
 
             src += nb * atempo->stride;
             atempo->position[0] += nb;
@@ -502,11 +634,13 @@ static int yae_load_frag(ATempoContext *atempo,
 {
     // shortcuts:
     AudioFragment *frag = yae_curr_frag(atempo);
+    const int ring_size = atempo->ring * atempo->stride;
+    const int frag_size = atempo->window * atempo->stride;
     uint8_t *dst;
     int64_t missing, start, zeros;
     uint32_t nsamples;
     const uint8_t *a, *b;
-    int i0, i1, n0, n1, na, nb;
+    int i0, i1, n0, n1, na, nb, p;
 
     int64_t stop_here = frag->position[0] + atempo->window;
     if (src_ref && yae_load_data(atempo, src_ref, src_end, stop_here) != 0) {
@@ -534,7 +668,8 @@ static int yae_load_frag(ATempoContext *atempo,
         zeros = FFMIN(start - frag->position[0], (int64_t)nsamples);
         av_assert0(zeros != nsamples);
 
-        memset(dst, 0, zeros * atempo->stride);
+        for (p = 0; p < atempo->planes; p++)
+            memset(dst + p * frag_size, 0, zeros * atempo->stride);
         dst += zeros * atempo->stride;
     }
 
@@ -562,12 +697,16 @@ static int yae_load_frag(ATempoContext *atempo,
     n1 = nsamples - zeros - n0;
 
     if (n0) {
-        memcpy(dst, a + i0 * atempo->stride, n0 * atempo->stride);
+        for (p = 0; p < atempo->planes; p++)
+            memcpy(dst + p * frag_size, a + p * ring_size + i0 * atempo->stride,
+                   n0 * atempo->stride);
         dst += n0 * atempo->stride;
     }
 
     if (n1) {
-        memcpy(dst, b + i1 * atempo->stride, n1 * atempo->stride);
+        for (p = 0; p < atempo->planes; p++)
+            memcpy(dst + p * frag_size, b + p * ring_size + i1 * atempo->stride,
+                   n1 * atempo->stride);
     }
 
     return 0;
@@ -593,37 +732,57 @@ static void yae_advance_to_next_frag(ATempoContext *atempo)
 }
 
 /**
- * Calculate cross-correlation via rDFT.
- *
- * Multiply two vectors of complex numbers (result of real_to_complex rDFT)
- * and transform back via complex_to_real rDFT.
+ * Calculate cross-correlation of two mono fragments of len samples,
+ * zero padded to twice their length, at lags [l0, l1):
+ * xcorr[i - l0] = sum of a[n + i] * b[n]
  */
-static void yae_xcorr_via_rdft(FFTSample *xcorr,
-                               RDFTContext *complex_to_real,
-                               const FFTComplex *xa,
-                               const FFTComplex *xb,
-                               const int window)
+static void yae_xcorr(const ATempoDSPContext *dsp,
+                      float *xcorr,
+                      const float *a,
+                      const float *b,
+                      const int len,
+                      const int l0,
+                      const int l1)
 {
-    FFTComplex *xc = (FFTComplex *)xcorr;
     int i;
 
-    // NOTE: first element requires special care -- Given Y = rDFT(X),
-    // Im(Y[0]) and Im(Y[N/2]) are always zero, therefore av_rdft_calc
-    // stores Re(Y[N/2]) in place of Im(Y[0]).
+    // the fragments overlap over len - i samples at lag i,
+    // the rest of the products are known to be zero:
+    for (i = l0; i < l1; i += 4)
+        dsp->xcorr(xcorr + i - l0, a + i, b, FFALIGN(len - i, 4), 4);
+}
 
-    xc->re = xa->re * xb->re;
-    xc->im = xa->im * xb->im;
-    xa++;
-    xb++;
-    xc++;
+/**
+ * Find the lag of the cross-correlation peak within [l0, l1),
+ * weighted for the search window [i0, i1).
+ */
+static int yae_find_peak(const float *xcorr,
+                         const int l0,
+                         const int l1,
+                         const int step,
+                         const int i0,
+                         const int i1,
+                         const int drift)
+{
+    int       best_lag = -1;
+    float     best_metric = -FLT_MAX;
+    int       l;
+
+    for (l = l0; l < l1; l++, xcorr++) {
+        const int i = l * step;
+        float metric = *xcorr;
 
-    for (i = 1; i < window; i++, xa++, xb++, xc++) {
-        xc->re = (xa->re * xb->re + xa->im * xb->im);
-        xc->im = (xa->im * xb->re - xa->re * xb->im);
+        // normalize:
+        float drifti = (float)(drift + i);
+        metric *= drifti * (float)(i - i0) * (float)(i1 - i);
+
+        if (metric > best_metric) {
+            best_metric = metric;
+            best_lag = l;
+        }
     }
 
-    // apply inverse rDFT:
-    av_rdft_calc(complex_to_real, xcorr);
+    return best_lag;
 }
 
 /**
@@ -632,27 +791,21 @@ static void yae_xcorr_via_rdft(FFTSample *xcorr,
  *
  * @return alignment offset of current fragment relative to previous.
  */
-static int yae_align(AudioFragment *frag,
+static int yae_align(ATempoContext *atempo,
+                     AudioFragment *frag,
                      const AudioFragment *prev,
                      const int window,
                      const int delta_max,
-                     const int drift,
-                     FFTSample *correlation,
-                     RDFTContext *complex_to_real)
+                     const int drift)
 {
-    int       best_offset = -drift;
-    FFTSample best_metric = -FLT_MAX;
-    FFTSample *xcorr;
+    const int decimation = atempo->decimation;
+    float *correlation = atempo->correlation;
+    int best;
 
     int i0;
     int i1;
-    int i;
-
-    yae_xcorr_via_rdft(correlation,
-                       complex_to_real,
-                       (const FFTComplex *)prev->xdat,
-                       (const FFTComplex *)frag->xdat,
-                       window);
+    int l0;
+    int l1;
 
     // identify search window boundaries:
     i0 = FFMAX(window / 2 - delta_max - drift, 0);
@@ -661,23 +814,34 @@ static int yae_align(AudioFragment *frag,
     i1 = FFMIN(window / 2 + delta_max - drift, window - window / 16);
     i1 = FFMAX(i1, 0);
 
-    // identify cross-correlation peaks within search window:
-    xcorr = correlation + i0;
-
-    for (i = i0; i < i1; i++, xcorr++) {
-        FFTSample metric = *xcorr;
-
-        // normalize:
-        FFTSample drifti = (FFTSample)(drift + i);
-        metric *= drifti * (FFTSample)(i - i0) * (FFTSample)(i1 - i);
-
-        if (metric > best_metric) {
-            best_metric = metric;
-            best_offset = i - window / 2;
-        }
+    if (i0 >= i1)
+        return -drift;
+
+    // identify the cross-correlation peak of the decimated fragments
+    // at the lags of the search window:
+    l0 = (i0 + decimation - 1) / decimation;
+    l1 = (i1 + decimation - 1) / decimation;
+
+    yae_xcorr(&atempo->dsp, correlation, prev->xdec, frag->xdec,
+              window / decimation, l0, l1);
+    best = yae_find_peak(correlation, l0, l1, decimation, i0, i1, drift);
+    if (best < 0)
+        return -drift;
+    best *= decimation;
+
+    // refine it at full resolution:
+    if (decimation > 1) {
+        l0 = FFMAX(best - decimation + 1, i0);
+        l1 = FFMIN(best + decimation, i1);
+
+        yae_xcorr(&atempo->dsp, correlation, prev->xdat, frag->xdat,
+                  window, l0, l1);
+        best = yae_find_peak(correlation, l0, l1, 1, i0, i1, drift);
+        if (best < 0)
+            return -drift;
     }
 
-    return best_offset;
+    return best - window / 2;
 }
 
 /**
@@ -701,13 +865,12 @@ static int yae_adjust_position(ATempoContext *atempo)
     const int drift = (int)(prev_output_position - ideal_output_position);
 
     const int delta_max  = atempo->window / 2;
-    const int correction = yae_align(frag,
+    const int correction = yae_align(atempo,
+                                     frag,
                                      prev,
                                      atempo->window,
                                      delta_max,
-                                     drift,
-                                     atempo->correlation,
-                                     atempo->complex_to_real);
+                                     drift);
 
     if (correction) {
         // adjust fragment position:
@@ -753,6 +916,76 @@ static int yae_adjust_position(ATempoContext *atempo)
         dst = (uint8_t *)out;                                           \
     } while (0)
 
+/**
+ * A helper macro for blending the overlap region of previous
+ * and current audio fragment, one channel plane at a time.
+ */
+#define yae_blend_planar(scalar_type)                                   \
+    do {                                                                \
+        const scalar_type *aaa = (const scalar_type *)a;                \
+        const scalar_type *bbb = (const scalar_type *)b;                \
+                                                                        \
+        scalar_type *out = (scalar_type *)dst;                          \
+        int64_t i;                                                      \
+                                                                        \
+        for (i = 0; i < nzeros; i++)                                    \
+            out[i] = aaa[i];                                            \
+                                                                        \
+        for (; i < n; i++) {                                            \
+            float t0 = (float)aaa[i];                                   \
+            float t1 = (float)bbb[i];                                   \
+                                                                        \
+            out[i] = (scalar_type)(t0 * wa[i] + t1 * wb[i]);            \
+        }                                                               \
+    } while (0)
+
+/**
+ * Blend the overlap region of previous and current audio fragment
+ * of a planar sample format.
+ *
+ * @return the number of samples stored in the dst buffer.
+ */
+static int64_t yae_overlap_add_planar(ATempoContext *atempo,
+                                      const uint8_t *a,
+                                      const uint8_t *b,
+                                      const float *wa,
+                                      const float *wb,
+                                      uint8_t *dst,
+                                      const uint8_t *dst_end,
+                                      int64_t overlap)
+{
+    const AudioFragment *frag = yae_curr_frag(atempo);
+    const int64_t n = FFMIN(overlap, (dst_end - dst) / atempo->stride);
+    const ptrdiff_t offset = dst - atempo->dst_planes[0];
+    const int frag_size = atempo->window * atempo->stride;
+
+    // samples before the beginning of the waveform are not blended:
+    const int64_t nzeros = av_clip64(-frag->position[0], 0, n);
+    int p;
+
+    for (p = 0; p < atempo->planes; p++, a += frag_size, b += frag_size) {
+        dst = atempo->dst_planes[p] + offset;
+
+        if (atempo->format == AV_SAMPLE_FMT_U8P) {
+            yae_blend_planar(uint8_t);
+        } else if (atempo->format == AV_SAMPLE_FMT_S16P) {
+            yae_blend_planar(int16_t);
+        } else if (atempo->format == AV_SAMPLE_FMT_S32P) {
+            yae_blend_planar(int);
+        } else if (atempo->format == AV_SAMPLE_FMT_FLTP) {
+            memcpy(dst, a, nzeros * sizeof(float));
+            atempo->dsp.blend_float((float *)dst + nzeros,
+                                    (const float *)a + nzeros,
+                                    (const float *)b + nzeros,
+                                    wa + nzeros, wb + nzeros, n - nzeros);
+        } else if (atempo->format == AV_SAMPLE_FMT_DBLP) {
+            yae_blend_planar(double);
+        }
+    }
+
+    return n;
+}
+
 /**
  * Blend the overlap region of previous and current audio fragment
  * and output the results to the given destination buffer.
@@ -792,7 +1025,12 @@ static int yae_overlap_add(ATempoContext *atempo,
                frag->position[1] <= start_here &&
                overlap <= frag->nsamples);
 
-    if (atempo->format == AV_SAMPLE_FMT_U8) {
+    if (av_sample_fmt_is_planar(atempo->format)) {
+        int64_t n = yae_overlap_add_planar(atempo, a, b, wa, wb,
+                                           dst, dst_end, overlap);
+        atempo->position[1] += n;
+        dst += n * atempo->stride;
+    } else if (atempo->format == AV_SAMPLE_FMT_U8) {
         yae_blend(uint8_t);
     } else if (atempo->format == AV_SAMPLE_FMT_S16) {
         yae_blend(int16_t);
@@ -832,9 +1070,6 @@ yae_apply(ATempoContext *atempo,
             // down-mix to mono:
             yae_downmix(atempo, yae_curr_frag(atempo));
 
-            // apply rDFT:
-            av_rdft_calc(atempo->real_to_complex, yae_curr_frag(atempo)->xdat);
-
             // must load the second fragment before alignment can start:
             if (!atempo->nfrag) {
                 yae_advance_to_next_frag(atempo);
@@ -864,9 +1099,6 @@ yae_apply(ATempoContext *atempo,
             // down-mix to mono:
             yae_downmix(atempo, yae_curr_frag(atempo));
 
-            // apply rDFT:
-            av_rdft_calc(atempo->real_to_complex, yae_curr_frag(atempo)->xdat);
-
             atempo->state = YAE_OUTPUT_OVERLAP_ADD;
         }
 
@@ -906,6 +1138,7 @@ static int yae_flush(ATempoContext *atempo,
     int src_size;
     int dst_size;
     int nbytes;
+    int p;
 
     atempo->state = YAE_FLUSH_OUTPUT;
 
@@ -928,9 +1161,6 @@ static int yae_flush(ATempoContext *atempo,
             // down-mix to mono:
             yae_downmix(atempo, frag);
 
-            // apply rDFT:
-            av_rdft_calc(atempo->real_to_complex, frag->xdat);
-
             // align current fragment to previous fragment:
             if (yae_adjust_position(atempo)) {
                 // reload the current fragment due to adjusted position:
@@ -968,7 +1198,9 @@ static int yae_flush(ATempoContext *atempo,
     dst_size = dst_end - dst;
     nbytes = FFMIN(src_size, dst_size);
 
-    memcpy(dst, src, nbytes);
+    for (p = 0; p < atempo->planes; p++)
+        memcpy(atempo->dst_planes[p] + (dst - atempo->dst_planes[0]),
+               src + p * atempo->window * atempo->stride, nbytes);
     dst += nbytes;
 
     atempo->position[1] += (nbytes / atempo->stride);
@@ -979,11 +1211,53 @@ static int yae_flush(ATempoContext *atempo,
     return atempo->position[1] == stop_here ? 0 : AVERROR(EAGAIN);
 }
 
+static void xcorr_c(float *dst, const float *a, const float *b,
+                    int len, int nb_lags)
+{
+    int i, k;
+
+    for (k = 0; k < nb_lags; k += 4, a += 4) {
+        float s0 = 0.f, s1 = 0.f, s2 = 0.f, s3 = 0.f;
+
+        for (i = 0; i < len; i++) {
+            s0 += a[i    ] * b[i];
+            s1 += a[i + 1] * b[i];
+            s2 += a[i + 2] * b[i];
+            s3 += a[i + 3] * b[i];
+        }
+
+        dst[k    ] = s0;
+        dst[k + 1] = s1;
+        dst[k + 2] = s2;
+        dst[k + 3] = s3;
+    }
+}
+
+static void blend_float_c(float *dst, const float *a, const float *b,
+                          const float *wa, const float *wb, int len)
+{
+    int i;
+
+    for (i = 0; i < len; i++)
+        dst[i] = a[i] * wa[i] + b[i] * wb[i];
+}
+
+void ff_atempo_dsp_init(ATempoDSPContext *dsp)
+{
+    dsp->xcorr       = xcorr_c;
+    dsp->blend_float = blend_float_c;
+
+    /* there is no 32-bit ARM version, armv7 builds use the C code */
+    if (ARCH_AARCH64)
+        ff_atempo_dsp_init_aarch64(dsp);
+}
+
 static av_cold int init(AVFilterContext *ctx)
 {
     ATempoContext *atempo = ctx->priv;
     atempo->format = AV_SAMPLE_FMT_NONE;
     atempo->state  = YAE_LOAD_FRAGMENT;
+    ff_atempo_dsp_init(&atempo->dsp);
     return 0;
 }
 
@@ -1001,8 +1275,9 @@ static int query_formats(AVFilterContext *ctx)
     // WSOLA necessitates an internal sliding window ring buffer
     // for incoming audio stream.
     //
-    // Planar sample formats are too cumbersome to store in a ring buffer,
-    // therefore planar sample formats are not supported.
+    // Planar sample formats are stored in the ring buffer and the
+    // fragments one plane after another, so that decoders output
+    // can be processed without conversion.
     //
     static const enum AVSampleFormat sample_fmts[] = {
         AV_SAMPLE_FMT_U8,
@@ -1010,6 +1285,11 @@ static int query_formats(AVFilterContext *ctx)
         AV_SAMPLE_FMT_S32,
         AV_SAMPLE_FMT_FLT,
         AV_SAMPLE_FMT_DBL,
+        AV_SAMPLE_FMT_U8P,
+        AV_SAMPLE_FMT_S16P,
+        AV_SAMPLE_FMT_S32P,
+        AV_SAMPLE_FMT_FLTP,
+        AV_SAMPLE_FMT_DBLP,
         AV_SAMPLE_FMT_NONE
     };
     int ret;
@@ -1084,9 +1364,11 @@ static int filter_frame(AVFilterLink *inlink, AVFrame *src_buffer)
     int n_in = src_buffer->nb_samples;
     int n_out = (int)(0.5 + ((double)n_in) / atempo->tempo);
 
-    const uint8_t *src = src_buffer->data[0];
+    const uint8_t *src = src_buffer->extended_data[0];
     const uint8_t *src_end = src + n_in * atempo->stride;
 
+    atempo->src_planes = src_buffer->extended_data;
+
     if (atempo->start_pts == AV_NOPTS_VALUE)
         atempo->start_pts = av_rescale_q(src_buffer->pts,
                                          inlink->time_base,
@@ -1101,14 +1383,15 @@ static int filter_frame(AVFilterLink *inlink, AVFrame *src_buffer)
             }
             av_frame_copy_props(atempo->dst_buffer, src_buffer);
 
-            atempo->dst = atempo->dst_buffer->data[0];
+            atempo->dst_planes = atempo->dst_buffer->extended_data;
+            atempo->dst = atempo->dst_buffer->extended_data[0];
             atempo->dst_end = atempo->dst + n_out * atempo->stride;
         }
 
         yae_apply(atempo, &src, src_end, &atempo->dst, atempo->dst_end);
 
         if (atempo->dst == atempo->dst_end) {
-            int n_samples = ((atempo->dst - atempo->dst_buffer->data[0]) /
+            int n_samples = ((atempo->dst - atempo->dst_buffer->extended_data[0]) /
                              atempo->stride);
             ret = push_samples(atempo, outlink, n_samples);
             if (ret < 0)
@@ -1142,13 +1425,14 @@ static int request_frame(AVFilterLink *outlink)
                 if (!atempo->dst_buffer)
                     return AVERROR(ENOMEM);
 
-                atempo->dst = atempo->dst_buffer->data[0];
+                atempo->dst_planes = atempo->dst_buffer->extended_data;
+                atempo->dst = atempo->dst_buffer->extended_data[0];
                 atempo->dst_end = atempo->dst + n_max * atempo->stride;
             }
 
             err = yae_flush(atempo, &atempo->dst, atempo->dst_end);
 
-            n_out = ((atempo->dst - atempo->dst_buffer->data[0]) /
+            n_out = ((atempo->dst - atempo->dst_buffer->extended_data[0]) /
                      atempo->stride);
 
             if (n_out) {
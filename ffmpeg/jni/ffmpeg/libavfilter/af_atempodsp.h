@@ -0,0 +1,45 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef AVFILTER_ATEMPODSP_H
+#define AVFILTER_ATEMPODSP_H
+
+typedef struct ATempoDSPContext {
+    /**
+     * Cross-correlate b with a at nb_lags consecutive lags:
+     * dst[k] = sum of a[i + k] * b[i] for 0 <= i < len.
+     *
+     * @param len     multiple of 4
+     * @param nb_lags multiple of 4, a must be readable up to
+     *                a[len + nb_lags - 1]
+     */
+    void (*xcorr)(float *dst, const float *a, const float *b,
+                  int len, int nb_lags);
+
+    /**
+     * Blend two overlapping fragments of a channel plane:
+     * dst[i] = a[i] * wa[i] + b[i] * wb[i] for 0 <= i < len.
+     */
+    void (*blend_float)(float *dst, const float *a, const float *b,
+                        const float *wa, const float *wb, int len);
+} ATempoDSPContext;
+
+void ff_atempo_dsp_init(ATempoDSPContext *dsp);
+void ff_atempo_dsp_init_aarch64(ATempoDSPContext *dsp);
+
+#endif /* AVFILTER_ATEMPODSP_H */
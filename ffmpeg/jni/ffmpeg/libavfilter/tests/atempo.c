@@ -0,0 +1,265 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * Check the atempo DSP functions against the C versions, then time 2x
+ * tempo on 7.1 input for packed and planar formats with the default and
+ * a low latency fragment window.  Packed and planar input must give the
+ * same output.
+ * tests/atempo [seconds]
+ */
+
+#include "libavutil/lfg.h"
+#include "libavutil/time.h"
+
+#include "libavfilter/af_atempo.c"
+
+#define RATE     48000
+#define CHANNELS 8
+#define TEMPO    2.0
+
+/* the best time of this many runs is printed */
+#define RUNS 3
+
+/* input samples per call, like a decoded frame */
+#define CHUNK 1024
+
+typedef struct Config {
+    enum AVSampleFormat fmt;
+    int64_t window;
+} Config;
+
+static const Config configs[] = {
+    { AV_SAMPLE_FMT_FLT,  0 },
+    { AV_SAMPLE_FMT_FLTP, 0 },
+    { AV_SAMPLE_FMT_S16,  0 },
+    { AV_SAMPLE_FMT_S16P, 0 },
+    { AV_SAMPLE_FMT_FLT,  10000 },
+    { AV_SAMPLE_FMT_FLTP, 10000 },
+    { AV_SAMPLE_FMT_S16,  10000 },
+    { AV_SAMPLE_FMT_S16P, 10000 },
+};
+
+static int check_dsp(AVLFG *lfg)
+{
+    ATempoDSPContext dsp;
+    float a[512 + 8], b[512 + 8], wa[512], wb[512];
+    float ref[64], out[64];
+    int i, len, ret = 0;
+
+    ff_atempo_dsp_init(&dsp);
+
+    for (i = 0; i < FF_ARRAY_ELEMS(a); i++) {
+        a[i] = av_lfg_get(lfg) / (float)UINT32_MAX - 0.5f;
+        b[i] = av_lfg_get(lfg) / (float)UINT32_MAX - 0.5f;
+    }
+    for (i = 0; i < FF_ARRAY_ELEMS(wa); i++) {
+        wa[i] = av_lfg_get(lfg) / (float)UINT32_MAX;
+        wb[i] = 1.f - wa[i];
+    }
+
+    for (len = 4; len <= 512; len += 28) {
+        xcorr_c(ref, a, b, len, 8);
+        dsp.xcorr(out, a, b, len, 8);
+        for (i = 0; i < 8; i++) {
+            if (fabsf(ref[i] - out[i]) > 1e-5f * len) {
+                fprintf(stderr, "xcorr len %d lag %d: %f != %f\n", len, i, out[i], ref[i]);
+                ret = 1;
+            }
+        }
+    }
+
+    for (len = 1; len <= 64; len++) {
+        blend_float_c(ref, a + len, b, wa, wb, len);
+        dsp.blend_float(out, a + len, b, wa, wb, len);
+        for (i = 0; i < len; i++) {
+            if (fabsf(ref[i] - out[i]) > 1e-6f) {
+                fprintf(stderr, "blend_float len %d sample %d: %f != %f\n", len, i, out[i], ref[i]);
+                ret = 1;
+            }
+        }
+    }
+
+    return ret;
+}
+
+static void fill(AVFrame *in, AVLFG *lfg)
+{
+    int i, ch;
+
+    for (i = 0; i < in->nb_samples; i++) {
+        for (ch = 0; ch < CHANNELS; ch++) {
+            float v = 0.3f * sinf(i * (0.013f + ch * 0.002f)) +
+                      0.2f * sinf(i * 0.0711f + ch) +
+                      (av_lfg_get(lfg) / (float)UINT32_MAX - 0.5f) * 0.1f;
+
+            switch (in->format) {
+            case AV_SAMPLE_FMT_FLT:  ((float   *)in->data[0])[i * CHANNELS + ch] = v;           break;
+            case AV_SAMPLE_FMT_FLTP: ((float   *)in->data[ch])[i]                = v;           break;
+            case AV_SAMPLE_FMT_S16:  ((int16_t *)in->data[0])[i * CHANNELS + ch] = v * 32767.f; break;
+            case AV_SAMPLE_FMT_S16P: ((int16_t *)in->data[ch])[i]                = v * 32767.f; break;
+            }
+        }
+    }
+}
+
+/**
+ * Stretch in into out with the whole filter state machine.
+ * @return the number of output samples
+ */
+static int run(const Config *cfg, AVFrame *out, AVFrame *in, int64_t *time)
+{
+    ATempoContext atempo = { 0 };
+    const uint8_t *src;
+    uint8_t *dst, *dst_end;
+    int i, n;
+    int64_t t0;
+
+    atempo.tempo           = TEMPO;
+    atempo.window_duration = cfg->window;
+    ff_atempo_dsp_init(&atempo.dsp);
+    if (yae_reset(&atempo, cfg->fmt, RATE, CHANNELS) < 0)
+        return -1;
+
+    atempo.src_planes = in->extended_data;
+    atempo.dst_planes = out->extended_data;
+    src     = in->extended_data[0];
+    dst     = out->extended_data[0];
+    dst_end = dst + out->nb_samples * atempo.stride;
+
+    t0 = av_gettime_relative();
+    for (i = 0; i < in->nb_samples; i += CHUNK) {
+        const uint8_t *src_end = in->extended_data[0] +
+                                 FFMIN(i + CHUNK, in->nb_samples) * atempo.stride;
+
+        while (src < src_end)
+            yae_apply(&atempo, &src, src_end, &dst, dst_end);
+    }
+    while (yae_flush(&atempo, &dst, dst_end) == AVERROR(EAGAIN) && dst < dst_end)
+        ;
+    *time = av_gettime_relative() - t0;
+
+    n = (dst - out->extended_data[0]) / atempo.stride;
+    yae_release_buffers(&atempo);
+    return n;
+}
+
+static AVFrame *alloc_frame(enum AVSampleFormat fmt, int nb_samples)
+{
+    AVFrame *frame = av_frame_alloc();
+
+    if (!frame)
+        return NULL;
+    frame->format         = fmt;
+    frame->channel_layout = AV_CH_LAYOUT_7POINT1;
+    frame->channels       = CHANNELS;
+    frame->nb_samples     = nb_samples;
+    if (av_frame_get_buffer(frame, 0) < 0)
+        av_frame_free(&frame);
+    return frame;
+}
+
+/**
+ * Compare out with the output of the packed format of the same config.
+ */
+static double max_diff(const AVFrame *out, const AVFrame *packed, int n)
+{
+    double diff = 0;
+    int i, ch;
+
+    for (i = 0; i < n; i++) {
+        for (ch = 0; ch < CHANNELS; ch++) {
+            switch (out->format) {
+            case AV_SAMPLE_FMT_FLTP:
+                diff = FFMAX(diff, fabs(((const float *)out->data[ch])[i] -
+                                        ((const float *)packed->data[0])[i * CHANNELS + ch]));
+                break;
+            case AV_SAMPLE_FMT_S16P:
+                diff = FFMAX(diff, abs(((const int16_t *)out->data[ch])[i] -
+                                       ((const int16_t *)packed->data[0])[i * CHANNELS + ch]));
+                break;
+            }
+        }
+    }
+    return diff;
+}
+
+int main(int argc, char **argv)
+{
+    double seconds = argc > 1 ? atof(argv[1]) : 10;
+    int nb_in  = seconds * RATE;
+    int nb_out = nb_in / TEMPO + RATE;
+    AVFrame *packed = NULL;
+    int i, n_packed = 0, failed = 0;
+    AVLFG lfg;
+
+    av_lfg_init(&lfg, 0xdeadbeef);
+
+    if (check_dsp(&lfg))
+        failed = 1;
+
+    printf("%-6s %10s %10s %10s %10s\n", "format", "window", "samples", "time (us)", "realtime");
+    for (i = 0; i < FF_ARRAY_ELEMS(configs); i++) {
+        const Config *cfg = &configs[i];
+        AVFrame *in  = alloc_frame(cfg->fmt, nb_in);
+        AVFrame *out = alloc_frame(cfg->fmt, nb_out);
+        int64_t time = INT64_MAX, t;
+        int n, r;
+
+        if (!in || !out) {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+
+        av_lfg_init(&lfg, 0xdeadbeef);
+        fill(in, &lfg);
+        for (r = 0; r < RUNS; r++) {
+            n = run(cfg, out, in, &t);
+            time = FFMIN(time, t);
+        }
+
+        printf("%-6s %10"PRId64" %10d %10"PRId64" %9.0fx\n",
+               av_get_sample_fmt_name(cfg->fmt), cfg->window, n, time,
+               time ? seconds * 1e6 / time : 0.0);
+
+        if (n < nb_in / TEMPO - RATE / 10 || n > nb_in / TEMPO + RATE / 10) {
+            fprintf(stderr, "%s: %d samples out of %d\n",
+                    av_get_sample_fmt_name(cfg->fmt), n, nb_in);
+            failed = 1;
+        }
+
+        if (av_sample_fmt_is_planar(cfg->fmt)) {
+            double diff = max_diff(out, packed, FFMIN(n, n_packed));
+            if (n != n_packed || diff > (cfg->fmt == AV_SAMPLE_FMT_FLTP ? 1e-6 : 0)) {
+                fprintf(stderr, "%s: output differs from packed (%d / %d samples, max diff %g)\n",
+                        av_get_sample_fmt_name(cfg->fmt), n, n_packed, diff);
+                failed = 1;
+            }
+            av_frame_free(&packed);
+            av_frame_free(&out);
+        } else {
+            av_frame_free(&packed);
+            packed   = out;
+            n_packed = n;
+        }
+        av_frame_free(&in);
+    }
+    av_frame_free(&packed);
+
+    return failed;
+}
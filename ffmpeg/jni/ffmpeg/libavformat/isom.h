@@ -154,6 +154,26 @@ typedef struct MOVIndexRange {
     int64_t end;
 } MOVIndexRange;
 
+/**
+ * Position in the stts/stsc/stsz/stco tables of a track, used instead of
+ * st->index_entries when the demuxer is asked for a compact index.
+ */
+typedef struct MOVSampleCursor {
+    int nb_samples;                  ///< number of samples reachable through the tables
+    int64_t start_dts;               ///< dts of the first sample
+    int key_off;                     ///< 1 if stss/stps sample numbers are 1-based
+    int nb_discard;                  ///< leading samples before the edit, flagged AVINDEX_DISCARD_FRAME
+    unsigned int *stts_first_sample; ///< first sample of each stts entry
+    int64_t *stts_first_dts;         ///< dts of each stts entry, relative to start_dts
+    unsigned int *stsc_first_sample; ///< first sample of each stsc entry
+    int sample;                      ///< sample described by entry, -1 if none
+    unsigned int stts_index;
+    unsigned int stsc_index;
+    unsigned int chunk;
+    unsigned int chunk_sample;       ///< sample number inside the chunk
+    AVIndexEntry entry;              ///< current sample, as it would be in st->index_entries
+} MOVSampleCursor;
+
 typedef struct MOVStreamContext {
     AVIOContext *pb;
     int pb_is_copied;
@@ -192,6 +212,8 @@ typedef struct MOVStreamContext {
     int64_t current_index;
     MOVIndexRange* index_ranges;
     MOVIndexRange* current_index_range;
+    int compact_index;    ///< samples are located through cursor, st->index_entries is empty
+    MOVSampleCursor cursor;
     unsigned int bytes_per_frame;
     unsigned int samples_per_frame;
     int dv_audio_container;
@@ -290,6 +312,7 @@ typedef struct MOVContext {
     int decryption_key_len;
     int enable_drefs;
     int32_t movie_display_matrix[3][3]; ///< display matrix from mvhd
+    int compact_index;
 } MOVContext;
 
 int ff_mp4_read_descr_len(AVIOContext *pb);
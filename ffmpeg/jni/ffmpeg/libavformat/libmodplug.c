@@ -33,7 +33,6 @@
 typedef struct ModPlugContext {
     const AVClass *class;
     ModPlugFile *f;
-    uint8_t *buf; ///< input file content
 
     /* options */
     int noise_reduction;
@@ -161,6 +160,56 @@ static int modplug_load_metadata(AVFormatContext *s)
 
 #define AUDIO_PKT_SIZE 512
 
+typedef struct ModPlugReaderContext {
+    AVIOContext *pb;
+    int64_t start; ///< offset of the module in pb
+} ModPlugReaderContext;
+
+static int modplug_reader_read(void *opaque, void *buf, int size)
+{
+    ModPlugReaderContext *r = opaque;
+    int ret = avio_read(r->pb, buf, size);
+    return ret == AVERROR_EOF ? 0 : ret;
+}
+
+static int modplug_reader_seek(void *opaque, long offset)
+{
+    ModPlugReaderContext *r = opaque;
+    return avio_seek(r->pb, r->start + offset, SEEK_SET) < 0 ? -1 : 0;
+}
+
+static int modplug_load(AVFormatContext *s, int64_t sz)
+{
+    ModPlugContext *modplug = s->priv_data;
+    int64_t start = avio_tell(s->pb);
+    int64_t size  = (s->pb->seekable & AVIO_SEEKABLE_NORMAL) ? avio_size(s->pb) : -1;
+    uint8_t *buf;
+
+    /* Let libmodplug read the sample data again once it has parsed the
+     * file, instead of holding the whole file and the samples at once.
+     * This needs the real size, without it the whole buffer is read. */
+    if (sz > 0 && size > 0 && start >= 0 && size > start) {
+        ModPlugReaderContext r = { s->pb, start };
+        ModPlugReader reader = {
+            .opaque = &r,
+            .read   = modplug_reader_read,
+            .seek   = modplug_reader_seek,
+            .size   = FFMIN(sz, size - start),
+        };
+        modplug->f = ModPlug_LoadReader(&reader);
+    } else {
+        buf = av_malloc(FFMAX(sz, 1));
+        if (!buf)
+            return AVERROR(ENOMEM);
+        sz = avio_read(s->pb, buf, sz);
+        /* libmodplug keeps no reference to the file content */
+        if (sz >= 0)
+            modplug->f = ModPlug_Load(buf, sz);
+        av_free(buf);
+    }
+    return modplug->f ? 0 : AVERROR_INVALIDDATA;
+}
+
 static int modplug_read_header(AVFormatContext *s)
 {
     AVStream *st;
@@ -168,6 +217,7 @@ static int modplug_read_header(AVFormatContext *s)
     ModPlug_Settings settings;
     ModPlugContext *modplug = s->priv_data;
     int64_t sz = avio_size(pb);
+    int ret;
 
     if (sz < 0) {
         av_log(s, AV_LOG_WARNING, "Could not determine file size\n");
@@ -186,11 +236,6 @@ static int modplug_read_header(AVFormatContext *s)
             return r;
     }
 
-    modplug->buf = av_malloc(modplug->max_size);
-    if (!modplug->buf)
-        return AVERROR(ENOMEM);
-    sz = avio_read(pb, modplug->buf, sz);
-
     ModPlug_GetSettings(&settings);
     settings.mChannels       = 2;
     settings.mBits           = 16;
@@ -215,11 +260,9 @@ static int modplug_read_header(AVFormatContext *s)
 
     ModPlug_SetSettings(&settings);
 
-    modplug->f = ModPlug_Load(modplug->buf, sz);
-    if (!modplug->f) {
-        av_freep(&modplug->buf);
-        return AVERROR_INVALIDDATA;
-    }
+    ret = modplug_load(s, sz);
+    if (ret < 0)
+        return ret;
     st = avformat_new_stream(s, NULL);
     if (!st)
         return AVERROR(ENOMEM);
@@ -340,7 +383,6 @@ static int modplug_read_close(AVFormatContext *s)
 {
     ModPlugContext *modplug = s->priv_data;
     ModPlug_Unload(modplug->f);
-    av_freep(&modplug->buf);
     return 0;
 }
 
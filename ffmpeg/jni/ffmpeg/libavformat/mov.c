@@ -3350,6 +3350,458 @@ static int64_t add_ctts_entry(MOVStts** ctts_data, unsigned int* ctts_count, uns
     return *ctts_count;
 }
 
+/**
+ * Reset the stsz sample size when it contradicts the chunk layout.
+ */
+static void mov_check_stsz_sample_size(MOVContext *mov, MOVStreamContext *sc,
+                                       unsigned int stsc_index,
+                                       int64_t current_offset, int64_t next_offset)
+{
+    if (next_offset > current_offset && sc->sample_size>0 && sc->sample_size < sc->stsz_sample_size &&
+        sc->stsc_data[stsc_index].count * (int64_t)sc->stsz_sample_size > next_offset - current_offset) {
+        av_log(mov->fc, AV_LOG_WARNING, "STSZ sample size %d invalid (too large), ignoring\n", sc->stsz_sample_size);
+        sc->stsz_sample_size = sc->sample_size;
+    }
+    if (sc->stsz_sample_size>0 && sc->stsz_sample_size < sc->sample_size) {
+        av_log(mov->fc, AV_LOG_WARNING, "STSZ sample size %d invalid (too small), ignoring\n", sc->stsz_sample_size);
+        sc->stsz_sample_size = sc->sample_size;
+    }
+}
+
+/**
+ * Return the index of the last entry of the sorted table tab which is not
+ * greater than val, or -1 if there is none.
+ */
+static int mov_bsearch_last_le(const unsigned int *tab, unsigned int count, int64_t val)
+{
+    int lo = -1, hi = count;
+
+    while (hi - lo > 1) {
+        int mid = (lo + hi) >> 1;
+        if (tab[mid] <= val)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * Check whether the sample tables of st can be walked directly, without
+ * expanding them into st->index_entries.
+ */
+static int mov_sample_tables_walkable(MOVContext *mov, AVStream *st)
+{
+    MOVStreamContext *sc = st->priv_data;
+    unsigned int i;
+
+    if (st->codecpar->codec_type != AVMEDIA_TYPE_VIDEO &&
+        st->codecpar->codec_type != AVMEDIA_TYPE_AUDIO)
+        return 0;
+    /* uncompressed audio is demuxed in chunks of 1024 samples */
+    if (st->codecpar->codec_type == AVMEDIA_TYPE_AUDIO &&
+        sc->stts_count == 1 && sc->stts_data[0].duration == 1)
+        return 0;
+    /* fragments append their samples to st->index_entries */
+    if (mov->trex_data || mov->frag_index.nb_items)
+        return 0;
+    if (!sc->sample_count || sc->sample_count > INT_MAX || !sc->chunk_count ||
+        !sc->stts_count || !sc->stsc_count || sc->stsc_data[0].first != 1 ||
+        (!sc->stsz_sample_size && !sc->sample_sizes) ||
+        sc->rap_group_count || st->nb_index_entries)
+        return 0;
+
+    /* samples of other sample descriptions are skipped by the full index */
+    if (sc->pseudo_stream_id != -1)
+        for (i = 0; i < sc->stsc_count; i++)
+            if (sc->stsc_data[i].id - 1 != sc->pseudo_stream_id)
+                return 0;
+
+    for (i = 0; i < sc->stts_count; i++)
+        if (!sc->stts_data[i].count || sc->stts_data[i].duration < 0)
+            return 0;
+    for (i = 0; i < sc->keyframe_count; i++)
+        if (sc->keyframes[i] < 0 || (i && sc->keyframes[i] <= sc->keyframes[i - 1]))
+            return 0;
+    for (i = 1; i < sc->stps_count; i++)
+        if (sc->stps_data[i] <= sc->stps_data[i - 1])
+            return 0;
+
+    return 1;
+}
+
+static int64_t mov_cursor_dts(MOVStreamContext *sc, int sample)
+{
+    const MOVSampleCursor *cur = &sc->cursor;
+    int i;
+
+    if (cur->sample >= 0 && sample == cur->sample)
+        return cur->entry.timestamp;
+    if (cur->sample >= 0 && sample == cur->sample + 1)
+        return cur->entry.timestamp + sc->stts_data[cur->stts_index].duration;
+
+    i = mov_bsearch_last_le(cur->stts_first_sample, sc->stts_count, sample);
+    return cur->start_dts + cur->stts_first_dts[i] +
+           (sample - cur->stts_first_sample[i]) * (int64_t)sc->stts_data[i].duration;
+}
+
+static int mov_cursor_is_keyframe(AVStream *st, MOVStreamContext *sc, int sample)
+{
+    int64_t num = sample + (int64_t)sc->cursor.key_off;
+    int i;
+
+    if (!sc->keyframe_absent) {
+        if (!sc->keyframe_count)
+            return 1;
+        i = mov_bsearch_last_le((const unsigned int *)sc->keyframes, sc->keyframe_count, num);
+        if (i >= 0 && sc->keyframes[i] == num)
+            return 1;
+    }
+    if (sc->stps_count) {
+        i = mov_bsearch_last_le(sc->stps_data, sc->stps_count, num);
+        if (i >= 0 && sc->stps_data[i] == num)
+            return 1;
+    }
+    if (sc->keyframe_absent && !sc->stps_count)
+        return st->codecpar->codec_type == AVMEDIA_TYPE_AUDIO || !sample;
+    return 0;
+}
+
+/**
+ * Return the nearest sync sample before (backward) or after sample found in
+ * the sync sample table tab, INT64_MAX or -1 if there is none.
+ */
+static int64_t mov_cursor_sync_sample(const unsigned int *tab, unsigned int count,
+                                      int key_off, int64_t sample, int backward)
+{
+    int i = mov_bsearch_last_le(tab, count, sample + key_off - !backward);
+
+    if (backward)
+        return i >= 0 ? tab[i] - (int64_t)key_off : -1;
+    return i + 1 < count ? tab[i + 1] - (int64_t)key_off : INT64_MAX;
+}
+
+static int mov_cursor_find_keyframe(AVStream *st, MOVStreamContext *sc, int sample, int backward)
+{
+    int64_t best = backward ? -1 : INT64_MAX, found;
+
+    if (sample < 0 || sample >= sc->cursor.nb_samples)
+        return -1;
+    if ((!sc->keyframe_absent && !sc->keyframe_count) ||
+        (sc->keyframe_absent && !sc->stps_count &&
+         st->codecpar->codec_type == AVMEDIA_TYPE_AUDIO))
+        return sample;
+
+    if (!sc->keyframe_absent) {
+        found = mov_cursor_sync_sample((const unsigned int *)sc->keyframes, sc->keyframe_count,
+                                       sc->cursor.key_off, sample, backward);
+        best = backward ? FFMAX(best, found) : FFMIN(best, found);
+    }
+    if (sc->stps_count) {
+        found = mov_cursor_sync_sample(sc->stps_data, sc->stps_count,
+                                       sc->cursor.key_off, sample, backward);
+        best = backward ? FFMAX(best, found) : FFMIN(best, found);
+    } else if (sc->keyframe_absent) {
+        best = backward || !sample ? 0 : INT64_MAX;
+    }
+
+    return best >= 0 && best < sc->cursor.nb_samples ? best : -1;
+}
+
+static void mov_cursor_update_entry(AVStream *st, MOVStreamContext *sc)
+{
+    MOVSampleCursor *cur = &sc->cursor;
+
+    cur->entry.timestamp    = cur->start_dts + cur->stts_first_dts[cur->stts_index] +
+                              (cur->sample - cur->stts_first_sample[cur->stts_index]) *
+                              (int64_t)sc->stts_data[cur->stts_index].duration;
+    cur->entry.size         = sc->stsz_sample_size > 0 ? sc->stsz_sample_size :
+                              sc->sample_sizes[cur->sample];
+    cur->entry.min_distance = 0;
+    cur->entry.flags        = (mov_cursor_is_keyframe(st, sc, cur->sample) ? AVINDEX_KEYFRAME : 0) |
+                              (cur->sample < cur->nb_discard ? AVINDEX_DISCARD_FRAME : 0);
+}
+
+/**
+ * Position the cursor on an arbitrary sample, bisecting the stts and stsc
+ * tables.
+ */
+static void mov_cursor_seek(AVStream *st, MOVStreamContext *sc, int sample)
+{
+    MOVSampleCursor *cur = &sc->cursor;
+    unsigned int rel, count;
+    int64_t pos;
+    int i;
+
+    cur->stts_index   = mov_bsearch_last_le(cur->stts_first_sample, sc->stts_count, sample);
+    cur->stsc_index   = mov_bsearch_last_le(cur->stsc_first_sample, sc->stsc_count, sample);
+    rel               = sample - cur->stsc_first_sample[cur->stsc_index];
+    count             = sc->stsc_data[cur->stsc_index].count;
+    cur->chunk        = sc->stsc_data[cur->stsc_index].first - 1 + rel / count;
+    cur->chunk_sample = rel % count;
+
+    pos = sc->chunk_offsets[cur->chunk];
+    if (sc->stsz_sample_size > 0)
+        pos += cur->chunk_sample * (int64_t)sc->stsz_sample_size;
+    else
+        for (i = sample - cur->chunk_sample; i < sample; i++)
+            pos += sc->sample_sizes[i];
+
+    cur->sample    = sample;
+    cur->entry.pos = pos;
+    mov_cursor_update_entry(st, sc);
+}
+
+/**
+ * Advance the cursor to the next sample during sequential reading.
+ */
+static void mov_cursor_next(AVStream *st, MOVStreamContext *sc)
+{
+    MOVSampleCursor *cur = &sc->cursor;
+
+    cur->entry.pos += cur->entry.size;
+    cur->sample++;
+    if (++cur->chunk_sample == sc->stsc_data[cur->stsc_index].count) {
+        cur->chunk++;
+        cur->chunk_sample = 0;
+        if (mov_stsc_index_valid(cur->stsc_index, sc->stsc_count) &&
+            cur->chunk + 1 == sc->stsc_data[cur->stsc_index + 1].first)
+            cur->stsc_index++;
+        cur->entry.pos = sc->chunk_offsets[cur->chunk];
+    }
+    if (cur->stts_index + 1 < sc->stts_count &&
+        cur->sample >= cur->stts_first_sample[cur->stts_index + 1])
+        cur->stts_index++;
+    mov_cursor_update_entry(st, sc);
+}
+
+/**
+ * Set up the cursor of st so that its samples are read from the sample
+ * tables. The tables are kept for the lifetime of the demuxer.
+ */
+static int mov_init_sample_cursor(MOVContext *mov, AVStream *st, int64_t start_dts)
+{
+    MOVStreamContext *sc = st->priv_data;
+    MOVSampleCursor *cur = &sc->cursor;
+    uint64_t total = 0;
+    int64_t dts = 0, stream_size = 0;
+    unsigned int i, stsc_index = 0;
+    int nb_samples;
+
+    cur->stts_first_sample = av_malloc_array(sc->stts_count, sizeof(*cur->stts_first_sample));
+    cur->stts_first_dts    = av_malloc_array(sc->stts_count, sizeof(*cur->stts_first_dts));
+    cur->stsc_first_sample = av_malloc_array(sc->stsc_count, sizeof(*cur->stsc_first_sample));
+    if (!cur->stts_first_sample || !cur->stts_first_dts || !cur->stsc_first_sample) {
+        av_freep(&cur->stts_first_sample);
+        av_freep(&cur->stts_first_dts);
+        av_freep(&cur->stsc_first_sample);
+        return AVERROR(ENOMEM);
+    }
+
+    for (i = 0; i < sc->stts_count; i++) {
+        cur->stts_first_sample[i] = FFMIN(total, sc->sample_count);
+        cur->stts_first_dts[i]    = dts;
+        total += sc->stts_data[i].count;
+        dts   += sc->stts_data[i].count * (int64_t)sc->stts_data[i].duration;
+    }
+    total = 0;
+    for (i = 0; i < sc->stsc_count; i++) {
+        cur->stsc_first_sample[i] = FFMIN(total, sc->sample_count);
+        total += mov_get_stsc_samples(sc, i);
+    }
+    if (total > sc->sample_count)
+        av_log(mov->fc, AV_LOG_ERROR, "wrong sample count\n");
+    nb_samples = FFMIN(total, sc->sample_count);
+
+    for (i = 0; i < sc->chunk_count; i++) {
+        int64_t next_offset = i+1 < sc->chunk_count ? sc->chunk_offsets[i+1] : INT64_MAX;
+        while (mov_stsc_index_valid(stsc_index, sc->stsc_count) &&
+            i + 1 == sc->stsc_data[stsc_index + 1].first)
+            stsc_index++;
+        mov_check_stsz_sample_size(mov, sc, stsc_index, sc->chunk_offsets[i], next_offset);
+    }
+
+    for (i = 0; i < nb_samples; i++) {
+        unsigned int sample_size = sc->stsz_sample_size > 0 ? sc->stsz_sample_size : sc->sample_sizes[i];
+        if (sample_size > 0x3FFFFFFF) {
+            av_log(mov->fc, AV_LOG_ERROR, "Sample size %u is too large\n", sample_size);
+            nb_samples = i;
+            break;
+        }
+        if (sc->stsz_sample_size > 0) {
+            stream_size = nb_samples * (int64_t)sample_size;
+            break;
+        }
+        stream_size += sample_size;
+    }
+
+    cur->nb_samples = nb_samples;
+    cur->start_dts  = start_dts;
+    cur->key_off    = (sc->keyframe_count && sc->keyframes[0] > 0) || (sc->stps_count && sc->stps_data[0] > 0);
+    cur->sample     = -1;
+    sc->compact_index = 1;
+
+    av_log(mov->fc, AV_LOG_DEBUG, "stream %d, %d samples located from the sample tables\n",
+           st->index, nb_samples);
+
+    if (st->codecpar->codec_type == AVMEDIA_TYPE_VIDEO)
+        for (i = 0; i < FFMIN(nb_samples, 99); i++)
+            ff_rfps_add_frame(mov->fc, st, mov_cursor_dts(sc, i));
+    if (st->duration > 0)
+        st->codecpar->bit_rate = stream_size*8*sc->time_scale/st->duration;
+
+    return 0;
+}
+
+/**
+ * Check whether mov_fix_index() would keep all samples of st in order for
+ * its single edit, so that the sample cursor gives the same index. Audio may
+ * start up to 1 s into the track, the samples before the edit are then
+ * flagged for discard and the start of the first one kept is skipped. Video
+ * has to start with a keyframe presented at the start of the edit, and must
+ * not present any sample outside of it.
+ *
+ * @param start    media time of the edit
+ * @param duration duration of the edit, in the track time scale
+ * @param min_pts  set to the value mov_fix_index() gives min_corrected_pts
+ * @return 1 if the edit can be applied by the cursor, 0 otherwise
+ */
+static int mov_cursor_check_edit(AVStream *st, int64_t start, int64_t duration,
+                                 int64_t *min_pts)
+{
+    MOVStreamContext *sc = st->priv_data;
+    int audio = st->codecpar->codec_type == AVMEDIA_TYPE_AUDIO;
+    unsigned int stts_index = 0, stts_sample = 0;
+    unsigned int ctts_index = 0, ctts_sample = 0;
+    int64_t nb_samples = 0, dts = 0, i;
+    int end_keyframes = 0, found = 0;
+
+    for (i = 0; i < sc->stsc_count; i++)
+        nb_samples += mov_get_stsc_samples(sc, i);
+    nb_samples = FFMIN(nb_samples, sc->sample_count);
+
+    sc->cursor.key_off    = (sc->keyframe_count && sc->keyframes[0] > 0) || (sc->stps_count && sc->stps_data[0] > 0);
+    sc->cursor.nb_discard = 0;
+    if (!nb_samples || sc->stts_data[0].duration <= 0 ||
+        !mov_cursor_is_keyframe(st, sc, 0))
+        return 0;
+    if (audio && (sc->ctts_data || start > sc->time_scale ||
+                  st->codecpar->codec_id == AV_CODEC_ID_VORBIS))
+        return 0;
+
+    for (i = 0; i < nb_samples; i++) {
+        int64_t sample_duration = sc->stts_data[stts_index].duration;
+        int64_t pts = dts;
+
+        if (sc->ctts_data && ctts_index < sc->ctts_count) {
+            pts += sc->ctts_data[ctts_index].duration;
+            if (++ctts_sample == sc->ctts_data[ctts_index].count) {
+                ctts_index++;
+                ctts_sample = 0;
+            }
+        }
+
+        if (audio) {
+            /* mov_fix_index() drops or discards the samples after the edit */
+            if (i == nb_samples - 1 ? dts < start || dts >= start + duration :
+                                      dts + sample_duration >= start + duration)
+                return 0;
+            if (dts >= start && !found) {
+                *min_pts = dts - start;
+                found    = 1;
+            } else if (dts + sample_duration <= start) {
+                sc->cursor.nb_discard++;
+            }
+        } else {
+            if (pts < start || pts >= start + duration || (i ? pts == start : pts != start))
+                return 0;
+            /* mov_fix_index() stops at the first keyframe ending the edit,
+             * or the second one with ctts */
+            if (i < nb_samples - 1 && pts + sample_duration >= start + duration &&
+                mov_cursor_is_keyframe(st, sc, i) && ++end_keyframes > !!sc->ctts_data)
+                return 0;
+        }
+
+        dts += sample_duration;
+        if (stts_index + 1 < sc->stts_count && ++stts_sample == sc->stts_data[stts_index].count) {
+            stts_index++;
+            stts_sample = 0;
+        }
+    }
+    if (!audio)
+        *min_pts = start;
+
+    return 1;
+}
+
+static int mov_nb_samples(AVStream *st)
+{
+    MOVStreamContext *sc = st->priv_data;
+    return sc->compact_index ? sc->cursor.nb_samples : st->nb_index_entries;
+}
+
+/**
+ * Return the index entry of the given sample, either from st->index_entries
+ * or synthesized from the sample tables. The latter is only valid until the
+ * next call for the same stream.
+ */
+static AVIndexEntry *mov_get_sample(AVStream *st, int sample)
+{
+    MOVStreamContext *sc = st->priv_data;
+
+    if (sample < 0 || sample >= mov_nb_samples(st))
+        return NULL;
+    if (!sc->compact_index)
+        return &st->index_entries[sample];
+
+    if (sample != sc->cursor.sample) {
+        if (sc->cursor.sample >= 0 && sample == sc->cursor.sample + 1)
+            mov_cursor_next(st, sc);
+        else
+            mov_cursor_seek(st, sc, sample);
+    }
+    return &sc->cursor.entry;
+}
+
+/**
+ * Return the dts of the given sample without moving the cursor.
+ */
+static int64_t mov_get_sample_dts(AVStream *st, int sample)
+{
+    MOVStreamContext *sc = st->priv_data;
+
+    if (!sc->compact_index)
+        return st->index_entries[sample].timestamp;
+    return mov_cursor_dts(sc, sample);
+}
+
+/**
+ * Same as av_index_search_timestamp(), for both kinds of index.
+ */
+static int mov_search_sample(AVStream *st, int64_t timestamp, int flags)
+{
+    MOVStreamContext *sc = st->priv_data;
+    int a = -1, b, m;
+
+    if (!sc->compact_index)
+        return av_index_search_timestamp(st, timestamp, flags);
+
+    b = sc->cursor.nb_samples;
+    while (b - a > 1) {
+        int64_t dts;
+        m   = (a + b) >> 1;
+        dts = mov_cursor_dts(sc, m);
+        if (dts >= timestamp)
+            b = m;
+        if (dts <= timestamp)
+            a = m;
+    }
+    m = (flags & AVSEEK_FLAG_BACKWARD) ? a : b;
+    if (flags & AVSEEK_FLAG_ANY)
+        return m >= 0 && m < sc->cursor.nb_samples ? m : -1;
+    return mov_cursor_find_keyframe(st, sc, m, flags & AVSEEK_FLAG_BACKWARD);
+}
+
 #define MAX_REORDER_DELAY 16
 static void mov_estimate_video_delay(MOVContext *c, AVStream* st) {
     MOVStreamContext *msc = st->priv_data;
@@ -3366,14 +3818,14 @@ static void mov_estimate_video_delay(MOVContext *c, AVStream* st) {
     if (st->codecpar->video_delay <= 0 && msc->ctts_data &&
         st->codecpar->codec_id == AV_CODEC_ID_H264) {
         st->codecpar->video_delay = 0;
-        for(ind = 0; ind < st->nb_index_entries && ctts_ind < msc->ctts_count; ++ind) {
+        for(ind = 0; ind < mov_nb_samples(st) && ctts_ind < msc->ctts_count; ++ind) {
             // Point j to the last elem of the buffer and insert the current pts there.
             j = buf_start;
             buf_start = (buf_start + 1);
             if (buf_start == MAX_REORDER_DELAY + 1)
                 buf_start = 0;
 
-            pts_buf[j] = st->index_entries[ind].timestamp + msc->ctts_data[ctts_ind].duration;
+            pts_buf[j] = mov_get_sample(st, ind)->timestamp + msc->ctts_data[ctts_ind].duration;
 
             // The timestamps that are already in the sorted buffer, and are greater than the
             // current pts, are exactly the timestamps that need to be buffered to output PTS
@@ -3775,11 +4227,13 @@ static void mov_build_index(MOVContext *mov, AVStream *st)
     uint64_t stream_size = 0;
     MOVStts *ctts_data_old = sc->ctts_data;
     unsigned int ctts_count_old = sc->ctts_count;
+    int compact = 0;
 
     if (sc->elst_count) {
         int i, edit_start_index = 0, multiple_edits = 0;
         int64_t empty_duration = 0; // empty duration of the first edit list entry
         int64_t start_time = 0; // start time of the media
+        int64_t min_pts = 0;
 
         for (i = 0; i < sc->elst_count; i++) {
             const MOVElst *e = &sc->elst_data[i];
@@ -3795,6 +4249,20 @@ static void mov_build_index(MOVContext *mov, AVStream *st)
             }
         }
 
+        /* With advanced_editlist, the sample cursor only handles a single
+         * edit for which mov_fix_index() keeps the samples in order. */
+        compact = mov->compact_index && !multiple_edits && mov_sample_tables_walkable(mov, st);
+        if (compact && mov->advanced_editlist &&
+            (edit_start_index >= sc->elst_count || mov->time_scale <= 0 ||
+             !mov_cursor_check_edit(st, start_time,
+                                    av_rescale(sc->elst_data[edit_start_index].duration,
+                                               sc->time_scale, mov->time_scale),
+                                    &min_pts))) {
+            av_log(mov->fc, AV_LOG_INFO, "stream %d: edit list not supported "
+                   "by compact_index, building the full index\n", st->index);
+            compact = 0;
+        }
+
         if (multiple_edits && !mov->advanced_editlist)
             av_log(mov->fc, AV_LOG_WARNING, "multiple edit list entries, "
                    "Use -advanced_editlist to correctly decode otherwise "
@@ -3806,18 +4274,35 @@ static void mov_build_index(MOVContext *mov, AVStream *st)
                 empty_duration = av_rescale(empty_duration, sc->time_scale, mov->time_scale);
             sc->time_offset = start_time - empty_duration;
             sc->min_corrected_pts = start_time;
-            if (!mov->advanced_editlist)
+            if (!mov->advanced_editlist || compact)
                 current_dts = -sc->time_offset;
         }
 
-        if (!multiple_edits && !mov->advanced_editlist &&
+        if (!multiple_edits && (!mov->advanced_editlist || compact) &&
             st->codecpar->codec_id == AV_CODEC_ID_AAC && start_time > 0)
             sc->start_pad = start_time;
+
+        if (compact && mov->advanced_editlist) {
+            int64_t edit_duration = av_rescale(sc->elst_data[edit_start_index].duration,
+                                               sc->time_scale, mov->time_scale);
+
+            /* the stream fields mov_fix_index() would have set */
+            st->start_time        = empty_duration;
+            st->duration          = FFMIN(st->duration, empty_duration + edit_duration);
+            sc->min_corrected_pts = min_pts;
+            if (st->codecpar->codec_type == AVMEDIA_TYPE_AUDIO)
+                st->skip_samples = sc->start_pad = start_time;
+        }
+    } else {
+        compact = mov->compact_index && mov_sample_tables_walkable(mov, st);
     }
 
+    if (compact) {
+        if (mov_init_sample_cursor(mov, st, current_dts - sc->dts_shift) < 0)
+            return;
     /* only use old uncompressed audio chunk demuxing when stts specifies it */
-    if (!(st->codecpar->codec_type == AVMEDIA_TYPE_AUDIO &&
-          sc->stts_count == 1 && sc->stts_data[0].duration == 1)) {
+    } else if (!(st->codecpar->codec_type == AVMEDIA_TYPE_AUDIO &&
+                 sc->stts_count == 1 && sc->stts_data[0].duration == 1)) {
         unsigned int current_sample = 0;
         unsigned int stts_sample = 0;
         unsigned int sample_size;
@@ -3876,15 +4361,7 @@ static void mov_build_index(MOVContext *mov, AVStream *st)
                 i + 1 == sc->stsc_data[stsc_index + 1].first)
                 stsc_index++;
 
-            if (next_offset > current_offset && sc->sample_size>0 && sc->sample_size < sc->stsz_sample_size &&
-                sc->stsc_data[stsc_index].count * (int64_t)sc->stsz_sample_size > next_offset - current_offset) {
-                av_log(mov->fc, AV_LOG_WARNING, "STSZ sample size %d invalid (too large), ignoring\n", sc->stsz_sample_size);
-                sc->stsz_sample_size = sc->sample_size;
-            }
-            if (sc->stsz_sample_size>0 && sc->stsz_sample_size < sc->sample_size) {
-                av_log(mov->fc, AV_LOG_WARNING, "STSZ sample size %d invalid (too small), ignoring\n", sc->stsz_sample_size);
-                sc->stsz_sample_size = sc->sample_size;
-            }
+            mov_check_stsz_sample_size(mov, sc, stsc_index, current_offset, next_offset);
 
             for (j = 0; j < sc->stsc_data[stsc_index].count; j++) {
                 int keyframe = 0;
@@ -4074,14 +4551,14 @@ static void mov_build_index(MOVContext *mov, AVStream *st)
         }
     }
 
-    if (!mov->ignore_editlist && mov->advanced_editlist) {
+    if (!compact && !mov->ignore_editlist && mov->advanced_editlist) {
         // Fix index according to edit lists.
         mov_fix_index(mov, st);
     }
 
     // Update start time of the stream.
-    if (st->start_time == AV_NOPTS_VALUE && st->codecpar->codec_type == AVMEDIA_TYPE_VIDEO && st->nb_index_entries > 0) {
-        st->start_time = st->index_entries[0].timestamp + sc->dts_shift;
+    if (st->start_time == AV_NOPTS_VALUE && st->codecpar->codec_type == AVMEDIA_TYPE_VIDEO && mov_nb_samples(st) > 0) {
+        st->start_time = mov_get_sample_dts(st, 0) + sc->dts_shift;
         if (sc->ctts_data) {
             st->start_time += sc->ctts_data[0].duration;
         }
@@ -4201,6 +4678,36 @@ static void fix_timescale(MOVContext *c, MOVStreamContext *sc)
     }
 }
 
+static void mov_free_sample_tables(MOVStreamContext *sc)
+{
+    av_freep(&sc->chunk_offsets);
+    av_freep(&sc->sample_sizes);
+    av_freep(&sc->keyframes);
+    av_freep(&sc->stts_data);
+    av_freep(&sc->stps_data);
+    av_freep(&sc->elst_data);
+    av_freep(&sc->cursor.stts_first_sample);
+    av_freep(&sc->cursor.stts_first_dts);
+    av_freep(&sc->cursor.stsc_first_sample);
+}
+
+/**
+ * Build st->index_entries for a stream whose samples were located from the
+ * sample tables, for when samples have to be appended to it.
+ */
+static void mov_expand_compact_index(MOVContext *c, AVStream *st)
+{
+    MOVStreamContext *sc = st->priv_data;
+
+    sc->compact_index = 0;
+    sc->start_pad = 0;
+    mov_build_index(c, st);
+    mov_free_sample_tables(sc);
+    /* ctts is now expanded to one entry per sample */
+    sc->ctts_index  = sc->current_sample;
+    sc->ctts_sample = 0;
+}
+
 static int mov_read_trak(MOVContext *c, AVIOContext *pb, MOVAtom atom)
 {
     AVStream *st;
@@ -4318,13 +4825,9 @@ static int mov_read_trak(MOVContext *c, AVIOContext *pb, MOVAtom atom)
         && sc->time_scale == st->codecpar->sample_rate) {
             st->need_parsing = AVSTREAM_PARSE_FULL;
     }
-    /* Do not need those anymore. */
-    av_freep(&sc->chunk_offsets);
-    av_freep(&sc->sample_sizes);
-    av_freep(&sc->keyframes);
-    av_freep(&sc->stts_data);
-    av_freep(&sc->stps_data);
-    av_freep(&sc->elst_data);
+    /* Do not need those anymore, unless samples are located from them. */
+    if (!sc->compact_index)
+        mov_free_sample_tables(sc);
     av_freep(&sc->rap_group);
 
     return 0;
@@ -4764,6 +5267,8 @@ static int mov_read_trun(MOVContext *c, AVIOContext *pb, MOVAtom atom)
     sc = st->priv_data;
     if (sc->pseudo_stream_id+1 != frag->stsd_id && sc->pseudo_stream_id != -1)
         return 0;
+    if (sc->compact_index)
+        mov_expand_compact_index(c, st);
 
     // Find the next frag_index index that has a valid index_entry for
     // the current track_id.
@@ -7285,6 +7790,9 @@ static int mov_read_close(AVFormatContext *s)
         av_freep(&sc->rap_group);
         av_freep(&sc->display_matrix);
         av_freep(&sc->index_ranges);
+        av_freep(&sc->cursor.stts_first_sample);
+        av_freep(&sc->cursor.stts_first_dts);
+        av_freep(&sc->cursor.stsc_first_sample);
 
         if (sc->extradata)
             for (j = 0; j < sc->stsd_count; j++)
@@ -7684,8 +8192,8 @@ static AVIndexEntry *mov_find_next_sample(AVFormatContext *s, AVStream **st)
     for (i = 0; i < s->nb_streams; i++) {
         AVStream *avst = s->streams[i];
         MOVStreamContext *msc = avst->priv_data;
-        if (msc->pb && msc->current_sample < avst->nb_index_entries) {
-            AVIndexEntry *current_sample = &avst->index_entries[msc->current_sample];
+        AVIndexEntry *current_sample;
+        if (msc->pb && (current_sample = mov_get_sample(avst, msc->current_sample))) {
             int64_t dts = av_rescale(current_sample->timestamp, AV_TIME_BASE, msc->time_scale);
             av_log(s, AV_LOG_TRACE, "stream %d, sample %d, dts %"PRId64"\n", i, msc->current_sample, dts);
             if (!sample || (!(s->pb->seekable & AVIO_SEEKABLE_NORMAL) && current_sample->pos < sample->pos) ||
@@ -7861,8 +8369,8 @@ static int mov_read_packet(AVFormatContext *s, AVPacket *pkt)
             sc->ctts_sample = 0;
         }
     } else {
-        int64_t next_dts = (sc->current_sample < st->nb_index_entries) ?
-            st->index_entries[sc->current_sample].timestamp : st->duration;
+        int64_t next_dts = (sc->current_sample < mov_nb_samples(st)) ?
+            mov_get_sample_dts(st, sc->current_sample) : st->duration;
 
         if (next_dts >= pkt->dts)
             pkt->duration = next_dts - pkt->dts;
@@ -7941,9 +8449,9 @@ static int mov_seek_stream(AVFormatContext *s, AVStream *st, int64_t timestamp,
     if (ret < 0)
         return ret;
 
-    sample = av_index_search_timestamp(st, timestamp, flags);
+    sample = mov_search_sample(st, timestamp, flags);
     av_log(s, AV_LOG_TRACE, "stream %d, timestamp %"PRId64", sample %d\n", st->index, timestamp, sample);
-    if (sample < 0 && st->nb_index_entries && timestamp < st->index_entries[0].timestamp)
+    if (sample < 0 && mov_nb_samples(st) && timestamp < mov_get_sample_dts(st, 0))
         sample = 0;
     if (sample < 0) /* not sure what to do */
         return AVERROR_INVALIDDATA;
@@ -7998,7 +8506,7 @@ static int mov_read_seek(AVFormatContext *s, int stream_index, int64_t sample_ti
 
     if (mc->seek_individually) {
         /* adjust seek timestamp to found sample timestamp */
-        int64_t seek_timestamp = st->index_entries[sample].timestamp;
+        int64_t seek_timestamp = mov_get_sample_dts(st, sample);
 
         for (i = 0; i < s->nb_streams; i++) {
             int64_t timestamp;
@@ -8076,6 +8584,8 @@ static const AVOption mov_options[] = {
     { "decryption_key", "The media decryption key (hex)", OFFSET(decryption_key), AV_OPT_TYPE_BINARY, .flags = AV_OPT_FLAG_DECODING_PARAM },
     { "enable_drefs", "Enable external track support.", OFFSET(enable_drefs), AV_OPT_TYPE_BOOL,
         {.i64 = 0}, 0, 1, FLAGS },
+    { "compact_index", "Locate samples from the sample tables instead of building a full index.",
+        OFFSET(compact_index), AV_OPT_TYPE_BOOL, {.i64 = 0}, 0, 1, FLAGS },
 
     { NULL },
 };
@@ -702,6 +702,7 @@ AVInputFormat ff_mpegps_demuxer = {
 typedef struct VobSubDemuxContext {
     const AVClass *class;
     AVFormatContext *sub_ctx;
+    int sub_ctx_error;
     FFDemuxSubtitlesQueue q[32];
     char *sub_name;
 } VobSubDemuxContext;
@@ -736,7 +737,6 @@ static int vobsub_read_header(AVFormatContext *s)
     int stream_id = -1;
     char id[64] = {0};
     char alt[MAX_LINE_SIZE] = {0};
-    ff_const59 AVInputFormat *iformat;
 
     if (!vobsub->sub_name) {
         char *ext;
@@ -756,30 +756,12 @@ static int vobsub_read_header(AVFormatContext *s)
         av_log(s, AV_LOG_VERBOSE, "IDX/SUB: %s -> %s\n", s->url, vobsub->sub_name);
     }
 
-    if (!(iformat = av_find_input_format("mpeg"))) {
-        return AVERROR_DEMUXER_NOT_FOUND;
-    }
-
-    vobsub->sub_ctx = avformat_alloc_context();
-    if (!vobsub->sub_ctx) {
-        return AVERROR(ENOMEM);
-    }
+    /* The .sub is only opened by the first vobsub_read_packet() call: all
+     * timing information comes from the .idx, and opening a large .sub over
+     * the network would otherwise hold up the start of playback. */
 
     av_bprint_init(&header, 0, INT_MAX - AV_INPUT_BUFFER_PADDING_SIZE);
 
-#ifdef MXTECHS
-    /* Setup interrupt callback for network source.*/
-    vobsub->sub_ctx->interrupt_callback = s->interrupt_callback;
-#endif
-    if ((ret = ff_copy_whiteblacklists(vobsub->sub_ctx, s)) < 0)
-        goto end;
-
-    ret = avformat_open_input(&vobsub->sub_ctx, vobsub->sub_name, iformat, NULL);
-    if (ret < 0) {
-        av_log(s, AV_LOG_ERROR, "Unable to open %s as MPEG subtitles\n", vobsub->sub_name);
-        goto end;
-    }
-
     while (!avio_feof(s->pb)) {
         char line[MAX_LINE_SIZE];
         int len = ff_get_line(s->pb, line, sizeof(line));
@@ -923,26 +905,81 @@ end:
     return ret;
 }
 
+static int vobsub_open_sub(AVFormatContext *s)
+{
+    VobSubDemuxContext *vobsub = s->priv_data;
+    ff_const59 AVInputFormat *iformat;
+    int ret;
+
+    if (!(iformat = av_find_input_format("mpeg")))
+        return AVERROR_DEMUXER_NOT_FOUND;
+
+    vobsub->sub_ctx = avformat_alloc_context();
+    if (!vobsub->sub_ctx)
+        return AVERROR(ENOMEM);
+
+#ifdef MXTECHS
+    /* Setup interrupt callback for network source.*/
+    vobsub->sub_ctx->interrupt_callback = s->interrupt_callback;
+#endif
+    if ((ret = ff_copy_whiteblacklists(vobsub->sub_ctx, s)) < 0) {
+        avformat_free_context(vobsub->sub_ctx);
+        vobsub->sub_ctx = NULL;
+        return ret;
+    }
+
+    ret = avformat_open_input(&vobsub->sub_ctx, vobsub->sub_name, iformat, NULL);
+    if (ret < 0) {
+        av_log(s, AV_LOG_ERROR, "Unable to open %s as MPEG subtitles\n", vobsub->sub_name);
+        return ret;
+    }
+    return 0;
+}
+
 static int vobsub_read_packet(AVFormatContext *s, AVPacket *pkt)
 {
     VobSubDemuxContext *vobsub = s->priv_data;
     FFDemuxSubtitlesQueue *q;
-    AVIOContext *pb = vobsub->sub_ctx->pb;
+    AVIOContext *pb;
     int ret, psize, total_read = 0, i;
 
-    int64_t min_ts = INT64_MAX;
-    int sid = 0;
-    for (i = 0; i < s->nb_streams; i++) {
-        FFDemuxSubtitlesQueue *tmpq = &vobsub->q[i];
-        int64_t ts;
-        av_assert0(tmpq->nb_subs);
-        ts = tmpq->subs[tmpq->current_sub_idx].pts;
-        if (ts < min_ts) {
-            min_ts = ts;
-            sid = i;
+    /* Pick the earliest pending entry of all streams. Entries of discarded
+     * streams are consumed from the index without touching the .sub, so
+     * only the selected languages are fetched and a stream enabled later on
+     * resumes at the current position. */
+    for (;;) {
+        int64_t min_ts = INT64_MAX;
+        int sid = -1;
+        for (i = 0; i < s->nb_streams; i++) {
+            FFDemuxSubtitlesQueue *tmpq = &vobsub->q[i];
+            int64_t ts;
+            av_assert0(tmpq->nb_subs);
+            if (tmpq->current_sub_idx >= tmpq->nb_subs)
+                continue;
+            ts = tmpq->subs[tmpq->current_sub_idx].pts;
+            if (ts < min_ts) {
+                min_ts = ts;
+                sid = i;
+            }
+        }
+        if (sid < 0)
+            return AVERROR_EOF;
+        q = &vobsub->q[sid];
+        if (s->streams[sid]->discard < AVDISCARD_ALL)
+            break;
+        q->current_sub_idx++;
+    }
+
+    if (!vobsub->sub_ctx) {
+        if (vobsub->sub_ctx_error)
+            return vobsub->sub_ctx_error;
+        if ((ret = vobsub_open_sub(s)) < 0) {
+            vobsub->sub_ctx_error = ret;
+            return ret;
         }
     }
-    q = &vobsub->q[sid];
+    pb = vobsub->sub_ctx->pb;
+
     /* The returned packet will have size zero,
      * so that it can be directly used with av_grow_packet. */
     ret = ff_subtitles_queue_read_packet(q, pkt);
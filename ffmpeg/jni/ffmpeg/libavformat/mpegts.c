@@ -157,6 +157,13 @@ struct MpegTSContext {
     int resync_size;
     int merge_pmt_versions;
 
+    /** program to demux: -1 for all, 0 for the first one carrying video */
+    int select_program;
+    /** service id of the demuxed program once known, 0 otherwise */
+    unsigned int selected_program;
+    /** the last PAT did not list select_program */
+    int selected_program_missing;
+
     /******************************************/
     /* private mpegts data */
     /* scan context */
@@ -191,6 +198,10 @@ static const AVOption options[] = {
      {.i64 = 0}, 0, 1, 0 },
     {"skip_clear", "skip clearing programs", offsetof(MpegTSContext, skip_clear), AV_OPT_TYPE_BOOL,
      {.i64 = 0}, 0, 1, 0 },
+    {"select_program", "only demux the program with this number", offsetof(MpegTSContext, select_program), AV_OPT_TYPE_INT,
+     {.i64 = -1}, -1, 0xffff, AV_OPT_FLAG_DECODING_PARAM, "select_program" },
+        {"all",   "demux all programs",                     0, AV_OPT_TYPE_CONST, {.i64 = -1}, 0, 0, AV_OPT_FLAG_DECODING_PARAM, "select_program" },
+        {"video", "demux the first program carrying video", 0, AV_OPT_TYPE_CONST, {.i64 =  0}, 0, 0, AV_OPT_FLAG_DECODING_PARAM, "select_program" },
     { NULL },
 };
 
@@ -346,6 +357,35 @@ static void set_pmt_found(MpegTSContext *ts, unsigned int programid)
     p->pmt_found = 1;
 }
 
+/**
+ * @return 1 if the program with service id sid is demuxed according to the
+ *         select_program option, 0 otherwise
+ */
+static int program_selected(MpegTSContext *ts, unsigned int sid)
+{
+    return ts->select_program < 0 || !ts->selected_program ||
+           sid == ts->selected_program;
+}
+
+/**
+ * Make sid the only demuxed program, dropping the PAT entries of all others
+ * so that their PMTs no longer hold back the end of header parsing.
+ */
+static void select_program(MpegTSContext *ts, unsigned int sid)
+{
+    int i, j;
+
+    ts->selected_program = sid;
+    for (i = j = 0; i < ts->nb_prg; i++)
+        if (ts->prg[i].id == sid)
+            ts->prg[j++] = ts->prg[i];
+    ts->nb_prg = j;
+    /* parse the SDT again, its entry for sid was skipped so far */
+    if (ts->pids[SDT_PID] && ts->pids[SDT_PID]->type == MPEGTS_SECTION)
+        ts->pids[SDT_PID]->u.section_filter.last_ver = -1;
+    av_log(ts->stream, AV_LOG_VERBOSE, "demuxing program %u only\n", sid);
+}
+
 static void update_av_program_info(AVFormatContext *s, unsigned int programid,
                                    unsigned int pid, int version)
 {
@@ -895,6 +935,31 @@ static void mpegts_find_stream_type(AVStream *st,
         }
 }
 
+/**
+ * Check whether a PMT lists an elementary stream of a video stream type.
+ * @param p     first byte after the section header
+ * @param p_end end of the section, excluding the CRC
+ */
+static int pmt_has_video(const uint8_t *p, const uint8_t *p_end)
+{
+    const StreamType *types;
+    int stream_type, desc_list_len;
+
+    if (p_end - p < 4)
+        return 0;
+    p += 4 + (AV_RB16(p + 2) & 0xfff);
+    while (p_end - p >= 5) {
+        stream_type   = p[0];
+        desc_list_len = AV_RB16(p + 3) & 0xfff;
+        for (types = ISO_types; types->stream_type; types++)
+            if (types->stream_type == stream_type)
+                if (types->codec_type == AVMEDIA_TYPE_VIDEO)
+                    return 1;
+        p += 5 + desc_list_len;
+    }
+    return 0;
+}
+
 static int mpegts_set_stream_info(AVStream *st, PESContext *pes,
                                   uint32_t stream_type, uint32_t prog_reg_desc)
 {
@@ -2239,6 +2304,7 @@ static void pmt_cb(MpegTSFilter *filter, const uint8_t *section, int section_len
 
     int mp4_descr_count = 0;
     Mp4Descr mp4_descr[MAX_MP4_DESCR_COUNT] = { { 0 } };
+    AVProgram *program;
     int i;
 
     av_log(ts->stream, AV_LOG_TRACE, "PMT: len %i\n", section_len);
@@ -2261,6 +2327,20 @@ static void pmt_cb(MpegTSFilter *filter, const uint8_t *section, int section_len
 
     if (ts->skip_unknown_pmt && !get_program(ts, h->id))
         return;
+    if (!program_selected(ts, h->id))
+        return;
+    if (ts->select_program == 0 && !ts->selected_program) {
+        if (!pmt_has_video(p, p_end)) {
+            set_pmt_found(ts, h->id);
+            return;
+        }
+        select_program(ts, h->id);
+        program = av_new_program(ts->stream, h->id);
+        if (program) {
+            program->program_num = h->id;
+            program->pmt_pid = filter->pid;
+        }
+    }
     if (!ts->skip_clear)
         clear_program(ts, h->id);
 
@@ -2476,12 +2556,18 @@ static void pat_cb(MpegTSFilter *filter, const uint8_t *section, int section_len
 
         if (sid == 0x0000) {
             /* NIT info */
+        } else if (!program_selected(ts, sid)) {
+            /* not demuxed, so no PMT filter and no AVProgram */
         } else {
             MpegTSFilter *fil = ts->pids[pmt_pid];
-            program = av_new_program(ts->stream, sid);
-            if (program) {
-                program->program_num = sid;
-                program->pmt_pid = pmt_pid;
+            /* with select_program=video the AVProgram is only created once
+             * its PMT shows that it carries video */
+            if (ts->select_program || ts->selected_program) {
+                program = av_new_program(ts->stream, sid);
+                if (program) {
+                    program->program_num = sid;
+                    program->pmt_pid = pmt_pid;
+                }
             }
             if (fil)
                 if (   fil->type != MPEGTS_SECTION
@@ -2497,6 +2583,14 @@ static void pat_cb(MpegTSFilter *filter, const uint8_t *section, int section_len
         }
     }
 
+    if (ts->select_program > 0) {
+        int missing = !get_program(ts, ts->select_program);
+        if (missing && !ts->selected_program_missing)
+            av_log(ts->stream, AV_LOG_WARNING, "program %d not found in PAT\n",
+                   ts->select_program);
+        ts->selected_program_missing = missing;
+    }
+
     if (sid < 0) {
         int i,j;
         for (j=0; j<ts->stream->nb_programs; j++) {
@@ -2627,7 +2721,7 @@ static void sdt_cb(MpegTSFilter *filter, const uint8_t *section, int section_len
                 if (!provider_name)
                     break;
                 name = getstr8(&p, p_end);
-                if (name) {
+                if (name && (ts->select_program < 0 || sid == ts->selected_program)) {
                     AVProgram *program = av_new_program(ts->stream, sid);
                     if (program) {
                         av_dict_set(&program->metadata, "service_name", name, 0);
@@ -2840,6 +2934,20 @@ static int mpegts_resync(AVFormatContext *s, int seekback, const uint8_t *curren
     }
 
     for (i = 0; i < ts->resync_size; i++) {
+        /* scan what is already buffered with memchr() instead of
+         * going through avio_r8() for every byte */
+        int len = FFMIN(pb->buf_end - pb->buf_ptr, ts->resync_size - i);
+        if (len > 0) {
+            const uint8_t *sync = memchr(pb->buf_ptr, 0x47, len);
+            if (sync) {
+                avio_skip(pb, sync - pb->buf_ptr);
+                reanalyze(s->priv_data);
+                return 0;
+            }
+            avio_skip(pb, len);
+            i += len - 1;
+            continue;
+        }
         c = avio_r8(pb);
         if (avio_feof(pb))
             return AVERROR_EOF;
@@ -3020,6 +3128,17 @@ static void seek_back(AVFormatContext *s, AVIOContext *pb, int64_t pos) {
         av_log(s, (pb->seekable & AVIO_SEEKABLE_NORMAL) ? AV_LOG_ERROR : AV_LOG_INFO, "Unable to seek back to the start\n");
 }
 
+static void mpegts_free(MpegTSContext *ts)
+{
+    int i;
+
+    clear_programs(ts);
+
+    for (i = 0; i < NB_PID_MAX; i++)
+        if (ts->pids[i])
+            mpegts_close_filter(ts, ts->pids[i]);
+}
+
 static int mpegts_read_header(AVFormatContext *s)
 {
     MpegTSContext *ts = s->priv_data;
@@ -3039,6 +3158,8 @@ static int mpegts_read_header(AVFormatContext *s)
     }
     ts->stream     = s;
     ts->auto_guess = 0;
+    if (ts->select_program > 0)
+        ts->selected_program = ts->select_program;
 
     if (s->iformat == &ff_mpegts_demuxer) {
         /* normal demux */
@@ -3053,7 +3174,24 @@ static int mpegts_read_header(AVFormatContext *s)
         handle_packets(ts, probesize / ts->raw_packet_size);
         /* if could not find service, enable auto_guess */
 
-        ts->auto_guess = 1;
+        /* PIDs of programs which were not selected must not come back
+         * as guessed streams */
+        ts->auto_guess = ts->select_program < 0 ||
+                         ts->pids[PAT_PID]->u.section_filter.last_ver < 0;
+
+        /* nothing would be demuxed, don't let it look like an empty file */
+        if (ts->selected_program_missing) {
+            mpegts_free(ts);
+            return AVERROR_STREAM_NOT_FOUND;
+        }
+        if (ts->select_program == 0 && !ts->selected_program &&
+            !ts->auto_guess) {
+            av_log(s, AV_LOG_WARNING, "no program with video found, "
+                   "demuxing all programs\n");
+            /* the PAT and PMTs are parsed again after seek_back() */
+            ts->select_program = -1;
+            ts->auto_guess     = 1;
+        }
 
         av_log(ts->stream, AV_LOG_TRACE, "tuning done\n");
 
@@ -3202,17 +3340,6 @@ static int mpegts_read_packet(AVFormatContext *s, AVPacket *pkt)
     return ret;
 }
 
-static void mpegts_free(MpegTSContext *ts)
-{
-    int i;
-
-    clear_programs(ts);
-
-    for (i = 0; i < NB_PID_MAX; i++)
-        if (ts->pids[i])
-            mpegts_close_filter(ts, ts->pids[i]);
-}
-
 static int mpegts_read_close(AVFormatContext *s)
 {
     MpegTSContext *ts = s->priv_data;
@@ -41,9 +41,16 @@ typedef struct PGSSegmentHeader
     uint16_t size;
 } PGSSegmentHeader;
 
+enum SUPScanMode {
+    SCAN_NONE,
+    SCAN_OPEN, ///< build the seek index in read_header
+    SCAN_SEEK, ///< build the seek index on the first seek
+};
+
 typedef struct {
     AVClass *class;
     int scan;
+    int scanned;
     PGSSegmentHeader start;
     PGSSegmentHeader end;
 } SUPDecContext;
@@ -91,46 +98,60 @@ static int sup_read_segment_header(AVFormatContext *s, PGSSegmentHeader *header)
     header->type = avio_r8(s->pb);
     header->size = avio_rb16(s->pb);
 
-    //skip over segment
-    avio_skip(s->pb, header->size);
-
     ff_dlog(s, "pts:%lld %f type:%s size:%d\n", header->pts, header->pts / 90000.0f, get_segment_type_string(header->type), header->size);
 
     return avio_feof(s->pb) ? AVERROR_EOF : 0;
 }
 
+/**
+ * Read the rest of a segment whose header has just been read. For a
+ * presentation segment, return whether it starts a display set which can
+ * be decoded on its own (epoch start or acquisition point); only its first
+ * 8 payload bytes are read, everything else is skipped.
+ */
+static int sup_skip_segment(AVFormatContext *s, const PGSSegmentHeader *header)
+{
+    int size = header->size, state = 0;
+
+    if (header->type == PRESENTATION_SEGMENT && size >= 8) {
+        avio_skip(s->pb, 7); // width, height, frame rate, composition number
+        state = avio_r8(s->pb);
+        size -= 8;
+    }
+    avio_skip(s->pb, size);
+
+    return state & 0xc0;
+}
+
+/**
+ * Build the seek index from the 13 byte segment headers alone, so that
+ * seeking does not have to scan through the segment payloads.
+ */
 static int sup_read_scan(AVFormatContext *s, AVStream *st)
 {
     SUPDecContext* c = s->priv_data;
-    int ret;
-    int64_t pos = avio_tell(s->pb);
+    PGSSegmentHeader header;
+    int64_t pos = avio_tell(s->pb), seg_pos;
+    int ret, found = 0;
 
-    avio_seek(s->pb, 0, SEEK_SET);
+    c->scanned = 1;
+    if (avio_seek(s->pb, 0, SEEK_SET) < 0)
+        return AVERROR(EIO);
 
-    int64_t pos2;
-    do
-    {
-        pos2 = avio_tell(s->pb);
-        ret = sup_read_segment_header(s, &c->start);
-        if (c->start.type == PRESENTATION_SEGMENT)
-        {
-            av_add_index_entry(st, pos2, c->start.pts, 0, 0, AVINDEX_KEYFRAME);
+    for (;;) {
+        seg_pos = avio_tell(s->pb);
+        if ((ret = sup_read_segment_header(s, &header)) < 0)
             break;
+        if (sup_skip_segment(s, &header)) {
+            av_add_index_entry(st, seg_pos, header.pts, 0, 0, AVINDEX_KEYFRAME);
+            if (!found++)
+                c->start = header;
         }
-    } while(0 == ret);
-
-    do
-    {
-        pos2 = avio_tell(s->pb);
-        ret = sup_read_segment_header(s, &c->end);
-        if (c->end.type == PRESENTATION_SEGMENT)
-        {
-            av_add_index_entry(st, pos2, c->end.pts, 0, 0, AVINDEX_KEYFRAME);
-        }
-    } while(0 == ret);
+        c->end = header;
+    }
 
     avio_seek(s->pb, pos, SEEK_SET);
-    return 0;
+    return found ? 0 : ret;
 }
 #endif
 
@@ -146,7 +167,7 @@ static int sup_read_header(AVFormatContext *s)
     st->codecpar->codec_id = AV_CODEC_ID_HDMV_PGS_SUBTITLE;
     avpriv_set_pts_info(st, 32, 1, 90000);
 #ifdef MXTECHS
-    if (c->scan && 0 == sup_read_scan(s, st)){
+    if (c->scan == SCAN_OPEN && 0 == sup_read_scan(s, st)){
         st->duration = c->end.pts - c->start.pts;
     }
 #endif
@@ -156,8 +177,14 @@ static int sup_read_header(AVFormatContext *s)
 #ifdef MXTECHS
 static int sup_read_seek(AVFormatContext *s, int stream_index, int64_t timestamp, int flags)
 {
+    SUPDecContext *c = s->priv_data;
     AVStream *st = s->streams[stream_index];
-    int index = av_index_search_timestamp(st, timestamp, flags);
+    int index;
+
+    if (c->scan == SCAN_SEEK && !c->scanned && 0 == sup_read_scan(s, st))
+        st->duration = c->end.pts - c->start.pts;
+
+    index = av_index_search_timestamp(st, timestamp, flags);
     if (index < 0)
         return -1;
 
@@ -237,8 +264,11 @@ static int sup_probe(const AVProbeData *p)
 static const AVOption pgs_options[] = {
     {"scan",
     "Scan all the display set for duration and speed up seek performance",
-    OFFSET(scan), AV_OPT_TYPE_BOOL, { .i64 = 1 },
-    0, 1, FLAGS},
+    OFFSET(scan), AV_OPT_TYPE_INT, { .i64 = SCAN_OPEN },
+    SCAN_NONE, SCAN_SEEK, FLAGS, "scan"},
+        {"none", "do not build a seek index",         0, AV_OPT_TYPE_CONST, { .i64 = SCAN_NONE }, 0, 0, FLAGS, "scan"},
+        {"open", "build the seek index when opening", 0, AV_OPT_TYPE_CONST, { .i64 = SCAN_OPEN }, 0, 0, FLAGS, "scan"},
+        {"seek", "build the seek index on first seek",0, AV_OPT_TYPE_CONST, { .i64 = SCAN_SEEK }, 0, 0, FLAGS, "scan"},
     { NULL },
 };
 
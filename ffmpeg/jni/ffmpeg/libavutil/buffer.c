@@ -363,3 +363,199 @@ void *av_buffer_pool_buffer_get_opaque(AVBufferRef *ref)
     av_assert0(buf);
     return buf->opaque;
 }
+
+#define CACHE_MIN_LOG2  14      ///< smaller buffers are not cached
+#define CACHE_STEPS      8      ///< size classes per power of two
+#define CACHE_BUCKETS   ((31 - CACHE_MIN_LOG2) * CACHE_STEPS)
+
+/* stored at the start of idle cache memory */
+typedef struct CacheBlock {
+    struct CacheBlock *prev, *next;         ///< in the bucket
+    struct CacheBlock *lru_prev, *lru_next; ///< over all buckets, newest first
+    int bucket;
+} CacheBlock;
+
+static AVMutex cache_lock = AV_MUTEX_INITIALIZER;
+static struct {
+    CacheBlock *buckets[CACHE_BUCKETS];
+    CacheBlock *lru_head, *lru_tail;
+    size_t limit;
+    AVBufferCacheStats stats;
+} cache;
+
+static int cache_bucket(int size)
+{
+    int b, step;
+
+    if (size <= 1 << CACHE_MIN_LOG2)
+        return -1;
+    b    = av_log2(size - 1);
+    step = 1 << (b - 3);
+    return (b - CACHE_MIN_LOG2) * CACHE_STEPS + (size + step - 1) / step - 9;
+}
+
+static size_t cache_bucket_size(int bucket)
+{
+    int b = bucket / CACHE_STEPS + CACHE_MIN_LOG2;
+
+    return (size_t)(bucket % CACHE_STEPS + 9) << (b - 3);
+}
+
+static void cache_unlink(CacheBlock *blk)
+{
+    if (blk->prev)
+        blk->prev->next = blk->next;
+    else
+        cache.buckets[blk->bucket] = blk->next;
+    if (blk->next)
+        blk->next->prev = blk->prev;
+
+    if (blk->lru_prev)
+        blk->lru_prev->lru_next = blk->lru_next;
+    else
+        cache.lru_head = blk->lru_next;
+    if (blk->lru_next)
+        blk->lru_next->lru_prev = blk->lru_prev;
+    else
+        cache.lru_tail = blk->lru_prev;
+
+    cache.stats.cached_bytes -= cache_bucket_size(blk->bucket);
+}
+
+/* unlink the oldest idle blocks over max_cached, to be freed after unlocking */
+static CacheBlock *cache_evict(size_t max_cached)
+{
+    CacheBlock *list = NULL;
+
+    while (cache.lru_tail && cache.stats.cached_bytes > max_cached) {
+        CacheBlock *blk = cache.lru_tail;
+        cache_unlink(blk);
+        blk->next = list;
+        list = blk;
+    }
+    return list;
+}
+
+static void cache_free_list(CacheBlock *list)
+{
+    while (list) {
+        CacheBlock *next = list->next;
+        av_free(list);
+        list = next;
+    }
+}
+
+static size_t cache_max_cached(void)
+{
+    size_t used = cache.stats.used_bytes;
+
+    return cache.limit > used ? cache.limit - used : 0;
+}
+
+static void cache_release(void *opaque, uint8_t *data)
+{
+    CacheBlock *blk = (CacheBlock *)data, *evicted;
+    int bucket = (intptr_t)opaque;
+    size_t size = cache_bucket_size(bucket);
+
+    ff_mutex_lock(&cache_lock);
+    cache.stats.used_bytes -= size;
+    if (cache_max_cached() < size) {
+        ff_mutex_unlock(&cache_lock);
+        av_free(data);
+        return;
+    }
+
+    blk->bucket   = bucket;
+    blk->prev     = NULL;
+    blk->next     = cache.buckets[bucket];
+    blk->lru_prev = NULL;
+    blk->lru_next = cache.lru_head;
+    if (blk->next)
+        blk->next->prev = blk;
+    cache.buckets[bucket] = blk;
+    if (cache.lru_head)
+        cache.lru_head->lru_prev = blk;
+    else
+        cache.lru_tail = blk;
+    cache.lru_head = blk;
+    cache.stats.cached_bytes += size;
+
+    evicted = cache_evict(cache_max_cached());
+    ff_mutex_unlock(&cache_lock);
+
+    cache_free_list(evicted);
+}
+
+AVBufferRef *av_buffer_cache_alloc(int size)
+{
+    int bucket = cache_bucket(size);
+    CacheBlock *blk = NULL, *evicted = NULL;
+    AVBufferRef *ret;
+    size_t alloc_size;
+
+    ff_mutex_lock(&cache_lock);
+    if (bucket < 0 || !cache.limit) {
+        ff_mutex_unlock(&cache_lock);
+        return av_buffer_allocz(size);
+    }
+    alloc_size = cache_bucket_size(bucket);
+    blk = cache.buckets[bucket];
+    if (blk) {
+        cache_unlink(blk);
+        cache.stats.hits++;
+    } else {
+        cache.stats.misses++;
+    }
+    cache.stats.used_bytes += alloc_size;
+    if (!blk)
+        evicted = cache_evict(cache_max_cached());
+    ff_mutex_unlock(&cache_lock);
+
+    cache_free_list(evicted);
+
+    if (!blk && !(blk = av_mallocz(alloc_size)))
+        goto fail;
+
+    ret = av_buffer_create((uint8_t *)blk, size, cache_release,
+                           (void *)(intptr_t)bucket, 0);
+    if (ret)
+        return ret;
+
+fail:
+    ff_mutex_lock(&cache_lock);
+    cache.stats.used_bytes -= alloc_size;
+    ff_mutex_unlock(&cache_lock);
+    av_free(blk);
+    return NULL;
+}
+
+void av_buffer_cache_set_limit(size_t max_bytes)
+{
+    CacheBlock *evicted;
+
+    ff_mutex_lock(&cache_lock);
+    cache.limit = max_bytes;
+    evicted = cache_evict(cache_max_cached());
+    ff_mutex_unlock(&cache_lock);
+
+    cache_free_list(evicted);
+}
+
+void av_buffer_cache_trim(size_t max_bytes)
+{
+    CacheBlock *evicted;
+
+    ff_mutex_lock(&cache_lock);
+    evicted = cache_evict(max_bytes);
+    ff_mutex_unlock(&cache_lock);
+
+    cache_free_list(evicted);
+}
+
+void av_buffer_cache_get_stats(AVBufferCacheStats *stats)
+{
+    ff_mutex_lock(&cache_lock);
+    *stats = cache.stats;
+    ff_mutex_unlock(&cache_lock);
+}
@@ -25,6 +25,7 @@
 #ifndef AVUTIL_BUFFER_H
 #define AVUTIL_BUFFER_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 /**
@@ -297,6 +298,63 @@ AVBufferRef *av_buffer_pool_get(AVBufferPool *pool);
  */
 void *av_buffer_pool_buffer_get_opaque(AVBufferRef *ref);
 
+/**
+ * @}
+ */
+
+/**
+ * @defgroup lavu_buffercache Buffer cache
+ * @ingroup lavu_data
+ *
+ * @{
+ * A process-wide cache of large buffers, meant to be used as the allocator
+ * of buffer pools for video frames. When a pool is freed, e.g. because the
+ * frame size changed or its decoder was closed, its memory goes back to the
+ * cache and is handed out to the next pool asking for a similar size,
+ * instead of being returned to the system.
+ *
+ * Sizes are rounded up to steps of 1/8 of a power of two. Memory is kept
+ * only while the cache buffers in use plus the idle ones stay under the
+ * limit; the least recently released idle buffers are freed first.
+ * The cache is disabled (limit 0) by default.
+ */
+
+typedef struct AVBufferCacheStats {
+    uint64_t hits;          ///< allocations served from idle memory
+    uint64_t misses;        ///< allocations which needed new memory
+    size_t   cached_bytes;  ///< idle memory held by the cache
+    size_t   used_bytes;    ///< memory of cache buffers currently in use
+} AVBufferCacheStats;
+
+/**
+ * Allocate a buffer from the process-wide cache. It can be passed as the
+ * alloc callback of av_buffer_pool_init().
+ *
+ * New memory is zeroed, the content of reused memory is unspecified.
+ * While the cache is disabled, or for small sizes, this is the same as
+ * av_buffer_allocz().
+ *
+ * @return a reference to the new buffer on success, NULL on error.
+ */
+AVBufferRef *av_buffer_cache_alloc(int size);
+
+/**
+ * Set the memory limit of the cache, and free idle memory over it.
+ * 0 disables the cache.
+ */
+void av_buffer_cache_set_limit(size_t max_bytes);
+
+/**
+ * Free idle memory of the cache, keeping at most max_bytes of it. To be
+ * called when the system runs low on memory.
+ */
+void av_buffer_cache_trim(size_t max_bytes);
+
+/**
+ * Get the statistics of the cache.
+ */
+void av_buffer_cache_get_stats(AVBufferCacheStats *stats);
+
 /**
  * @}
  */
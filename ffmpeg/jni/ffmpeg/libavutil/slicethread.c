@@ -20,6 +20,7 @@
 #include "slicethread.h"
 #include "mem.h"
 #include "thread.h"
+#include "threadpool_internal.h"
 #include "avassert.h"
 
 #if HAVE_PTHREADS || HAVE_W32THREADS || HAVE_OS2THREADS
@@ -32,6 +33,11 @@ typedef struct WorkerContext {
     int             done;
 } WorkerContext;
 
+typedef struct PoolTask {
+    AVThreadPoolTask task;
+    AVSliceThread    *ctx;
+} PoolTask;
+
 struct AVSliceThread {
     WorkerContext   *workers;
     int             nb_threads;
@@ -48,6 +54,11 @@ struct AVSliceThread {
     void            *priv;
     void            (*worker_func)(void *priv, int jobnr, int threadnr, int nb_jobs, int nb_threads);
     void            (*main_func)(void *priv);
+
+    /* set when running on the process-wide pool instead of own workers */
+    AVThreadPool    *pool;
+    PoolTask        *pool_tasks;
+    int             nb_pending;     ///< submitted tasks not finished yet, protected by done_mutex
 };
 
 static int run_jobs(AVSliceThread *ctx)
@@ -64,6 +75,55 @@ static int run_jobs(AVSliceThread *ctx)
     return current_job == nb_jobs + nb_active_threads - 1;
 }
 
+/* With the pool, participants pick their thread slot and all their jobs on
+ * arrival, since a task may start late or not at all when cancelled. */
+static void pool_run_jobs(AVSliceThread *ctx)
+{
+    unsigned nb_jobs  = ctx->nb_jobs;
+    unsigned threadnr = atomic_fetch_add_explicit(&ctx->first_job, 1, memory_order_acq_rel);
+    unsigned jobnr;
+
+    av_assert2(threadnr < ctx->nb_active_threads);
+    while ((jobnr = atomic_fetch_add_explicit(&ctx->current_job, 1, memory_order_acq_rel)) < nb_jobs)
+        ctx->worker_func(ctx->priv, jobnr, threadnr, nb_jobs, ctx->nb_active_threads);
+}
+
+static void pool_task_run(AVThreadPoolTask *t)
+{
+    AVSliceThread *ctx = ((PoolTask *)t)->ctx;
+
+    pool_run_jobs(ctx);
+
+    pthread_mutex_lock(&ctx->done_mutex);
+    if (!--ctx->nb_pending)
+        pthread_cond_signal(&ctx->done_cond);
+    pthread_mutex_unlock(&ctx->done_mutex);
+}
+
+static void pool_execute(AVSliceThread *ctx)
+{
+    int nb_tasks = ctx->nb_active_threads - 1;
+    int i, nb_cancelled = 0;
+
+    atomic_store_explicit(&ctx->first_job, 0, memory_order_relaxed);
+    atomic_store_explicit(&ctx->current_job, 0, memory_order_relaxed);
+    ctx->nb_pending = nb_tasks;
+    for (i = 0; i < nb_tasks; i++)
+        avpriv_threadpool_submit(ctx->pool, &ctx->pool_tasks[i].task);
+
+    pool_run_jobs(ctx);
+
+    /* all jobs are taken, do not wait for tasks the busy pool did not start */
+    for (i = 0; i < nb_tasks; i++)
+        nb_cancelled += avpriv_threadpool_cancel(ctx->pool, &ctx->pool_tasks[i].task);
+
+    pthread_mutex_lock(&ctx->done_mutex);
+    ctx->nb_pending -= nb_cancelled;
+    while (ctx->nb_pending)
+        pthread_cond_wait(&ctx->done_cond, &ctx->done_mutex);
+    pthread_mutex_unlock(&ctx->done_mutex);
+}
+
 static void *attribute_align_arg thread_worker(void *v)
 {
     WorkerContext *w = v;
@@ -108,14 +168,33 @@ int avpriv_slicethread_create(AVSliceThread **pctx, void *priv,
             nb_threads = 1;
     }
 
-    nb_workers = nb_threads;
-    if (!main_func)
-        nb_workers--;
-
     *pctx = ctx = av_mallocz(sizeof(*ctx));
     if (!ctx)
         return AVERROR(ENOMEM);
 
+    /* a main function may wait for the workers, which pool tasks cannot
+     * guarantee to start, so such contexts keep their own threads */
+    if (!main_func)
+        ctx->pool = avpriv_threadpool_ref();
+    if (ctx->pool) {
+        if (!(ctx->pool_tasks = av_calloc(nb_threads, sizeof(*ctx->pool_tasks)))) {
+            avpriv_threadpool_unref(&ctx->pool);
+            av_freep(pctx);
+            return AVERROR(ENOMEM);
+        }
+        for (i = 0; i < nb_threads; i++) {
+            ctx->pool_tasks[i].task.run = pool_task_run;
+            atomic_init(&ctx->pool_tasks[i].task.queue, -1);
+            ctx->pool_tasks[i].ctx = ctx;
+        }
+    }
+
+    nb_workers = nb_threads;
+    if (!main_func)
+        nb_workers--;
+    if (ctx->pool)
+        nb_workers = 0;
+
     if (nb_workers && !(ctx->workers = av_calloc(nb_workers, sizeof(*ctx->workers)))) {
         av_freep(pctx);
         return AVERROR(ENOMEM);
@@ -168,6 +247,10 @@ void avpriv_slicethread_execute(AVSliceThread *ctx, int nb_jobs, int execute_mai
     av_assert0(nb_jobs > 0);
     ctx->nb_jobs           = nb_jobs;
     ctx->nb_active_threads = FFMIN(nb_jobs, ctx->nb_threads);
+    if (ctx->pool) {
+        pool_execute(ctx);
+        return;
+    }
     atomic_store_explicit(&ctx->first_job, 0, memory_order_relaxed);
     atomic_store_explicit(&ctx->current_job, ctx->nb_active_threads, memory_order_relaxed);
     nb_workers             = ctx->nb_active_threads;
@@ -208,6 +291,8 @@ void avpriv_slicethread_free(AVSliceThread **pctx)
     nb_workers = ctx->nb_threads;
     if (!ctx->main_func)
         nb_workers--;
+    if (ctx->pool)
+        nb_workers = 0;
 
     ctx->finished = 1;
     for (i = 0; i < nb_workers; i++) {
@@ -227,6 +312,8 @@ void avpriv_slicethread_free(AVSliceThread **pctx)
 
     pthread_cond_destroy(&ctx->done_cond);
     pthread_mutex_destroy(&ctx->done_mutex);
+    avpriv_threadpool_unref(&ctx->pool);
+    av_freep(&ctx->pool_tasks);
     av_freep(&ctx->workers);
     av_freep(pctx);
 }
@@ -0,0 +1,105 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <stdio.h>
+
+#include "libavutil/buffer.h"
+
+#define CHECK(cond) do {                                            \
+    if (!(cond)) {                                                  \
+        fprintf(stderr, "line %d: %s failed\n", __LINE__, #cond);   \
+        return 1;                                                   \
+    }                                                               \
+} while (0)
+
+int main(void)
+{
+    AVBufferCacheStats st;
+    AVBufferPool *pool;
+    AVBufferRef *a, *b, *c;
+    int i;
+
+    /* disabled: plain zeroed allocations */
+    a = av_buffer_cache_alloc(1 << 20);
+    CHECK(a && a->size == 1 << 20 && !a->data[12345]);
+    av_buffer_unref(&a);
+    av_buffer_cache_get_stats(&st);
+    CHECK(!st.hits && !st.misses && !st.cached_bytes && !st.used_bytes);
+
+    av_buffer_cache_set_limit(8 << 20);
+
+    /* sizes in the same 1/8 octave step share memory */
+    a = av_buffer_cache_alloc(1000000);
+    CHECK(a && !a->data[999999]);
+    av_buffer_unref(&a);
+    av_buffer_cache_get_stats(&st);
+    CHECK(st.misses == 1 && st.cached_bytes == 1048576 && !st.used_bytes);
+    a = av_buffer_cache_alloc(1040000);
+    av_buffer_cache_get_stats(&st);
+    CHECK(a && st.hits == 1 && !st.cached_bytes && st.used_bytes == 1048576);
+    av_buffer_unref(&a);
+
+    /* pools return their memory when they are freed */
+    pool = av_buffer_pool_init(1048576, av_buffer_cache_alloc);
+    CHECK(pool);
+    a = av_buffer_pool_get(pool);
+    b = av_buffer_pool_get(pool);
+    CHECK(a && b);
+    av_buffer_cache_get_stats(&st);
+    CHECK(st.hits == 2 && st.misses == 2 && st.used_bytes == 2 << 20);
+    av_buffer_unref(&a);
+    av_buffer_unref(&b);
+    av_buffer_pool_uninit(&pool);
+    av_buffer_cache_get_stats(&st);
+    CHECK(st.cached_bytes == 2 << 20 && !st.used_bytes);
+
+    /* memory in use counts against the limit, oldest idle memory goes first */
+    a = av_buffer_cache_alloc(6 << 20);
+    av_buffer_cache_get_stats(&st);
+    CHECK(a && st.cached_bytes == 2 << 20 && st.used_bytes == 6 << 20);
+    c = av_buffer_cache_alloc(1 << 20);
+    av_buffer_cache_get_stats(&st);
+    CHECK(c && st.cached_bytes == 1 << 20);
+    av_buffer_unref(&c);
+    av_buffer_unref(&a);
+    av_buffer_cache_get_stats(&st);
+    CHECK(st.cached_bytes == 8 << 20 && !st.used_bytes);
+    a = av_buffer_cache_alloc(1536 << 10);
+    av_buffer_cache_get_stats(&st);
+    CHECK(a && st.misses == 4 && st.cached_bytes == 6 << 20);
+    av_buffer_unref(&a);
+
+    av_buffer_cache_trim(1 << 20);
+    av_buffer_cache_get_stats(&st);
+    CHECK(st.cached_bytes <= 1 << 20);
+
+    /* small buffers bypass the cache */
+    for (i = 0; i < 4; i++) {
+        a = av_buffer_cache_alloc(4096);
+        CHECK(a);
+        av_buffer_unref(&a);
+    }
+    av_buffer_cache_get_stats(&st);
+    CHECK(st.misses == 4);
+
+    av_buffer_cache_set_limit(0);
+    av_buffer_cache_get_stats(&st);
+    CHECK(!st.cached_bytes && !st.used_bytes);
+
+    return 0;
+}
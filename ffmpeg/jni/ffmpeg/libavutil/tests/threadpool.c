@@ -0,0 +1,134 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * Run several slice threading contexts from concurrent callers on the
+ * shared pool and check that every job runs exactly once and that no
+ * thread slot is used by two jobs at the same time.
+ * With an argument, time the executes with and without the pool.
+ */
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "libavutil/slicethread.h"
+#include "libavutil/thread.h"
+#include "libavutil/threadpool.h"
+#include "libavutil/time.h"
+
+#define NB_CALLERS   4
+#define NB_THREADS   3
+#define MAX_JOBS     32
+
+typedef struct Caller {
+    AVSliceThread *slicethread;
+    pthread_t     thread;
+    int           nb_executes;
+    atomic_int    job_count[MAX_JOBS];
+    atomic_int    slot_busy[NB_THREADS];
+    atomic_int    errors;
+} Caller;
+
+static void worker_func(void *priv, int jobnr, int threadnr, int nb_jobs, int nb_threads)
+{
+    Caller *c = priv;
+
+    if (jobnr >= nb_jobs || threadnr >= nb_threads || nb_threads > NB_THREADS ||
+        atomic_exchange(&c->slot_busy[threadnr], 1)) {
+        atomic_fetch_add(&c->errors, 1);
+        return;
+    }
+    atomic_fetch_add(&c->job_count[jobnr], 1);
+    atomic_store(&c->slot_busy[threadnr], 0);
+}
+
+static void *caller_main(void *arg)
+{
+    Caller *c = arg;
+    int i, j;
+
+    for (i = 0; i < c->nb_executes; i++) {
+        int nb_jobs = 1 + i % MAX_JOBS;
+
+        for (j = 0; j < MAX_JOBS; j++)
+            atomic_store(&c->job_count[j], 0);
+        avpriv_slicethread_execute(c->slicethread, nb_jobs, 0);
+        for (j = 0; j < MAX_JOBS; j++)
+            if (atomic_load(&c->job_count[j]) != (j < nb_jobs))
+                atomic_fetch_add(&c->errors, 1);
+    }
+    return NULL;
+}
+
+static int run(int nb_executes)
+{
+    Caller callers[NB_CALLERS] = { { 0 } };
+    int i, ret = 0;
+
+    for (i = 0; i < NB_CALLERS; i++) {
+        callers[i].nb_executes = nb_executes;
+        if (avpriv_slicethread_create(&callers[i].slicethread, &callers[i],
+                                      worker_func, NULL, NB_THREADS) < 0) {
+            fprintf(stderr, "avpriv_slicethread_create failed\n");
+            return -1;
+        }
+    }
+    for (i = 0; i < NB_CALLERS; i++)
+        if (pthread_create(&callers[i].thread, NULL, caller_main, &callers[i])) {
+            fprintf(stderr, "pthread_create failed\n");
+            exit(1);
+        }
+    for (i = 0; i < NB_CALLERS; i++) {
+        pthread_join(callers[i].thread, NULL);
+        if (atomic_load(&callers[i].errors)) {
+            fprintf(stderr, "caller %d: %d errors\n", i, atomic_load(&callers[i].errors));
+            ret = -1;
+        }
+        avpriv_slicethread_free(&callers[i].slicethread);
+    }
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    int nb_executes = argc > 1 ? atoi(argv[1]) : 2000;
+    int64_t t0, t1, t2;
+    int ret;
+
+    t0 = av_gettime_relative();
+    if (run(nb_executes) < 0)
+        return 1;
+    t1 = av_gettime_relative();
+
+    if ((ret = av_threadpool_init(NB_THREADS)) != NB_THREADS) {
+        fprintf(stderr, "av_threadpool_init returned %d\n", ret);
+        return 1;
+    }
+    ret = run(nb_executes);
+    av_threadpool_uninit();
+    if (ret < 0)
+        return 1;
+    t2 = av_gettime_relative();
+
+    if (argc > 1)
+        printf("private threads: %.2f us/execute, pool: %.2f us/execute\n",
+               (t1 - t0) / (double)(NB_CALLERS * nb_executes),
+               (t2 - t1) / (double)(NB_CALLERS * nb_executes));
+    return 0;
+}
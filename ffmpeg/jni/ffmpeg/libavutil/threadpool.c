@@ -0,0 +1,331 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <stdatomic.h>
+
+#include "avassert.h"
+#include "cpu.h"
+#include "error.h"
+#include "internal.h"
+#include "mem.h"
+#include "thread.h"
+#include "threadpool_internal.h"
+
+#if HAVE_PTHREADS || HAVE_W32THREADS || HAVE_OS2THREADS
+
+typedef struct TaskQueue {
+    pthread_mutex_t  mutex;
+    AVThreadPoolTask *head, *tail;
+} TaskQueue;
+
+typedef struct PoolWorker {
+    AVThreadPool *pool;
+    pthread_t    thread;
+    int          index;
+} PoolWorker;
+
+struct AVThreadPool {
+    PoolWorker      *workers;
+    TaskQueue       *queues;        ///< one per worker
+    int             nb_workers;
+
+    atomic_uint     next_queue;     ///< round robin position for submit
+    atomic_int      nb_queued;
+    atomic_int      refcount;
+
+    pthread_mutex_t mutex;          ///< protects nb_sleeping and finished
+    pthread_cond_t  cond;
+    int             nb_sleeping;
+    int             finished;
+};
+
+static AVMutex pool_lock = AV_MUTEX_INITIALIZER;
+static AVThreadPool *shared_pool;
+
+static void queue_unlink(TaskQueue *q, AVThreadPoolTask *task)
+{
+    if (task->prev)
+        task->prev->next = task->next;
+    else
+        q->head = task->next;
+    if (task->next)
+        task->next->prev = task->prev;
+    else
+        q->tail = task->prev;
+    task->prev = task->next = NULL;
+    atomic_store_explicit(&task->queue, -1, memory_order_release);
+}
+
+/* take the oldest task of the own queue, or steal one from another worker */
+static AVThreadPoolTask *get_task(AVThreadPool *pool, int self)
+{
+    int i;
+
+    for (i = 0; i < pool->nb_workers; i++) {
+        TaskQueue *q = &pool->queues[(self + i) % pool->nb_workers];
+        AVThreadPoolTask *task;
+
+        if (!atomic_load_explicit(&pool->nb_queued, memory_order_acquire))
+            return NULL;
+
+        pthread_mutex_lock(&q->mutex);
+        task = q->head;
+        if (task) {
+            queue_unlink(q, task);
+            atomic_fetch_sub_explicit(&pool->nb_queued, 1, memory_order_relaxed);
+        }
+        pthread_mutex_unlock(&q->mutex);
+        if (task)
+            return task;
+    }
+    return NULL;
+}
+
+static void *attribute_align_arg pool_worker(void *v)
+{
+    PoolWorker *w = v;
+    AVThreadPool *pool = w->pool;
+
+    while (1) {
+        AVThreadPoolTask *task = get_task(pool, w->index);
+
+        if (task) {
+            task->run(task);
+            continue;
+        }
+
+        pthread_mutex_lock(&pool->mutex);
+        while (!pool->finished && !atomic_load(&pool->nb_queued)) {
+            pool->nb_sleeping++;
+            pthread_cond_wait(&pool->cond, &pool->mutex);
+            pool->nb_sleeping--;
+        }
+        if (pool->finished) {
+            pthread_mutex_unlock(&pool->mutex);
+            return NULL;
+        }
+        pthread_mutex_unlock(&pool->mutex);
+    }
+}
+
+static void pool_free(AVThreadPool *pool, int nb_started)
+{
+    int i;
+
+    pthread_mutex_lock(&pool->mutex);
+    pool->finished = 1;
+    pthread_cond_broadcast(&pool->cond);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (i = 0; i < nb_started; i++)
+        pthread_join(pool->workers[i].thread, NULL);
+    for (i = 0; i < pool->nb_workers; i++)
+        pthread_mutex_destroy(&pool->queues[i].mutex);
+
+    pthread_cond_destroy(&pool->cond);
+    pthread_mutex_destroy(&pool->mutex);
+    av_freep(&pool->queues);
+    av_freep(&pool->workers);
+    av_free(pool);
+}
+
+static int pool_alloc(AVThreadPool **ppool, int nb_threads)
+{
+    AVThreadPool *pool;
+    int i, ret;
+
+    if (!(pool = av_mallocz(sizeof(*pool))))
+        return AVERROR(ENOMEM);
+    pool->workers = av_calloc(nb_threads, sizeof(*pool->workers));
+    pool->queues  = av_calloc(nb_threads, sizeof(*pool->queues));
+    if (!pool->workers || !pool->queues) {
+        av_freep(&pool->workers);
+        av_freep(&pool->queues);
+        av_free(pool);
+        return AVERROR(ENOMEM);
+    }
+
+    pool->nb_workers = nb_threads;
+    atomic_init(&pool->next_queue, 0);
+    atomic_init(&pool->nb_queued, 0);
+    atomic_init(&pool->refcount, 1);
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->cond, NULL);
+    for (i = 0; i < nb_threads; i++)
+        pthread_mutex_init(&pool->queues[i].mutex, NULL);
+
+    for (i = 0; i < nb_threads; i++) {
+        PoolWorker *w = &pool->workers[i];
+        w->pool  = pool;
+        w->index = i;
+        if (ret = pthread_create(&w->thread, NULL, pool_worker, w)) {
+            pool_free(pool, i);
+            return AVERROR(ret);
+        }
+    }
+
+    *ppool = pool;
+    return 0;
+}
+
+int av_threadpool_init(int nb_threads)
+{
+    int ret = 0;
+
+    av_assert0(nb_threads >= 0);
+    if (!nb_threads)
+        nb_threads = av_cpu_count();
+
+    ff_mutex_lock(&pool_lock);
+    if (!shared_pool)
+        ret = pool_alloc(&shared_pool, nb_threads);
+    if (!ret)
+        ret = shared_pool->nb_workers;
+    ff_mutex_unlock(&pool_lock);
+
+    return ret;
+}
+
+void av_threadpool_uninit(void)
+{
+    AVThreadPool *pool;
+
+    ff_mutex_lock(&pool_lock);
+    pool = shared_pool;
+    shared_pool = NULL;
+    ff_mutex_unlock(&pool_lock);
+
+    avpriv_threadpool_unref(&pool);
+}
+
+AVThreadPool *avpriv_threadpool_ref(void)
+{
+    AVThreadPool *pool;
+
+    ff_mutex_lock(&pool_lock);
+    pool = shared_pool;
+    if (pool)
+        atomic_fetch_add_explicit(&pool->refcount, 1, memory_order_relaxed);
+    ff_mutex_unlock(&pool_lock);
+
+    return pool;
+}
+
+void avpriv_threadpool_unref(AVThreadPool **ppool)
+{
+    AVThreadPool *pool = *ppool;
+
+    if (!pool)
+        return;
+    *ppool = NULL;
+    if (atomic_fetch_sub_explicit(&pool->refcount, 1, memory_order_acq_rel) == 1) {
+        av_assert0(!atomic_load(&pool->nb_queued));
+        pool_free(pool, pool->nb_workers);
+    }
+}
+
+int avpriv_threadpool_nb_threads(const AVThreadPool *pool)
+{
+    return pool->nb_workers;
+}
+
+void avpriv_threadpool_submit(AVThreadPool *pool, AVThreadPoolTask *task)
+{
+    unsigned idx = atomic_fetch_add_explicit(&pool->next_queue, 1, memory_order_relaxed) % pool->nb_workers;
+    TaskQueue *q = &pool->queues[idx];
+
+    pthread_mutex_lock(&q->mutex);
+    task->next = NULL;
+    task->prev = q->tail;
+    if (q->tail)
+        q->tail->next = task;
+    else
+        q->head = task;
+    q->tail = task;
+    atomic_store_explicit(&task->queue, idx, memory_order_relaxed);
+    atomic_fetch_add_explicit(&pool->nb_queued, 1, memory_order_release);
+    pthread_mutex_unlock(&q->mutex);
+
+    /* nb_queued is raised before checking for sleepers, and workers check it
+     * again under the same mutex before sleeping, so no wakeup is lost */
+    pthread_mutex_lock(&pool->mutex);
+    if (pool->nb_sleeping)
+        pthread_cond_signal(&pool->cond);
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+int avpriv_threadpool_cancel(AVThreadPool *pool, AVThreadPoolTask *task)
+{
+    int idx, removed = 0;
+
+    /* tasks never move between queues, so this is retried at most once */
+    while ((idx = atomic_load_explicit(&task->queue, memory_order_acquire)) >= 0) {
+        TaskQueue *q = &pool->queues[idx];
+
+        pthread_mutex_lock(&q->mutex);
+        if (atomic_load_explicit(&task->queue, memory_order_relaxed) == idx) {
+            queue_unlink(q, task);
+            atomic_fetch_sub_explicit(&pool->nb_queued, 1, memory_order_relaxed);
+            removed = 1;
+        }
+        pthread_mutex_unlock(&q->mutex);
+        if (removed)
+            break;
+    }
+    return removed;
+}
+
+#else /* HAVE_PTHREADS || HAVE_W32THREADS || HAVE_OS2THREADS */
+
+int av_threadpool_init(int nb_threads)
+{
+    return AVERROR(ENOSYS);
+}
+
+void av_threadpool_uninit(void)
+{
+}
+
+AVThreadPool *avpriv_threadpool_ref(void)
+{
+    return NULL;
+}
+
+void avpriv_threadpool_unref(AVThreadPool **pool)
+{
+    av_assert0(!pool || !*pool);
+}
+
+int avpriv_threadpool_nb_threads(const AVThreadPool *pool)
+{
+    av_assert0(0);
+    return 0;
+}
+
+void avpriv_threadpool_submit(AVThreadPool *pool, AVThreadPoolTask *task)
+{
+    av_assert0(0);
+}
+
+int avpriv_threadpool_cancel(AVThreadPool *pool, AVThreadPoolTask *task)
+{
+    av_assert0(0);
+    return 0;
+}
+
+#endif /* HAVE_PTHREADS || HAVE_W32THREADS || HAVE_OS2THREADS */
@@ -0,0 +1,47 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef AVUTIL_THREADPOOL_H
+#define AVUTIL_THREADPOOL_H
+
+/**
+ * @file
+ * Process-wide worker thread pool.
+ *
+ * By default every codec and filter graph starts its own slice threads.
+ * While the shared pool is enabled, slice threading contexts created from
+ * then on run their jobs on the pool workers instead, each one still
+ * limited to the number of threads it was created with.
+ */
+
+/**
+ * Enable the process-wide thread pool.
+ *
+ * @param nb_threads number of worker threads, 0 for the number of CPUs
+ * @return the number of worker threads of the pool (also when it was already
+ *         enabled) or a negative AVERROR code on failure
+ */
+int av_threadpool_init(int nb_threads);
+
+/**
+ * Disable the process-wide thread pool for contexts created afterwards.
+ * Its workers exit once the last context using them has been freed.
+ */
+void av_threadpool_uninit(void);
+
+#endif /* AVUTIL_THREADPOOL_H */
@@ -0,0 +1,72 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef AVUTIL_THREADPOOL_INTERNAL_H
+#define AVUTIL_THREADPOOL_INTERNAL_H
+
+#include <stdatomic.h>
+
+#include "threadpool.h"
+
+typedef struct AVThreadPool AVThreadPool;
+
+/**
+ * A unit of work for the pool. It is usually embedded in a larger structure
+ * of the caller, which run() can get back to.
+ * Tasks must not block waiting for tasks which have not started yet.
+ */
+typedef struct AVThreadPoolTask {
+    void (*run)(struct AVThreadPoolTask *task);
+
+    /* owned by the pool */
+    struct AVThreadPoolTask *prev, *next;
+    atomic_int queue;
+} AVThreadPoolTask;
+
+/**
+ * Get a reference to the process-wide pool.
+ * @return the pool, or NULL if it is not enabled
+ */
+AVThreadPool *avpriv_threadpool_ref(void);
+
+/**
+ * Release a reference obtained with avpriv_threadpool_ref(). Must not be
+ * called from a pool worker.
+ */
+void avpriv_threadpool_unref(AVThreadPool **pool);
+
+/**
+ * @return the number of worker threads of the pool
+ */
+int avpriv_threadpool_nb_threads(const AVThreadPool *pool);
+
+/**
+ * Queue a task. Tasks are spread over the per-worker queues, and idle
+ * workers steal from the queues of the others.
+ * The task must stay valid until it has run or has been cancelled.
+ */
+void avpriv_threadpool_submit(AVThreadPool *pool, AVThreadPoolTask *task);
+
+/**
+ * Remove a task which has not been picked up by a worker yet.
+ * @return 1 if the task was removed and will not run, 0 if it has already
+ *         started (or finished)
+ */
+int avpriv_threadpool_cancel(AVThreadPool *pool, AVThreadPoolTask *task);
+
+#endif /* AVUTIL_THREADPOOL_INTERNAL_H */
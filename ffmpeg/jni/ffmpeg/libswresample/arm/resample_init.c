@@ -94,12 +94,69 @@ static int ff_resample_common_##TYPE##_neon(ResampleContext *c, void *dest, cons
     return sample_index;                                                                          \
 }                                                                                                 \
 
+#define DECLARE_RESAMPLE_BLOCK_TEMPLATE(TYPE, DELEM, FELEM, FELEM2, OUT)                          \
+                                                                                                  \
+void ff_resample_block_apply_filter_##TYPE##_neon(FELEM2 *acc, const DELEM *src,                  \
+                                                  const FELEM *filter, int length);               \
+                                                                                                  \
+static int ff_resample_block_##TYPE##_neon(ResampleContext *c, void *dest, const void *source,    \
+                                           int n, int update_ctx)                                 \
+{                                                                                                 \
+    const ResamplePhaseTable *t = c->phase_table;                                                 \
+    DELEM *dst = dest;                                                                            \
+    const DELEM *src = source;                                                                    \
+    int dst_index = 0;                                                                            \
+    int index = c->index;                                                                         \
+    int sample_index = 0;                                                                         \
+    int pos, j;                                                                                   \
+                                                                                                  \
+    while (index >= c->phase_count) {                                                             \
+        sample_index++;                                                                           \
+        index -= c->phase_count;                                                                  \
+    }                                                                                             \
+    pos = t->position[index];                                                                     \
+                                                                                                  \
+    while (dst_index < n) {                                                                       \
+        const FELEM *filter = (const FELEM *)t->coeffs + pos * t->taps * RESAMPLE_BLOCK_SIZE;     \
+        FELEM2 val[RESAMPLE_BLOCK_SIZE];                                                          \
+                                                                                                  \
+        if (dst_index + RESAMPLE_BLOCK_SIZE <= n) {                                               \
+            ff_resample_block_apply_filter_##TYPE##_neon(val, &src[sample_index],                 \
+                                                         filter, t->block_taps[pos]);             \
+            for (j = 0; j < RESAMPLE_BLOCK_SIZE; j++) {                                           \
+                OUT(dst[dst_index + j], val[j]);                                                  \
+            }                                                                                     \
+            sample_index += t->block_incr[pos];                                                   \
+            dst_index    += RESAMPLE_BLOCK_SIZE;                                                  \
+            pos          += RESAMPLE_BLOCK_SIZE;                                                  \
+            while (pos >= t->period)                                                              \
+                pos -= t->period;                                                                 \
+        } else {                                                                                  \
+            /* only the first lane, over the taps of its own filter */                            \
+            ff_resample_block_apply_filter_##TYPE##_neon(val, &src[sample_index],                 \
+                                                         filter, c->filter_length);               \
+            OUT(dst[dst_index], val[0]);                                                          \
+            sample_index += t->incr[pos];                                                         \
+            dst_index++;                                                                          \
+            if (++pos == t->period)                                                               \
+                pos = 0;                                                                          \
+        }                                                                                         \
+    }                                                                                             \
+                                                                                                  \
+    if (update_ctx)                                                                               \
+        c->index = t->phase[pos];                                                                 \
+                                                                                                  \
+    return sample_index;                                                                          \
+}                                                                                                 \
+
 #define OUT(d, v) d = v
 DECLARE_RESAMPLE_COMMON_TEMPLATE(float, float, float, float, OUT)
+DECLARE_RESAMPLE_BLOCK_TEMPLATE(float, float, float, float, OUT)
 #undef OUT
 
 #define OUT(d, v) (v) = ((v) + (1<<(14)))>>15; (d) = av_clip_int16(v)
 DECLARE_RESAMPLE_COMMON_TEMPLATE(s16, int16_t, int16_t, int32_t, OUT)
+DECLARE_RESAMPLE_BLOCK_TEMPLATE(s16, int16_t, int16_t, int32_t, OUT)
 #undef OUT
 
 av_cold void swri_resample_dsp_arm_init(ResampleContext *c)
@@ -112,9 +169,11 @@ av_cold void swri_resample_dsp_arm_init(ResampleContext *c)
     switch(c->format) {
     case AV_SAMPLE_FMT_FLTP:
         c->dsp.resample_common = ff_resample_common_float_neon;
+        c->dsp.resample_block  = ff_resample_block_float_neon;
         break;
     case AV_SAMPLE_FMT_S16P:
         c->dsp.resample_common = ff_resample_common_s16_neon;
+        c->dsp.resample_block  = ff_resample_block_s16_neon;
         break;
     }
 }
@@ -483,6 +483,8 @@ av_cold int swri_rematrix_init(SwrContext *s){
 
     if(HAVE_X86ASM && HAVE_MMX)
         return swri_rematrix_init_x86(s);
+    if(ARCH_AARCH64)
+        return swri_rematrix_init_aarch64(s);
 
     return 0;
 }
@@ -27,8 +27,37 @@
  */
 
 #include "libavutil/avassert.h"
+#include "libavutil/thread.h"
 #include "resample.h"
 
+/* number of filter banks kept for reuse once no context uses them */
+#define FILTER_CACHE_UNUSED 8
+
+/* larger phase tables are not built, the filter bank is used directly */
+#define PHASE_TABLE_MAX_SIZE (256 * 1024)
+
+/**
+ * A filter bank shared by all contexts with the same filter parameters and
+ * resampling ratio, with its phase table if the ratio allows one.
+ */
+typedef struct ResampleFilterCache {
+    struct ResampleFilterCache *next;
+    enum AVSampleFormat format;
+    enum SwrFilterType filter_type;
+    double kaiser_beta;
+    double factor;
+    int filter_length;
+    int phase_count;
+    int src_incr;
+    int dst_incr;
+    int refcount;
+    uint8_t *filter_bank;
+    ResamplePhaseTable phase_table;
+} ResampleFilterCache;
+
+static AVMutex filter_cache_mutex = AV_MUTEX_INITIALIZER;
+static ResampleFilterCache *filter_cache;  ///< most recently used first
+
 static inline double eval_poly(const double *coeff, int size, double x) {
     double sum = coeff[size-1];
     int i;
@@ -276,11 +305,186 @@ fail:
     return ret;
 }
 
+static void free_phase_table(ResamplePhaseTable *t)
+{
+    av_freep(&t->coeffs);
+    av_freep(&t->block_taps);
+    av_freep(&t->block_incr);
+    av_freep(&t->incr);
+    av_freep(&t->phase);
+    av_freep(&t->position);
+}
+
+/**
+ * Lay out the filter bank for resample_block().
+ * The phase advances by incr phases per output sample.  The table is not
+ * built, and 0 is returned, if it would be too large.
+ * @return 0 on success, negative on error
+ */
+static int build_phase_table(ResamplePhaseTable *t, const uint8_t *filter_bank, int felem_size,
+                             int filter_length, int filter_alloc, int phase_count, int incr)
+{
+    int period = phase_count / av_gcd(incr, phase_count);
+    int taps   = filter_length + ((phase_count - 1) + (RESAMPLE_BLOCK_SIZE - 1) * (int64_t)incr) / phase_count;
+    int64_t size = (int64_t)period * taps * RESAMPLE_BLOCK_SIZE * felem_size;
+    int p, i, j;
+
+    if (size + phase_count * (int64_t)sizeof(int) > PHASE_TABLE_MAX_SIZE)
+        return 0;
+
+    t->period     = period;
+    t->taps       = taps;
+    t->coeffs     = av_mallocz(size);
+    t->block_taps = av_malloc_array(period, sizeof(*t->block_taps));
+    t->block_incr = av_malloc_array(period, sizeof(*t->block_incr));
+    t->incr       = av_malloc_array(period, sizeof(*t->incr));
+    t->phase      = av_malloc_array(period, sizeof(*t->phase));
+    t->position   = av_malloc_array(phase_count, sizeof(*t->position));
+    if (!t->coeffs || !t->block_taps || !t->block_incr || !t->incr || !t->phase || !t->position) {
+        free_phase_table(t);
+        return AVERROR(ENOMEM);
+    }
+
+    for (i = 0; i < phase_count; i++)
+        t->position[i] = -1;
+
+    for (p = 0; p < period; p++) {
+        int phase = p * (int64_t)incr % phase_count;
+
+        t->phase[p]        = phase;
+        t->position[phase] = p;
+        t->incr[p]         = (phase + (int64_t)incr) / phase_count;
+        t->block_incr[p]   = (phase + (int64_t)incr * RESAMPLE_BLOCK_SIZE) / phase_count;
+        t->block_taps[p]   = filter_length + (phase + (int64_t)incr * (RESAMPLE_BLOCK_SIZE - 1)) / phase_count;
+
+        /* lane j is output sample p + j, its filter starts at its own
+         * input sample, offset from the first one of the block */
+        for (j = 0; j < RESAMPLE_BLOCK_SIZE; j++) {
+            int64_t pos = phase + (int64_t)incr * j;
+            int ph      = pos % phase_count;
+            int offset  = pos / phase_count;
+
+            for (i = 0; i < filter_length; i++)
+                memcpy(t->coeffs + (((int64_t)p * taps + offset + i) * RESAMPLE_BLOCK_SIZE + j) * felem_size,
+                       filter_bank + ((int64_t)ph * filter_alloc + i) * felem_size, felem_size);
+        }
+    }
+
+    return 0;
+}
+
+static void filter_cache_free(ResampleFilterCache *e)
+{
+    av_freep(&e->filter_bank);
+    free_phase_table(&e->phase_table);
+    av_free(e);
+}
+
+static ResampleFilterCache *filter_cache_build(ResampleContext *c, int phase_count,
+                                               int src_incr, int dst_incr)
+{
+    ResampleFilterCache *e = av_mallocz(sizeof(*e));
+
+    if (!e)
+        return NULL;
+
+    e->format        = c->format;
+    e->filter_type   = c->filter_type;
+    e->kaiser_beta   = c->kaiser_beta;
+    e->factor        = c->factor;
+    e->filter_length = c->filter_length;
+    e->phase_count   = phase_count;
+    e->src_incr      = src_incr;
+    e->dst_incr      = dst_incr;
+
+    e->filter_bank = av_calloc(c->filter_alloc, (phase_count+1)*c->felem_size);
+    if (!e->filter_bank)
+        goto fail;
+    if (build_filter(c, e->filter_bank, c->factor, c->filter_length, c->filter_alloc,
+                     phase_count, 1<<c->filter_shift, c->filter_type, c->kaiser_beta))
+        goto fail;
+    memcpy(e->filter_bank + (c->filter_alloc*phase_count+1)*c->felem_size, e->filter_bank, (c->filter_alloc-1)*c->felem_size);
+    memcpy(e->filter_bank + (c->filter_alloc*phase_count  )*c->felem_size, e->filter_bank + (c->filter_alloc - 1)*c->felem_size, c->felem_size);
+
+    /* resample_one() handles the remaining case without a filter */
+    if (!(dst_incr % src_incr) && (c->filter_length > 1 || phase_count > 1) &&
+        build_phase_table(&e->phase_table, e->filter_bank, c->felem_size, c->filter_length,
+                          c->filter_alloc, phase_count, dst_incr / src_incr) < 0)
+        goto fail;
+
+    return e;
+fail:
+    filter_cache_free(e);
+    return NULL;
+}
+
+static void filter_cache_release(ResampleFilterCache **pe)
+{
+    ResampleFilterCache *e, **prev;
+    int unused = 0;
+
+    if (!*pe)
+        return;
+
+    ff_mutex_lock(&filter_cache_mutex);
+    (*pe)->refcount--;
+    /* drop the least recently used filter banks nobody uses */
+    for (prev = &filter_cache; (e = *prev); ) {
+        if (!e->refcount && ++unused > FILTER_CACHE_UNUSED) {
+            *prev = e->next;
+            filter_cache_free(e);
+        } else
+            prev = &e->next;
+    }
+    ff_mutex_unlock(&filter_cache_mutex);
+    *pe = NULL;
+}
+
+/**
+ * Get a reference to the filter bank for the filter parameters of c with
+ * phase_count phases and the given increments, building it if it is not in
+ * the cache, and make it the filter bank of c.
+ * @return 0 on success, negative on error
+ */
+static int filter_cache_get(ResampleContext *c, int phase_count, int src_incr, int dst_incr)
+{
+    ResampleFilterCache *e, **prev;
+
+    ff_mutex_lock(&filter_cache_mutex);
+    for (prev = &filter_cache; (e = *prev); prev = &e->next) {
+        if (e->format        == c->format        &&
+            e->filter_type   == c->filter_type   &&
+            e->kaiser_beta   == c->kaiser_beta   &&
+            e->factor        == c->factor        &&
+            e->filter_length == c->filter_length &&
+            e->phase_count   == phase_count      &&
+            e->src_incr      == src_incr         &&
+            e->dst_incr      == dst_incr) {
+            *prev = e->next;
+            break;
+        }
+    }
+    if (!e && !(e = filter_cache_build(c, phase_count, src_incr, dst_incr))) {
+        ff_mutex_unlock(&filter_cache_mutex);
+        return AVERROR(ENOMEM);
+    }
+    e->next = filter_cache;
+    filter_cache = e;
+    e->refcount++;
+    ff_mutex_unlock(&filter_cache_mutex);
+
+    filter_cache_release(&c->cache);
+    c->cache       = e;
+    c->filter_bank = e->filter_bank;
+    c->phase_table = e->phase_table.coeffs ? &e->phase_table : NULL;
+    return 0;
+}
+
 static void resample_free(ResampleContext **cc){
     ResampleContext *c = *cc;
     if(!c)
         return;
-    av_freep(&c->filter_bank);
+    filter_cache_release(&c->cache);
     av_freep(cc);
 }
 
@@ -345,16 +549,9 @@ static ResampleContext *resample_init(ResampleContext *c, int out_rate, int in_r
         c->factor        = factor;
         c->filter_length = filter_length;
         c->filter_alloc  = FFALIGN(c->filter_length, 8);
-        c->filter_bank   = av_calloc(c->filter_alloc, (phase_count+1)*c->felem_size);
         c->filter_type   = filter_type;
         c->kaiser_beta   = kaiser_beta;
         c->phase_count_compensation = phase_count_compensation;
-        if (!c->filter_bank)
-            goto error;
-        if (build_filter(c, (void*)c->filter_bank, factor, c->filter_length, c->filter_alloc, phase_count, 1<<c->filter_shift, filter_type, kaiser_beta))
-            goto error;
-        memcpy(c->filter_bank + (c->filter_alloc*phase_count+1)*c->felem_size, c->filter_bank, (c->filter_alloc-1)*c->felem_size);
-        memcpy(c->filter_bank + (c->filter_alloc*phase_count  )*c->felem_size, c->filter_bank + (c->filter_alloc - 1)*c->felem_size, c->felem_size);
     }
 
     c->compensation_distance= 0;
@@ -371,18 +568,24 @@ static ResampleContext *resample_init(ResampleContext *c, int out_rate, int in_r
     c->index= -phase_count*((c->filter_length-1)/2);
     c->frac= 0;
 
+    /* the filter bank only depends on the ratio through factor, but the
+     * phase table built with it depends on the increments */
+    if (!c->cache || c->cache->phase_count != c->phase_count ||
+        c->cache->src_incr != c->src_incr || c->cache->dst_incr != c->dst_incr) {
+        if (filter_cache_get(c, c->phase_count, c->src_incr, c->dst_incr) < 0)
+            goto error;
+    }
+
     swri_resample_dsp_init(c);
 
     return c;
 error:
-    av_freep(&c->filter_bank);
-    av_free(c);
+    resample_free(&c);
     return NULL;
 }
 
 static int rebuild_filter_bank_with_compensation(ResampleContext *c)
 {
-    uint8_t *new_filter_bank;
     int new_src_incr, new_dst_incr;
     int phase_count = c->phase_count_compensation;
     int ret;
@@ -392,39 +595,26 @@ static int rebuild_filter_bank_with_compensation(ResampleContext *c)
 
     av_assert0(!c->frac && !c->dst_incr_mod);
 
-    new_filter_bank = av_calloc(c->filter_alloc, (phase_count + 1) * c->felem_size);
-    if (!new_filter_bank)
-        return AVERROR(ENOMEM);
-
-    ret = build_filter(c, new_filter_bank, c->factor, c->filter_length, c->filter_alloc,
-                       phase_count, 1 << c->filter_shift, c->filter_type, c->kaiser_beta);
-    if (ret < 0) {
-        av_freep(&new_filter_bank);
-        return ret;
-    }
-    memcpy(new_filter_bank + (c->filter_alloc*phase_count+1)*c->felem_size, new_filter_bank, (c->filter_alloc-1)*c->felem_size);
-    memcpy(new_filter_bank + (c->filter_alloc*phase_count  )*c->felem_size, new_filter_bank + (c->filter_alloc - 1)*c->felem_size, c->felem_size);
-
     if (!av_reduce(&new_src_incr, &new_dst_incr, c->src_incr,
                    c->dst_incr * (int64_t)(phase_count/c->phase_count), INT32_MAX/2))
-    {
-        av_freep(&new_filter_bank);
         return AVERROR(EINVAL);
+
+    while (new_dst_incr < (1<<20) && new_src_incr < (1<<20)) {
+        new_dst_incr *= 2;
+        new_src_incr *= 2;
     }
 
+    ret = filter_cache_get(c, phase_count, new_src_incr, new_dst_incr);
+    if (ret < 0)
+        return ret;
+
     c->src_incr = new_src_incr;
     c->dst_incr = new_dst_incr;
-    while (c->dst_incr < (1<<20) && c->src_incr < (1<<20)) {
-        c->dst_incr *= 2;
-        c->src_incr *= 2;
-    }
     c->ideal_dst_incr = c->dst_incr;
     c->dst_incr_div   = c->dst_incr / c->src_incr;
     c->dst_incr_mod   = c->dst_incr % c->src_incr;
     c->index         *= phase_count / c->phase_count;
     c->phase_count    = phase_count;
-    av_freep(&c->filter_bank);
-    c->filter_bank = new_filter_bank;
     return 0;
 }
 
@@ -494,6 +684,12 @@ static int multiple_resample(ResampleContext *c, AudioData *dst, int dst_size, A
              * when frac and dst_incr_mod are zero */
             resample_func = (c->linear && (c->frac || c->dst_incr_mod)) ?
                             c->dsp.resample_linear : c->dsp.resample_common;
+            /* the phase table is only valid at the ratio it was built for,
+             * not while compensating */
+            if (c->dsp.resample_block && c->phase_table &&
+                !c->frac && c->dst_incr == c->ideal_dst_incr &&
+                c->phase_table->position[c->index % c->phase_count] >= 0)
+                resample_func = c->dsp.resample_block;
             for (i = 0; i < dst->ch_count; i++)
                 *consumed = resample_func(c, dst->ch[i], src->ch[i], dst_size, i+1 == dst->ch_count);
         }
@@ -27,6 +27,30 @@
 
 #include "swresample_internal.h"
 
+/**
+ * Number of output samples resample_block() computes at once, one per lane.
+ * The NEON versions are written for 8 lanes.
+ */
+#define RESAMPLE_BLOCK_SIZE 8
+
+/**
+ * Filter coefficients laid out for resample_block(), built for one
+ * resampling ratio when the phase advances by a whole number of phases per
+ * output sample.  The phases then repeat after period output samples.
+ */
+typedef struct ResamplePhaseTable {
+    int period;         ///< number of output samples after which the phases repeat
+    int taps;           ///< stride of the coefficients of one position, in lane groups
+    uint8_t *coeffs;    ///< for each position, taps groups of RESAMPLE_BLOCK_SIZE lane coefficients
+    int *block_taps;    ///< input samples used by the block starting at each position
+    int *block_incr;    ///< input samples consumed by the block starting at each position
+    int *incr;          ///< input samples consumed by the output sample at each position
+    int *phase;         ///< filter phase of each position
+    int *position;      ///< position of each phase, -1 if the phase is never used
+} ResamplePhaseTable;
+
+struct ResampleFilterCache;
+
 typedef struct ResampleContext {
     const AVClass *av_class;
     uint8_t *filter_bank;
@@ -49,6 +73,8 @@ typedef struct ResampleContext {
     int felem_size;
     int filter_shift;
     int phase_count_compensation;      /* desired phase_count when compensation is enabled */
+    struct ResampleFilterCache *cache; /* shared entry filter_bank and phase_table belong to */
+    const ResamplePhaseTable *phase_table;
 
     struct {
         void (*resample_one)(void *dst, const void *src,
@@ -57,6 +83,8 @@ typedef struct ResampleContext {
                                const void *src, int n, int update_ctx);
         int (*resample_linear)(struct ResampleContext *c, void *dst,
                                const void *src, int n, int update_ctx);
+        int (*resample_block)(struct ResampleContext *c, void *dst,
+                              const void *src, int n, int update_ctx);
     } dsp;
 } ResampleContext;
 
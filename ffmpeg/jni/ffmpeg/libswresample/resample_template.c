@@ -200,6 +200,68 @@ static int RENAME(resample_linear)(ResampleContext *c,
     return sample_index;
 }
 
+/* RESAMPLE_BLOCK_SIZE output samples at a time, one per lane, through the
+ * phase table.  The phase and input position of each output sample are in
+ * the table, the coefficients of a block are aligned on its first input
+ * sample so that all lanes multiply the same input sample. */
+static int RENAME(resample_block)(ResampleContext *c,
+                                  void *dest, const void *source,
+                                  int n, int update_ctx)
+{
+    const ResamplePhaseTable *t = c->phase_table;
+    DELEM *dst = dest;
+    const DELEM *src = source;
+    int dst_index;
+    int index= c->index;
+    int sample_index = 0;
+    int pos, i, j;
+
+    while (index >= c->phase_count) {
+        sample_index++;
+        index -= c->phase_count;
+    }
+    pos = t->position[index];
+
+    for (dst_index = 0; dst_index + RESAMPLE_BLOCK_SIZE <= n; dst_index += RESAMPLE_BLOCK_SIZE) {
+        const FELEM *filter = (const FELEM *)t->coeffs + pos * t->taps * RESAMPLE_BLOCK_SIZE;
+        const DELEM *in = src + sample_index;
+        FELEM2 val[RESAMPLE_BLOCK_SIZE];
+
+        for (j = 0; j < RESAMPLE_BLOCK_SIZE; j++)
+            val[j] = FOFFSET;
+        for (i = 0; i < t->block_taps[pos]; i++) {
+            for (j = 0; j < RESAMPLE_BLOCK_SIZE; j++)
+                val[j] += in[i] * (FELEM2)filter[i * RESAMPLE_BLOCK_SIZE + j];
+        }
+        for (j = 0; j < RESAMPLE_BLOCK_SIZE; j++)
+            OUT(dst[dst_index + j], val[j]);
+
+        sample_index += t->block_incr[pos];
+        pos += RESAMPLE_BLOCK_SIZE;
+        while (pos >= t->period)
+            pos -= t->period;
+    }
+
+    /* the first lane of a block holds the plain filter of its position */
+    for (; dst_index < n; dst_index++) {
+        const FELEM *filter = (const FELEM *)t->coeffs + pos * t->taps * RESAMPLE_BLOCK_SIZE;
+        FELEM2 val = FOFFSET;
+
+        for (i = 0; i < c->filter_length; i++)
+            val += src[sample_index + i] * (FELEM2)filter[i * RESAMPLE_BLOCK_SIZE];
+        OUT(dst[dst_index], val);
+
+        sample_index += t->incr[pos];
+        if (++pos == t->period)
+            pos = 0;
+    }
+
+    if(update_ctx)
+        c->index = t->phase[pos];
+
+    return sample_index;
+}
+
 #undef RENAME
 #undef FILTER_SHIFT
 #undef DELEM
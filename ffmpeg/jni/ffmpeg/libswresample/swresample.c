@@ -132,6 +132,7 @@ static void clear_context(SwrContext *s){
 
     s->delayed_samples_fixup = 0;
     s->flushed = 0;
+    s->fused_block = 0;
 }
 
 av_cold void swr_free(SwrContext **ss){
@@ -290,6 +291,7 @@ av_cold int swr_init(struct SwrContext *s){
     }
 
 #define RSC 1 //FIXME finetune
+#define FUSED_BLOCK_BYTES 16384 ///< working set of one block of the fused conversion, well within L1
     if(!s-> in.ch_count)
         s-> in.ch_count= av_get_channel_layout_nb_channels(s-> in_ch_layout);
     if(!s->used_ch_count)
@@ -390,6 +392,13 @@ av_assert0(s->out.ch_count);
             goto fail;
     }
 
+    if (s->fused && s->resample && s->rematrix && !s->dither.method &&
+        s->resampler == &swri_resampler &&
+        !(s->int_sample_fmt == s->out_sample_fmt && s->out.planar)) {
+        int bytes = av_get_bytes_per_sample(s->int_sample_fmt) * (s->used_ch_count + s->out.ch_count);
+        s->fused_block = FFMAX(FUSED_BLOCK_BYTES / bytes & ~15, 16);
+    }
+
     return 0;
 fail:
     swr_close(s);
@@ -579,6 +588,70 @@ static int resample(SwrContext *s, AudioData *out_param, int out_count,
     return ret_sum;
 }
 
+/**
+ * Convert in blocks of s->fused_block input samples, each block is
+ * converted to the internal format, rematrixed, resampled and converted
+ * to the output format before the next one is read, so that the
+ * intermediate buffers stay in the cache.
+ * The output is the same as the one of the unblocked conversion.
+ *
+ * @return number of samples output per channel
+ */
+static int swr_convert_fused(struct SwrContext *s, AudioData *out, int out_count,
+                                                   AudioData *in , int  in_count){
+    AudioData in_blk = *in, out_blk = *out;
+    AudioData midbuf, preout;
+    int block = s->fused_block;
+    int max_block_out = av_rescale_rnd(block, s->out_sample_rate, s->in_sample_rate, AV_ROUND_UP) + 16;
+    int convert_in = s->int_sample_fmt != s->in_sample_fmt || !s->in.planar || s->channel_map;
+    int n, max_out, ret, out_done = 0;
+
+    if(convert_in && (ret=swri_realloc_audio(&s->postin, block))<0)
+        return ret;
+    if((ret=swri_realloc_audio(&s->midbuf, s->resample_first ? max_block_out : block))<0)
+        return ret;
+    if((ret=swri_realloc_audio(&s->preout, max_block_out))<0)
+        return ret;
+
+    do{
+        AudioData *src = &in_blk;
+
+        n       = FFMIN(in_count, block);
+        max_out = FFMIN(out_count - out_done, max_block_out);
+
+        if(convert_in && n){
+            swri_audio_convert(s->in_convert, &s->postin, &in_blk, n);
+            src = &s->postin;
+        }
+
+        /* swri_rematrix() may point output channels at its input */
+        midbuf = s->midbuf;
+        preout = s->preout;
+        if(s->resample_first){
+            ret = resample(s, &midbuf, max_out, src, n);
+            if(ret > 0)
+                swri_rematrix(s, &preout, &midbuf, ret, 0);
+        }else{
+            if(n)
+                swri_rematrix(s, &midbuf, src, n, 0);
+            ret = resample(s, &preout, max_out, &midbuf, n);
+        }
+        if(ret < 0)
+            return ret;
+
+        if(ret){
+            swri_audio_convert(s->out_convert, &out_blk, &preout, ret);
+            buf_set(&out_blk, &out_blk, ret);
+            out_done += ret;
+        }
+        buf_set(&in_blk, &in_blk, n);
+        in_count -= n;
+        /* a block capped at max_block_out can leave output in the resampler */
+    }while(in_count || (ret == max_out && out_done < out_count));
+
+    return out_done;
+}
+
 static int swr_convert_internal(struct SwrContext *s, AudioData *out, int out_count,
                                                       AudioData *in , int  in_count){
     AudioData *postin, *midbuf, *preout;
@@ -591,6 +664,9 @@ static int swr_convert_internal(struct SwrContext *s, AudioData *out, int out_co
         return out_count;
     }
 
+    if(s->fused_block)
+        return swr_convert_fused(s, out, out_count, in, in_count);
+
 //     in_max= out_count*(int64_t)s->in_sample_rate / s->out_sample_rate + resample_filter_taps;
 //     in_count= FFMIN(in_count, in_in + 2 - s->hist_buffer_count);
 
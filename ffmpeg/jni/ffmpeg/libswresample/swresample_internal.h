@@ -141,6 +141,9 @@ struct SwrContext {
     float async;                                    ///< swr simple 1 parameter async, similar to ffmpegs -async
     int64_t firstpts_in_samples;                    ///< swr first pts in samples
 
+    int fused;                                      ///< 1 if the fused cache blocked conversion may be used
+    int fused_block;                                ///< number of input samples per block of the fused conversion, 0 if it is not used
+
     int resample_first;                             ///< 1 if resampling must come first, 0 if rematrixing
     int rematrix;                                   ///< flag to indicate if rematrixing is needed (basically if input and output layouts mismatch)
     int rematrix_custom;                            ///< flag to indicate that a custom matrix has been defined
@@ -200,6 +203,7 @@ int swri_rematrix_init(SwrContext *s);
 void swri_rematrix_free(SwrContext *s);
 int swri_rematrix(SwrContext *s, AudioData *out, AudioData *in, int len, int mustcopy);
 int swri_rematrix_init_x86(struct SwrContext *s);
+int swri_rematrix_init_aarch64(struct SwrContext *s);
 
 av_warn_unused_result
 int swri_get_dither(SwrContext *s, void *dst, int len, unsigned seed, enum AVSampleFormat noise_fmt);
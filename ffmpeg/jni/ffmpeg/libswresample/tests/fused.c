@@ -0,0 +1,179 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * Compare the fused cache blocked conversion with the unblocked one.
+ * The output of both must be identical, the best conversion time of each
+ * is printed.
+ * tests/fused [seconds]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libavutil/channel_layout.h"
+#include "libavutil/intreadwrite.h"
+#include "libavutil/lfg.h"
+#include "libavutil/mem.h"
+#include "libavutil/opt.h"
+#include "libavutil/samplefmt.h"
+#include "libavutil/time.h"
+
+#include "libswresample/swresample.h"
+
+/* decoders typically return frames of this size */
+#define FRAME_SIZE 1536
+
+#define SWR_CH_MAX 32
+
+/* the best time of this many runs is printed */
+#define RUNS 3
+
+typedef struct Config {
+    int64_t in_layout, out_layout;
+    int in_rate, out_rate;
+    enum AVSampleFormat in_fmt, out_fmt;
+} Config;
+
+static const Config configs[] = {
+    { AV_CH_LAYOUT_7POINT1, AV_CH_LAYOUT_STEREO, 48000, 44100, AV_SAMPLE_FMT_FLTP, AV_SAMPLE_FMT_S16 },
+    { AV_CH_LAYOUT_5POINT1, AV_CH_LAYOUT_STEREO, 48000, 44100, AV_SAMPLE_FMT_FLTP, AV_SAMPLE_FMT_S16 },
+    { AV_CH_LAYOUT_5POINT1, AV_CH_LAYOUT_STEREO, 44100, 48000, AV_SAMPLE_FMT_FLTP, AV_SAMPLE_FMT_S16 },
+    { AV_CH_LAYOUT_5POINT1, AV_CH_LAYOUT_STEREO, 48000, 44100, AV_SAMPLE_FMT_S16P, AV_SAMPLE_FMT_S16 },
+    { AV_CH_LAYOUT_STEREO,  AV_CH_LAYOUT_5POINT1, 44100, 48000, AV_SAMPLE_FMT_FLTP, AV_SAMPLE_FMT_FLT },
+    { AV_CH_LAYOUT_7POINT1, AV_CH_LAYOUT_STEREO, 96000, 48000, AV_SAMPLE_FMT_S32,  AV_SAMPLE_FMT_S16 },
+};
+
+/**
+ * Convert nb_frames frames of in to out.
+ * @return number of samples output per channel, or a negative error code
+ */
+static int convert(const Config *c, int fused, uint8_t **in, int nb_frames,
+                   uint8_t *out, int out_size, int64_t *time)
+{
+    SwrContext *swr;
+    int out_ch   = av_get_channel_layout_nb_channels(c->out_layout);
+    int in_ch    = av_get_channel_layout_nb_channels(c->in_layout);
+    int planes   = av_sample_fmt_is_planar(c->in_fmt) ? in_ch : 1;
+    int in_bytes = av_get_bytes_per_sample(c->in_fmt) * FRAME_SIZE * in_ch / planes;
+    int out_bytes = av_get_bytes_per_sample(c->out_fmt) * out_ch;
+    int i, ret = 0, out_count = 0;
+    int64_t t0;
+
+    swr = swr_alloc_set_opts(NULL, c->out_layout, c->out_fmt, c->out_rate,
+                             c->in_layout, c->in_fmt, c->in_rate, 0, NULL);
+    if (!swr)
+        return AVERROR(ENOMEM);
+    av_opt_set_int(swr, "fused", fused, 0);
+    if ((ret = swr_init(swr)) < 0)
+        goto end;
+
+    t0 = av_gettime_relative();
+    for (i = 0; i <= nb_frames; i++) {
+        const uint8_t *src[SWR_CH_MAX];
+        uint8_t *dst = out + out_count * out_bytes;
+        int ch;
+
+        for (ch = 0; ch < planes; ch++)
+            src[ch] = in[ch] + i * in_bytes;
+        /* the last call flushes */
+        ret = swr_convert(swr, &dst, out_size - out_count,
+                          i < nb_frames ? src : NULL, i < nb_frames ? FRAME_SIZE : 0);
+        if (ret < 0)
+            goto end;
+        out_count += ret;
+    }
+    *time = av_gettime_relative() - t0;
+    ret = out_count;
+
+end:
+    swr_free(&swr);
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    double seconds = argc > 1 ? atof(argv[1]) : 10;
+    int i, failed = 0;
+    AVLFG lfg;
+
+    av_lfg_init(&lfg, 0xdeadbeef);
+
+    printf("%-32s %12s %12s %8s\n", "conversion", "unfused (us)", "fused (us)", "speedup");
+    for (i = 0; i < FF_ARRAY_ELEMS(configs); i++) {
+        const Config *c = &configs[i];
+        int in_ch  = av_get_channel_layout_nb_channels(c->in_layout);
+        int out_ch = av_get_channel_layout_nb_channels(c->out_layout);
+        int nb_frames = seconds * c->in_rate / FRAME_SIZE;
+        int out_size = av_rescale(nb_frames * FRAME_SIZE, c->out_rate, c->in_rate) + 256;
+        int out_bytes = out_size * out_ch * av_get_bytes_per_sample(c->out_fmt);
+        uint8_t *in[SWR_CH_MAX] = { NULL }, *out[2] = { NULL };
+        int64_t time[2];
+        int ret[2], planes, n, p, r, j;
+        char name[64];
+
+        if (av_samples_alloc(in, NULL, in_ch, nb_frames * FRAME_SIZE, c->in_fmt, 0) < 0 ||
+            !(out[0] = av_mallocz(out_bytes)) || !(out[1] = av_mallocz(out_bytes))) {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+        /* noise is the worst case for the caches as nothing is constant */
+        planes = av_sample_fmt_is_planar(c->in_fmt) ? in_ch : 1;
+        n = nb_frames * FRAME_SIZE * in_ch / planes;
+        for (p = 0; p < planes; p++) {
+            for (j = 0; j < n; j++) {
+                uint32_t v = av_lfg_get(&lfg);
+                if (c->in_fmt == AV_SAMPLE_FMT_FLTP)
+                    ((float *)in[p])[j] = (int32_t)v / (float)INT32_MAX;
+                else if (c->in_fmt == AV_SAMPLE_FMT_S16P)
+                    ((int16_t *)in[p])[j] = v >> 16;
+                else
+                    AV_WN32(in[p] + 4 * j, v);
+            }
+        }
+
+        time[0] = time[1] = INT64_MAX;
+        for (r = 0; r < 2 * RUNS; r++) {
+            int64_t t;
+            j = r & 1;
+            ret[j] = convert(c, j, in, nb_frames, out[j], out_size, &t);
+            if (ret[j] < 0) {
+                fprintf(stderr, "conversion failed: %s\n", av_err2str(ret[j]));
+                return 1;
+            }
+            time[j] = FFMIN(time[j], t);
+        }
+
+        snprintf(name, sizeof(name), "%dch %s %d -> %dch %s %d",
+                 in_ch, av_get_sample_fmt_name(c->in_fmt), c->in_rate,
+                 out_ch, av_get_sample_fmt_name(c->out_fmt), c->out_rate);
+        printf("%-32s %12"PRId64" %12"PRId64" %7.2fx\n", name, time[0], time[1],
+               time[1] ? time[0] / (double)time[1] : 0.0);
+        if (ret[0] != ret[1] || memcmp(out[0], out[1], ret[0] * out_ch * av_get_bytes_per_sample(c->out_fmt))) {
+            fprintf(stderr, "%s: the fused output differs (%d / %d samples)\n", name, ret[0], ret[1]);
+            failed = 1;
+        }
+
+        av_freep(&in[0]);
+        av_freep(&out[0]);
+        av_freep(&out[1]);
+    }
+
+    return failed;
+}
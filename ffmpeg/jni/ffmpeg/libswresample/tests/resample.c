@@ -0,0 +1,205 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * Compare the phase table block kernel with resample_common for the ratios
+ * of playback speed changes and the usual output rates.  The integer output
+ * of both must be identical and the float output must match within
+ * rounding, the best time of each and the time of building the filter bank
+ * with and without the cache are printed.
+ * tests/resample [seconds]
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libavutil/lfg.h"
+#include "libavutil/mem.h"
+#include "libavutil/samplefmt.h"
+#include "libavutil/time.h"
+
+#include "libswresample/resample.h"
+
+/* the best time of this many runs is printed */
+#define RUNS 3
+
+/* output samples per call, like a decoded frame */
+#define CHUNK 1024
+
+typedef struct Config {
+    int in_rate, out_rate;
+    enum AVSampleFormat fmt;
+} Config;
+
+static const Config configs[] = {
+    {  44100, 48000, AV_SAMPLE_FMT_FLTP },
+    {  48000, 44100, AV_SAMPLE_FMT_FLTP },
+    {  22050, 44100, AV_SAMPLE_FMT_FLTP },
+    {  66150, 44100, AV_SAMPLE_FMT_FLTP },
+    {  88200, 44100, AV_SAMPLE_FMT_FLTP },
+    { 176400, 44100, AV_SAMPLE_FMT_FLTP },
+    {  44100, 48000, AV_SAMPLE_FMT_S16P },
+    {  48000, 44100, AV_SAMPLE_FMT_S16P },
+    {  88200, 44100, AV_SAMPLE_FMT_S16P },
+    {  44100, 48000, AV_SAMPLE_FMT_S32P },
+    {  96000, 44100, AV_SAMPLE_FMT_DBLP },
+};
+
+static ResampleContext *init(const Config *cfg)
+{
+    return swri_resampler.init(NULL, cfg->out_rate, cfg->in_rate, 32, 10, 0, 0,
+                               cfg->fmt, SWR_FILTER_TYPE_KAISER, 9, 0, 0, 1);
+}
+
+/**
+ * Resample in to out in chunks with block or resample_common.
+ * @return the number of input samples consumed
+ */
+static int run(ResampleContext *c, int block, uint8_t *out, const uint8_t *in,
+               int nb_out, int64_t *time)
+{
+    int (*resample)(ResampleContext *c, void *dst, const void *src, int n, int update_ctx) =
+        block ? c->dsp.resample_block : c->dsp.resample_common;
+    int bps = av_get_bytes_per_sample(c->format);
+    int i, consumed = 0;
+    int64_t t0;
+
+    c->index = 0;
+    c->frac  = 0;
+    t0 = av_gettime_relative();
+    for (i = 0; i < nb_out; i += CHUNK) {
+        consumed += resample(c, out + i * bps, in + consumed * bps,
+                             FFMIN(CHUNK, nb_out - i), 1);
+    }
+    *time = av_gettime_relative() - t0;
+    return consumed;
+}
+
+static double max_diff(enum AVSampleFormat fmt, const uint8_t *a, const uint8_t *b, int n)
+{
+    double diff = 0;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        switch (fmt) {
+        case AV_SAMPLE_FMT_FLTP:
+            diff = FFMAX(diff, fabs(((const float *)a)[i] - ((const float *)b)[i]));
+            break;
+        case AV_SAMPLE_FMT_DBLP:
+            diff = FFMAX(diff, fabs(((const double *)a)[i] - ((const double *)b)[i]));
+            break;
+        default:
+            if (memcmp(a + i * av_get_bytes_per_sample(fmt), b + i * av_get_bytes_per_sample(fmt),
+                       av_get_bytes_per_sample(fmt)))
+                return 1;
+        }
+    }
+    return diff;
+}
+
+int main(int argc, char **argv)
+{
+    double seconds = argc > 1 ? atof(argv[1]) : 10;
+    int i, failed = 0;
+    AVLFG lfg;
+
+    av_lfg_init(&lfg, 0xdeadbeef);
+
+    printf("%-20s %10s %10s %12s %12s %8s\n", "ratio", "init (us)", "cached",
+           "common (us)", "block (us)", "speedup");
+    for (i = 0; i < FF_ARRAY_ELEMS(configs); i++) {
+        const Config *cfg = &configs[i];
+        ResampleContext *c;
+        int bps    = av_get_bytes_per_sample(cfg->fmt);
+        int nb_out = seconds * cfg->out_rate;
+        int nb_in  = av_rescale(nb_out, cfg->in_rate, cfg->out_rate) + 1024;
+        uint8_t *in, *out[2];
+        int64_t init_time[2], time[2], t0;
+        int consumed[2], r, j;
+        double diff;
+        char name[64];
+
+        /* the first init builds the filter bank, the second finds it in the
+         * cache as long as c is alive */
+        t0 = av_gettime_relative();
+        c  = init(cfg);
+        init_time[0] = av_gettime_relative() - t0;
+        if (!c) {
+            fprintf(stderr, "init failed\n");
+            return 1;
+        }
+        t0 = av_gettime_relative();
+        {
+            ResampleContext *c2 = init(cfg);
+            init_time[1] = av_gettime_relative() - t0;
+            swri_resampler.free(&c2);
+        }
+
+        snprintf(name, sizeof(name), "%d -> %d %s", cfg->in_rate, cfg->out_rate,
+                 av_get_sample_fmt_name(cfg->fmt));
+        if (!c->phase_table) {
+            printf("%-20s no phase table\n", name);
+            swri_resampler.free(&c);
+            continue;
+        }
+
+        in     = av_malloc(nb_in * bps);
+        out[0] = av_malloc(nb_out * bps);
+        out[1] = av_malloc(nb_out * bps);
+        if (!in || !out[0] || !out[1]) {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+        for (j = 0; j < nb_in; j++) {
+            uint32_t v = av_lfg_get(&lfg);
+            switch (cfg->fmt) {
+            case AV_SAMPLE_FMT_FLTP: ((float   *)in)[j] = (int32_t)v / (float)INT32_MAX;  break;
+            case AV_SAMPLE_FMT_DBLP: ((double  *)in)[j] = (int32_t)v / (double)INT32_MAX; break;
+            case AV_SAMPLE_FMT_S16P: ((int16_t *)in)[j] = v >> 16;                        break;
+            case AV_SAMPLE_FMT_S32P: ((int32_t *)in)[j] = v;                              break;
+            }
+        }
+
+        time[0] = time[1] = INT64_MAX;
+        for (r = 0; r < 2 * RUNS; r++) {
+            int64_t t;
+            j = r & 1;
+            consumed[j] = run(c, j, out[j], in, nb_out, &t);
+            time[j] = FFMIN(time[j], t);
+        }
+
+        diff = max_diff(cfg->fmt, out[0], out[1], nb_out);
+        printf("%-20s %10"PRId64" %10"PRId64" %12"PRId64" %12"PRId64" %7.2fx\n", name,
+               init_time[0], init_time[1], time[0], time[1],
+               time[1] ? time[0] / (double)time[1] : 0.0);
+        if (consumed[0] != consumed[1] || diff > (cfg->fmt == AV_SAMPLE_FMT_FLTP ? 1e-5 : 1e-12)) {
+            fprintf(stderr, "%s: the block output differs (%d / %d samples consumed, max diff %g)\n",
+                    name, consumed[0], consumed[1], diff);
+            failed = 1;
+        }
+
+        av_freep(&in);
+        av_freep(&out[0]);
+        av_freep(&out[1]);
+        swri_resampler.free(&c);
+    }
+
+    return failed;
+}
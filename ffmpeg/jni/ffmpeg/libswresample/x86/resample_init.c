@@ -48,6 +48,8 @@ RESAMPLE_FUNCS(double, fma3);
 av_cold void swri_resample_dsp_x86_init(ResampleContext *c)
 {
     int av_unused mm_flags = av_get_cpu_flags();
+    int (*resample_common)(ResampleContext *c, void *dst, const void *src, int sz, int upd) =
+        c->dsp.resample_common;
 
     switch(c->format){
     case AV_SAMPLE_FMT_S16P:
@@ -97,4 +99,8 @@ av_cold void swri_resample_dsp_x86_init(ResampleContext *c)
         }
         break;
     }
+
+    /* the SIMD filters are faster than the scalar resample_block() */
+    if (c->dsp.resample_common != resample_common)
+        c->dsp.resample_block = NULL;
 }
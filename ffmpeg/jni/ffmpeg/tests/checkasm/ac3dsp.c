@@ -0,0 +1,184 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+
+#include "libavcodec/ac3.h"
+#include "libavcodec/ac3dsp.h"
+#include "libavutil/common.h"
+#include "libavutil/internal.h"
+#include "libavutil/mem.h"
+
+#include "checkasm.h"
+
+#define MAX_COEFS  256
+#define MAX_CH     6
+#define EPS        1.0e-5
+
+#define randomize_float(buf, len)                               \
+    do {                                                        \
+        int i;                                                  \
+        for (i = 0; i < len; i++)                               \
+            buf[i] = (float)rnd() / UINT_MAX * 2.0f - 1.0f;     \
+    } while (0)
+
+static void check_exponent_min(void)
+{
+    LOCAL_ALIGNED_16(uint8_t, src,  [AC3_MAX_BLOCKS * MAX_COEFS]);
+    LOCAL_ALIGNED_16(uint8_t, exp0, [AC3_MAX_BLOCKS * MAX_COEFS]);
+    LOCAL_ALIGNED_16(uint8_t, exp1, [AC3_MAX_BLOCKS * MAX_COEFS]);
+    int i, n;
+
+    declare_func(void, uint8_t *exp, int num_reuse_blocks, int nb_coefs);
+
+    for (i = 0; i < AC3_MAX_BLOCKS * MAX_COEFS; i++)
+        src[i] = rnd() % 25;
+
+    for (n = 0; n < AC3_MAX_BLOCKS; n++) {
+        int nb_coefs = 16 * (1 + rnd() % (MAX_COEFS / 16));
+
+        memcpy(exp0, src, AC3_MAX_BLOCKS * MAX_COEFS);
+        memcpy(exp1, src, AC3_MAX_BLOCKS * MAX_COEFS);
+        call_ref(exp0, n, nb_coefs);
+        call_new(exp1, n, nb_coefs);
+        if (memcmp(exp0, exp1, AC3_MAX_BLOCKS * MAX_COEFS))
+            fail();
+    }
+    memcpy(exp1, src, AC3_MAX_BLOCKS * MAX_COEFS);
+    bench_new(exp1, AC3_MAX_BLOCKS - 1, MAX_COEFS);
+}
+
+static void check_float_to_fixed24(void)
+{
+    LOCAL_ALIGNED_16(float,   src,  [MAX_COEFS]);
+    LOCAL_ALIGNED_16(int32_t, dst0, [MAX_COEFS]);
+    LOCAL_ALIGNED_16(int32_t, dst1, [MAX_COEFS]);
+
+    declare_func(void, int32_t *dst, const float *src, unsigned int len);
+
+    randomize_float(src, MAX_COEFS);
+    call_ref(dst0, src, MAX_COEFS);
+    call_new(dst1, src, MAX_COEFS);
+    if (memcmp(dst0, dst1, MAX_COEFS * sizeof(*dst0)))
+        fail();
+    bench_new(dst1, src, MAX_COEFS);
+}
+
+static void check_extract_exponents(void)
+{
+    LOCAL_ALIGNED_16(int32_t, coef, [MAX_COEFS]);
+    LOCAL_ALIGNED_16(uint8_t, exp0, [MAX_COEFS]);
+    LOCAL_ALIGNED_16(uint8_t, exp1, [MAX_COEFS]);
+    int i;
+
+    declare_func(void, uint8_t *exp, int32_t *coef, int nb_coefs);
+
+    for (i = 0; i < MAX_COEFS; i++) {
+        int32_t v = (rnd() & 0xFFFFFF) >> (rnd() % 25);
+        coef[i] = rnd() & 1 ? -v : v;
+    }
+    call_ref(exp0, coef, MAX_COEFS);
+    call_new(exp1, coef, MAX_COEFS);
+    if (memcmp(exp0, exp1, MAX_COEFS))
+        fail();
+    bench_new(exp1, coef, MAX_COEFS);
+}
+
+/* the C code only has special cases for some channel layouts, so the
+ * optimized versions are compared with the generic matrix multiplication */
+static void downmix_ref(float **samples, float **matrix,
+                        int out_ch, int in_ch, int len)
+{
+    int i, j, k;
+
+    for (i = 0; i < len; i++) {
+        float v[2] = { 0 };
+
+        for (k = 0; k < out_ch; k++)
+            for (j = 0; j < in_ch; j++)
+                v[k] += samples[j][i] * matrix[k][j];
+        for (k = 0; k < out_ch; k++)
+            samples[k][i] = v[k];
+    }
+}
+
+static void check_downmix(void)
+{
+    LOCAL_ALIGNED_16(float, src,  [MAX_CH * MAX_COEFS]);
+    LOCAL_ALIGNED_16(float, buf0, [MAX_CH * MAX_COEFS]);
+    LOCAL_ALIGNED_16(float, buf1, [MAX_CH * MAX_COEFS]);
+    float matrix_buf[2][MAX_CH];
+    float *matrix[2] = { matrix_buf[0], matrix_buf[1] };
+    float *samples0[MAX_CH], *samples1[MAX_CH];
+    int in_ch, out_ch, i;
+
+    declare_func(void, float **samples, float **matrix, int len);
+
+    for (i = 0; i < MAX_CH; i++) {
+        samples0[i] = buf0 + i * MAX_COEFS;
+        samples1[i] = buf1 + i * MAX_COEFS;
+    }
+
+    for (in_ch = 3; in_ch <= MAX_CH; in_ch++) {
+        for (out_ch = 1; out_ch <= 2; out_ch++) {
+            AC3DSPContext c;
+
+            ff_ac3dsp_init(&c, 0);
+            randomize_float(matrix_buf[0], MAX_CH);
+            randomize_float(matrix_buf[1], MAX_CH);
+            randomize_float(src, MAX_CH * MAX_COEFS);
+            memcpy(buf0, src, sizeof(*src) * MAX_CH * MAX_COEFS);
+            memcpy(buf1, src, sizeof(*src) * MAX_CH * MAX_COEFS);
+
+            /* selects c.downmix for this layout */
+            ff_ac3dsp_downmix(&c, samples0, matrix, out_ch, in_ch, MAX_COEFS);
+            if (!check_func(c.downmix, "ac3_downmix_%d_to_%d", in_ch, out_ch))
+                continue;
+
+            memcpy(buf0, src, sizeof(*src) * MAX_CH * MAX_COEFS);
+            downmix_ref(samples0, matrix, out_ch, in_ch, MAX_COEFS);
+            call_new(samples1, matrix, MAX_COEFS);
+            if (!float_near_abs_eps_array(buf0, buf1, EPS, MAX_CH * MAX_COEFS))
+                fail();
+            memcpy(buf1, src, sizeof(*src) * MAX_CH * MAX_COEFS);
+            bench_new(samples1, matrix, MAX_COEFS);
+        }
+    }
+}
+
+void checkasm_check_ac3dsp(void)
+{
+    AC3DSPContext c;
+
+    ff_ac3dsp_init(&c, 0);
+
+    if (check_func(c.ac3_exponent_min, "ac3_exponent_min"))
+        check_exponent_min();
+    report("ac3_exponent_min");
+
+    if (check_func(c.float_to_fixed24, "float_to_fixed24"))
+        check_float_to_fixed24();
+    report("float_to_fixed24");
+
+    if (check_func(c.extract_exponents, "ac3_extract_exponents"))
+        check_extract_exponents();
+    report("ac3_extract_exponents");
+
+    check_downmix();
+    report("downmix");
+}
@@ -0,0 +1,68 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+
+#include "libavcodec/dcadata.h"
+#include "libavcodec/dcadsp.h"
+#include "libavcodec/mathops.h"
+#include "libavutil/internal.h"
+#include "libavutil/mem.h"
+
+#include "checkasm.h"
+
+#define LFE_HISTORY 8
+#define NPCMBLOCKS  32
+#define MAX_LFE     (NPCMBLOCKS / 2)
+#define PCM_SIZE    (NPCMBLOCKS * 32)
+
+static void check_lfe_fir(int dec_select)
+{
+    LOCAL_ALIGNED_16(int32_t, lfe,  [LFE_HISTORY + MAX_LFE]);
+    LOCAL_ALIGNED_16(float,   dst0, [PCM_SIZE]);
+    LOCAL_ALIGNED_16(float,   dst1, [PCM_SIZE]);
+    const float *coeff = dec_select ? ff_dca_lfe_fir_128 : ff_dca_lfe_fir_64;
+    int i;
+
+    declare_func(void, float *pcm_samples, int32_t *lfe_samples,
+                 const float *filter_coeff, ptrdiff_t npcmblocks);
+
+    for (i = 0; i < LFE_HISTORY + MAX_LFE; i++)
+        lfe[i] = sign_extend(rnd(), 24);
+    memset(dst0, 0, sizeof(*dst0) * PCM_SIZE);
+    memset(dst1, 0, sizeof(*dst1) * PCM_SIZE);
+
+    call_ref(dst0, lfe + LFE_HISTORY, coeff, NPCMBLOCKS);
+    call_new(dst1, lfe + LFE_HISTORY, coeff, NPCMBLOCKS);
+    if (!float_near_abs_eps_array_ulp(dst0, dst1, 1.0f, 16, PCM_SIZE))
+        fail();
+    bench_new(dst1, lfe + LFE_HISTORY, coeff, NPCMBLOCKS);
+}
+
+void checkasm_check_dcadsp(void)
+{
+    DCADSPContext c;
+    int i;
+
+    ff_dcadsp_init(&c);
+
+    for (i = 0; i < 2; i++)
+        if (check_func(c.lfe_fir_float[i], "lfe_fir%d_float", i))
+            check_lfe_fir(i);
+    report("lfe_fir_float");
+}
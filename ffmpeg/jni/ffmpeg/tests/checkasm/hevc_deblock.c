@@ -0,0 +1,144 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+
+#include "libavutil/common.h"
+#include "libavutil/intreadwrite.h"
+
+#include "libavcodec/hevcdsp.h"
+
+#include "checkasm.h"
+
+#define SIZEOF_PIXEL ((bit_depth + 7) / 8)
+#define BUF_STRIDE   (16 * 2)
+#define BUF_SIZE     (BUF_STRIDE * 16)
+/* the edge runs through the middle of the 16x16 block */
+#define BUF_OFFSET   (8 * BUF_STRIDE + 8 * SIZEOF_PIXEL)
+
+/* Fully random pixels almost never pass the luma filter decisions, so the
+ * block is a flat area with a step across the edge and a little noise.
+ * beta and tc are passed in 8 bit units, the functions scale them. */
+static void randomize_buffers(uint8_t *buf0, uint8_t *buf1, int vertical, int bit_depth)
+{
+    int max   = (1 << bit_depth) - 1;
+    int base  = rnd() & max;
+    int step  = (int)(rnd() % 64 - 32) * (1 << (bit_depth - 8));
+    int noise = 1 + (rnd() % 4 << (bit_depth - 8));
+    int a, b;
+
+    memset(buf0, 0, BUF_SIZE);
+    memset(buf1, 0, BUF_SIZE);
+    for (a = 0; a < 16; a++) {
+        for (b = 0; b < 16; b++) {
+            int v   = av_clip(base + (a >= 8 ? step : 0) + rnd() % noise, 0, max);
+            int pos = vertical ? (b - 8) * BUF_STRIDE + (a - 8) * SIZEOF_PIXEL
+                               : (a - 8) * BUF_STRIDE + (b - 8) * SIZEOF_PIXEL;
+
+            if (bit_depth == 8) {
+                buf0[BUF_OFFSET + pos] = v;
+                buf1[BUF_OFFSET + pos] = v;
+            } else {
+                AV_WN16A(buf0 + BUF_OFFSET + pos, v);
+                AV_WN16A(buf1 + BUF_OFFSET + pos, v);
+            }
+        }
+    }
+}
+
+static void check_loop_filter_luma(HEVCDSPContext *h, int bit_depth)
+{
+    LOCAL_ALIGNED_32(uint8_t, buf0, [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, buf1, [BUF_SIZE]);
+    uint8_t no_p[2] = { 0 }, no_q[2] = { 0 };
+    declare_func(void, uint8_t *pix, ptrdiff_t stride, int beta,
+                 int32_t *tc, uint8_t *no_p, uint8_t *no_q);
+    int dir;
+
+    for (dir = 0; dir < 2; dir++) {
+        void (*func)(uint8_t *, ptrdiff_t, int, int32_t *, uint8_t *, uint8_t *) =
+            dir ? h->hevc_v_loop_filter_luma : h->hevc_h_loop_filter_luma;
+
+        if (check_func(func, "hevc_%s_loop_filter_luma_%d", dir ? "v" : "h", bit_depth)) {
+            int i;
+
+            for (i = 0; i < 32; i++) {
+                int beta      = rnd() % 65;
+                int32_t tc[2] = { rnd() % 25, rnd() % 25 };
+
+                randomize_buffers(buf0, buf1, dir, bit_depth);
+                call_ref(buf0 + BUF_OFFSET, BUF_STRIDE, beta, tc, no_p, no_q);
+                call_new(buf1 + BUF_OFFSET, BUF_STRIDE, beta, tc, no_p, no_q);
+                if (memcmp(buf0, buf1, BUF_SIZE))
+                    fail();
+            }
+            bench_new(buf1 + BUF_OFFSET, BUF_STRIDE, 32, (int32_t[2]){ 8, 8 }, no_p, no_q);
+        }
+    }
+}
+
+static void check_loop_filter_chroma(HEVCDSPContext *h, int bit_depth)
+{
+    LOCAL_ALIGNED_32(uint8_t, buf0, [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, buf1, [BUF_SIZE]);
+    uint8_t no_p[2] = { 0 }, no_q[2] = { 0 };
+    declare_func(void, uint8_t *pix, ptrdiff_t stride,
+                 int32_t *tc, uint8_t *no_p, uint8_t *no_q);
+    int dir;
+
+    for (dir = 0; dir < 2; dir++) {
+        void (*func)(uint8_t *, ptrdiff_t, int32_t *, uint8_t *, uint8_t *) =
+            dir ? h->hevc_v_loop_filter_chroma : h->hevc_h_loop_filter_chroma;
+
+        if (check_func(func, "hevc_%s_loop_filter_chroma_%d", dir ? "v" : "h", bit_depth)) {
+            int i;
+
+            for (i = 0; i < 32; i++) {
+                int32_t tc[2] = { rnd() % 25, rnd() % 25 };
+
+                randomize_buffers(buf0, buf1, dir, bit_depth);
+                call_ref(buf0 + BUF_OFFSET, BUF_STRIDE, tc, no_p, no_q);
+                call_new(buf1 + BUF_OFFSET, BUF_STRIDE, tc, no_p, no_q);
+                if (memcmp(buf0, buf1, BUF_SIZE))
+                    fail();
+            }
+            bench_new(buf1 + BUF_OFFSET, BUF_STRIDE, (int32_t[2]){ 8, 8 }, no_p, no_q);
+        }
+    }
+}
+
+void checkasm_check_hevc_deblock(void)
+{
+    int bit_depth;
+
+    for (bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        HEVCDSPContext h;
+
+        ff_hevc_dsp_init(&h, bit_depth);
+        check_loop_filter_luma(&h, bit_depth);
+    }
+    report("loop_filter_luma");
+
+    for (bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        HEVCDSPContext h;
+
+        ff_hevc_dsp_init(&h, bit_depth);
+        check_loop_filter_chroma(&h, bit_depth);
+    }
+    report("loop_filter_chroma");
+}
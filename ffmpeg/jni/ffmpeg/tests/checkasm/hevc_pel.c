@@ -0,0 +1,197 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+
+#include "libavutil/intreadwrite.h"
+
+#include "libavcodec/hevcdsp.h"
+
+#include "checkasm.h"
+
+static const uint32_t pixel_mask[3] = { 0xffffffff, 0x03ff03ff, 0x0fff0fff };
+static const int sizes[10] = { 2, 4, 6, 8, 12, 16, 24, 32, 48, 64 };
+static const char *const filters[2][2] = { { "pixels", "h" }, { "v", "hv" } };
+
+#define SIZEOF_PIXEL ((bit_depth + 7) / 8)
+/* room for the filter taps around a 64x64 block at up to 16 bit */
+#define SRC_STRIDE   (2 * (MAX_PB_SIZE + 16))
+#define SRC_SIZE     (SRC_STRIDE * (MAX_PB_SIZE + 16))
+#define SRC_OFFSET   (4 * SRC_STRIDE + 8 * SIZEOF_PIXEL)
+#define DST_STRIDE   (2 * MAX_PB_SIZE)
+#define DST_SIZE     (DST_STRIDE * MAX_PB_SIZE)
+
+#define randomize_buffers()                                 \
+    do {                                                    \
+        uint32_t mask = pixel_mask[(bit_depth - 8) >> 1];   \
+        int k;                                              \
+        for (k = 0; k < SRC_SIZE; k += 4) {                 \
+            uint32_t r = rnd() & mask;                      \
+            AV_WN32A(src0 + k, r);                          \
+            AV_WN32A(src1 + k, r);                          \
+        }                                                   \
+        for (k = 0; k < DST_SIZE; k += 4) {                 \
+            uint32_t r = rnd();                             \
+            AV_WN32A(dst0 + k, r);                          \
+            AV_WN32A(dst1 + k, r);                          \
+            AV_WN32A(src2 + k, rnd());                      \
+        }                                                   \
+    } while (0)
+
+/* the fractional positions are picked at random, 0 selects the unfiltered
+ * direction of the [my][mx] table entries */
+#define random_mv(filtered, epel) ((filtered) ? 1 + rnd() % ((epel) ? 7 : 3) : 0)
+
+static void check_put(void (*tab[10][2][2])(int16_t *dst, uint8_t *src, ptrdiff_t srcstride,
+                                            int height, intptr_t mx, intptr_t my, int width),
+                      const char *type, int epel, int bit_depth)
+{
+    LOCAL_ALIGNED_32(uint8_t, src0, [SRC_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, src1, [SRC_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst0, [DST_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [DST_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, src2, [DST_SIZE]);
+    int i, j, size;
+    declare_func(void, int16_t *dst, uint8_t *src, ptrdiff_t srcstride,
+                 int height, intptr_t mx, intptr_t my, int width);
+
+    for (j = 0; j < 2; j++) {
+        for (i = 0; i < 2; i++) {
+            for (size = 0; size < 10; size++) {
+                int w = sizes[size];
+
+                if (check_func(tab[size][j][i], "put_hevc_%s_%s%d_%d",
+                               type, filters[j][i], w, bit_depth)) {
+                    intptr_t mx = random_mv(i, epel), my = random_mv(j, epel);
+
+                    randomize_buffers();
+                    call_ref((int16_t *)dst0, src0 + SRC_OFFSET, SRC_STRIDE, w, mx, my, w);
+                    call_new((int16_t *)dst1, src1 + SRC_OFFSET, SRC_STRIDE, w, mx, my, w);
+                    if (memcmp(dst0, dst1, DST_SIZE))
+                        fail();
+                    bench_new((int16_t *)dst1, src1 + SRC_OFFSET, SRC_STRIDE, w, mx, my, w);
+                }
+            }
+        }
+    }
+}
+
+static void check_uni(void (*tab[10][2][2])(uint8_t *dst, ptrdiff_t dststride,
+                                            uint8_t *src, ptrdiff_t srcstride,
+                                            int height, intptr_t mx, intptr_t my, int width),
+                      const char *type, int epel, int bit_depth)
+{
+    LOCAL_ALIGNED_32(uint8_t, src0, [SRC_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, src1, [SRC_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst0, [DST_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [DST_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, src2, [DST_SIZE]);
+    int i, j, size;
+    declare_func(void, uint8_t *dst, ptrdiff_t dststride, uint8_t *src, ptrdiff_t srcstride,
+                 int height, intptr_t mx, intptr_t my, int width);
+
+    for (j = 0; j < 2; j++) {
+        for (i = 0; i < 2; i++) {
+            for (size = 0; size < 10; size++) {
+                int w = sizes[size];
+
+                if (check_func(tab[size][j][i], "put_hevc_%s_uni_%s%d_%d",
+                               type, filters[j][i], w, bit_depth)) {
+                    intptr_t mx = random_mv(i, epel), my = random_mv(j, epel);
+
+                    randomize_buffers();
+                    call_ref(dst0, DST_STRIDE, src0 + SRC_OFFSET, SRC_STRIDE, w, mx, my, w);
+                    call_new(dst1, DST_STRIDE, src1 + SRC_OFFSET, SRC_STRIDE, w, mx, my, w);
+                    if (memcmp(dst0, dst1, DST_SIZE))
+                        fail();
+                    bench_new(dst1, DST_STRIDE, src1 + SRC_OFFSET, SRC_STRIDE, w, mx, my, w);
+                }
+            }
+        }
+    }
+}
+
+static void check_bi(void (*tab[10][2][2])(uint8_t *dst, ptrdiff_t dststride,
+                                           uint8_t *src, ptrdiff_t srcstride, int16_t *src2,
+                                           int height, intptr_t mx, intptr_t my, int width),
+                     const char *type, int epel, int bit_depth)
+{
+    LOCAL_ALIGNED_32(uint8_t, src0, [SRC_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, src1, [SRC_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst0, [DST_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [DST_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, src2, [DST_SIZE]);
+    int i, j, size;
+    declare_func(void, uint8_t *dst, ptrdiff_t dststride, uint8_t *src, ptrdiff_t srcstride,
+                 int16_t *src2, int height, intptr_t mx, intptr_t my, int width);
+
+    for (j = 0; j < 2; j++) {
+        for (i = 0; i < 2; i++) {
+            for (size = 0; size < 10; size++) {
+                int w = sizes[size];
+
+                if (check_func(tab[size][j][i], "put_hevc_%s_bi_%s%d_%d",
+                               type, filters[j][i], w, bit_depth)) {
+                    intptr_t mx = random_mv(i, epel), my = random_mv(j, epel);
+
+                    randomize_buffers();
+                    call_ref(dst0, DST_STRIDE, src0 + SRC_OFFSET, SRC_STRIDE,
+                             (int16_t *)src2, w, mx, my, w);
+                    call_new(dst1, DST_STRIDE, src1 + SRC_OFFSET, SRC_STRIDE,
+                             (int16_t *)src2, w, mx, my, w);
+                    if (memcmp(dst0, dst1, DST_SIZE))
+                        fail();
+                    bench_new(dst1, DST_STRIDE, src1 + SRC_OFFSET, SRC_STRIDE,
+                              (int16_t *)src2, w, mx, my, w);
+                }
+            }
+        }
+    }
+}
+
+void checkasm_check_hevc_pel(void)
+{
+    int bit_depth;
+
+    for (bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        HEVCDSPContext h;
+
+        ff_hevc_dsp_init(&h, bit_depth);
+        check_put(h.put_hevc_qpel, "qpel", 0, bit_depth);
+        check_put(h.put_hevc_epel, "epel", 1, bit_depth);
+    }
+    report("put");
+
+    for (bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        HEVCDSPContext h;
+
+        ff_hevc_dsp_init(&h, bit_depth);
+        check_uni(h.put_hevc_qpel_uni, "qpel", 0, bit_depth);
+        check_uni(h.put_hevc_epel_uni, "epel", 1, bit_depth);
+    }
+    report("uni");
+
+    for (bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        HEVCDSPContext h;
+
+        ff_hevc_dsp_init(&h, bit_depth);
+        check_bi(h.put_hevc_qpel_bi, "qpel", 0, bit_depth);
+        check_bi(h.put_hevc_epel_bi, "epel", 1, bit_depth);
+    }
+    report("bi");
+}
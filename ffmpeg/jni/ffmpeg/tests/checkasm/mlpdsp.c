@@ -0,0 +1,137 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+
+#include "libavcodec/mlp.h"
+#include "libavcodec/mlpdsp.h"
+#include "libavcodec/mathops.h"
+#include "libavutil/internal.h"
+#include "libavutil/mem.h"
+
+#include "checkasm.h"
+
+#define STATE_SIZE (MAX_BLOCKSIZE + MAX_FIR_ORDER)
+
+static void check_filter_channel(void)
+{
+    LOCAL_ALIGNED_16(int32_t, state0,  [NUM_FILTERS * STATE_SIZE]);
+    LOCAL_ALIGNED_16(int32_t, state1,  [NUM_FILTERS * STATE_SIZE]);
+    LOCAL_ALIGNED_16(int32_t, samples, [MAX_BLOCKSIZE * MAX_CHANNELS]);
+    LOCAL_ALIGNED_16(int32_t, buf0,    [MAX_BLOCKSIZE * MAX_CHANNELS]);
+    LOCAL_ALIGNED_16(int32_t, buf1,    [MAX_BLOCKSIZE * MAX_CHANNELS]);
+    LOCAL_ALIGNED_16(int32_t, coeff,   [NUM_FILTERS * MAX_FIR_ORDER]);
+    int i, iirorder;
+
+    declare_func(void, int32_t *state, const int32_t *coeff,
+                 int firorder, int iirorder, unsigned int filter_shift,
+                 int32_t mask, int blocksize, int32_t *sample_buffer);
+
+    for (i = 0; i < NUM_FILTERS * MAX_FIR_ORDER; i++)
+        coeff[i] = sign_extend(rnd(), 16);
+    for (i = 0; i < MAX_BLOCKSIZE * MAX_CHANNELS; i++)
+        samples[i] = sign_extend(rnd(), 24);
+
+    for (iirorder = 0; iirorder <= MAX_IIR_ORDER; iirorder++) {
+        int firorder  = rnd() % (MAX_FIR_ORDER - iirorder + 1);
+        int shift     = rnd() % 16;
+        int32_t mask  = -1U << (rnd() % 8);
+        int blocksize = 1 + rnd() % MAX_BLOCKSIZE;
+        int ch        = rnd() % MAX_CHANNELS;
+
+        for (i = 0; i < NUM_FILTERS * STATE_SIZE; i++)
+            state0[i] = state1[i] = sign_extend(rnd(), 24);
+        memcpy(buf0, samples, sizeof(*samples) * MAX_BLOCKSIZE * MAX_CHANNELS);
+        memcpy(buf1, samples, sizeof(*samples) * MAX_BLOCKSIZE * MAX_CHANNELS);
+
+        call_ref(state0 + MAX_BLOCKSIZE, coeff, firorder, iirorder,
+                 shift, mask, blocksize, buf0 + ch);
+        call_new(state1 + MAX_BLOCKSIZE, coeff, firorder, iirorder,
+                 shift, mask, blocksize, buf1 + ch);
+        if (memcmp(state0, state1, sizeof(*state0) * NUM_FILTERS * STATE_SIZE) ||
+            memcmp(buf0, buf1, sizeof(*buf0) * MAX_BLOCKSIZE * MAX_CHANNELS))
+            fail();
+    }
+    bench_new(state1 + MAX_BLOCKSIZE, coeff, MAX_FIR_ORDER - MAX_IIR_ORDER,
+              MAX_IIR_ORDER, 8, -1, MAX_BLOCKSIZE, buf1);
+}
+
+static void check_rematrix_channel(void)
+{
+    LOCAL_ALIGNED_16(int32_t, samples, [MAX_BLOCKSIZE * MAX_CHANNELS]);
+    LOCAL_ALIGNED_16(int32_t, buf0,    [MAX_BLOCKSIZE * MAX_CHANNELS]);
+    LOCAL_ALIGNED_16(int32_t, buf1,    [MAX_BLOCKSIZE * MAX_CHANNELS]);
+    LOCAL_ALIGNED_16(int32_t, coeffs,  [MAX_CHANNELS]);
+    int32_t coeff_val[MAX_CHANNELS];
+    LOCAL_ALIGNED_16(uint8_t, lsbs,    [MAX_BLOCKSIZE * MAX_CHANNELS]);
+    LOCAL_ALIGNED_16(int8_t,  noise,   [1 << 8]);
+    int i, maxchan;
+
+    declare_func(void, int32_t *samples, const int32_t *coeffs,
+                 const uint8_t *bypassed_lsbs, const int8_t *noise_buffer,
+                 int index, unsigned int dest_ch, uint16_t blockpos,
+                 unsigned int maxchan, int matrix_noise_shift,
+                 int access_unit_size_pow2, int32_t mask);
+
+    for (i = 0; i < MAX_CHANNELS; i++)
+        coeff_val[i] = sign_extend(rnd(), 18);
+    for (i = 0; i < MAX_BLOCKSIZE * MAX_CHANNELS; i++) {
+        samples[i] = sign_extend(rnd(), 24);
+        lsbs[i]    = rnd() & 3;
+    }
+    for (i = 0; i < 1 << 8; i++)
+        noise[i] = rnd();
+
+    for (maxchan = 0; maxchan < MAX_CHANNELS; maxchan++) {
+        unsigned int dest_ch = rnd() % (maxchan + 1);
+        int noise_shift = maxchan & 1 ? rnd() % 16 : 0;
+        int index       = rnd() & 0xFF;
+        int32_t mask    = -1U << (rnd() % 8);
+        uint16_t blockpos = 1 + rnd() % MAX_BLOCKSIZE;
+
+        /* the decoder leaves the coefficients above maxchan at 0 */
+        for (i = 0; i < MAX_CHANNELS; i++)
+            coeffs[i] = i <= maxchan ? coeff_val[i] : 0;
+        memcpy(buf0, samples, sizeof(*samples) * MAX_BLOCKSIZE * MAX_CHANNELS);
+        memcpy(buf1, samples, sizeof(*samples) * MAX_BLOCKSIZE * MAX_CHANNELS);
+
+        call_ref(buf0, coeffs, lsbs + dest_ch, noise, index, dest_ch,
+                 blockpos, maxchan, noise_shift, 1 << 8, mask);
+        call_new(buf1, coeffs, lsbs + dest_ch, noise, index, dest_ch,
+                 blockpos, maxchan, noise_shift, 1 << 8, mask);
+        if (memcmp(buf0, buf1, sizeof(*buf0) * MAX_BLOCKSIZE * MAX_CHANNELS))
+            fail();
+    }
+    bench_new(buf1, coeffs, lsbs, noise, 0, 0, MAX_BLOCKSIZE,
+              MAX_CHANNELS - 1, 1, 1 << 8, -1);
+}
+
+void checkasm_check_mlpdsp(void)
+{
+    MLPDSPContext c;
+
+    ff_mlpdsp_init(&c);
+
+    if (check_func(c.mlp_filter_channel, "mlp_filter_channel"))
+        check_filter_channel();
+    report("mlp_filter_channel");
+
+    if (check_func(c.mlp_rematrix_channel, "mlp_rematrix_channel"))
+        check_rematrix_channel();
+    report("mlp_rematrix_channel");
+}
@@ -65,6 +65,11 @@ fate-mpeg12framerate: libavcodec/tests/mpeg12framerate$(EXESUF)
 fate-mpeg12framerate: CMD = run libavcodec/tests/mpeg12framerate$(EXESUF)
 fate-mpeg12framerate: REF = /dev/null
 
+FATE_LIBAVCODEC-yes += fate-catchup
+fate-catchup: libavcodec/tests/catchup$(EXESUF)
+fate-catchup: CMD = run libavcodec/tests/catchup$(EXESUF)
+fate-catchup: REF = /dev/null
+
 FATE_LIBAVCODEC-yes += fate-libavcodec-options
 fate-libavcodec-options: libavcodec/tests/options$(EXESUF)
 fate-libavcodec-options: CMD = run libavcodec/tests/options$(EXESUF)
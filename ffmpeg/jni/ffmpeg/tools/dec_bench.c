@@ -0,0 +1,215 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * Compare the decoding speed and delay of several decoder configurations,
+ * e.g. the threading options of libdav1d.
+ * make tools/dec_bench
+ * tools/dec_bench [-a] [-c decoder] [-n frames] -o key=value[:key=value]... input
+ * Each -o adds a configuration, the input is decoded once per configuration.
+ * A checksum of the decoded data is printed, so configurations which must
+ * give the same output can be checked too.
+ */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libavutil/adler32.h"
+#include "libavutil/common.h"
+#include "libavutil/dict.h"
+#include "libavutil/imgutils.h"
+#include "libavutil/pixdesc.h"
+#include "libavutil/time.h"
+#include "libavcodec/avcodec.h"
+#include "libavformat/avformat.h"
+
+#define MAX_CONFIGS 32
+
+typedef struct Result {
+    int64_t frames;
+    int64_t time;   ///< decoding time in us
+    int64_t delay;  ///< packets sent before the first frame was returned
+    unsigned long checksum; ///< adler32 of the decoded data
+} Result;
+
+static int usage(void)
+{
+    fprintf(stderr, "Usage: dec_bench [-a] [-c decoder] [-n frames] -o key=value[:key=value]... input\n"
+                    "-a          decode the audio instead of the video stream\n"
+                    "-c decoder  use this decoder instead of the default one\n"
+                    "-n frames   stop after this many frames\n"
+                    "-o options  decoder options of a configuration, may be repeated\n");
+    return 1;
+}
+
+static unsigned long frame_checksum(unsigned long checksum, const AVFrame *frame)
+{
+    int p;
+
+    if (frame->nb_samples) {
+        int planar = av_sample_fmt_is_planar(frame->format);
+        int size   = frame->nb_samples * av_get_bytes_per_sample(frame->format) *
+                     (planar ? 1 : frame->channels);
+
+        for (p = 0; p < (planar ? frame->channels : 1); p++)
+            checksum = av_adler32_update(checksum, frame->extended_data[p], size);
+    } else {
+        const AVPixFmtDescriptor *desc = av_pix_fmt_desc_get(frame->format);
+
+        for (p = 0; p < 4 && frame->data[p]; p++) {
+            int w = av_image_get_linesize(frame->format, frame->width, p);
+            int h = frame->height;
+            int y;
+
+            if (desc && (p == 1 || p == 2) && !(desc->flags & AV_PIX_FMT_FLAG_PAL))
+                h = AV_CEIL_RSHIFT(h, desc->log2_chroma_h);
+            if (w <= 0)
+                break;
+            for (y = 0; y < h; y++)
+                checksum = av_adler32_update(checksum, frame->data[p] + y * frame->linesize[p], w);
+        }
+    }
+    return checksum;
+}
+
+static int bench(const char *input, const char *codec_name, const char *config,
+                 enum AVMediaType type, int64_t max_frames, Result *res)
+{
+    AVFormatContext *fmt_ctx = NULL;
+    AVCodecContext *dec_ctx = NULL;
+    AVDictionary *opts = NULL;
+    AVCodec *codec;
+    AVFrame *frame = av_frame_alloc();
+    AVPacket pkt;
+    int64_t t0, nb_pkts = 0;
+    int idx, eof = 0, ret;
+
+    memset(res, 0, sizeof(*res));
+    res->delay = -1;
+    res->checksum = 1;
+
+    if (!frame)
+        return AVERROR(ENOMEM);
+    if ((ret = avformat_open_input(&fmt_ctx, input, NULL, NULL)) < 0 ||
+        (ret = avformat_find_stream_info(fmt_ctx, NULL)) < 0)
+        goto end;
+    if ((ret = av_find_best_stream(fmt_ctx, type, -1, -1, &codec, 0)) < 0)
+        goto end;
+    idx = ret;
+    if (codec_name && !(codec = avcodec_find_decoder_by_name(codec_name))) {
+        ret = AVERROR_DECODER_NOT_FOUND;
+        goto end;
+    }
+
+    if (!(dec_ctx = avcodec_alloc_context3(codec))) {
+        ret = AVERROR(ENOMEM);
+        goto end;
+    }
+    if ((ret = avcodec_parameters_to_context(dec_ctx, fmt_ctx->streams[idx]->codecpar)) < 0 ||
+        (ret = av_dict_parse_string(&opts, config, "=", ":", 0)) < 0 ||
+        (ret = avcodec_open2(dec_ctx, codec, &opts)) < 0)
+        goto end;
+    if (av_dict_count(opts)) {
+        AVDictionaryEntry *e = NULL;
+
+        while ((e = av_dict_get(opts, "", e, AV_DICT_IGNORE_SUFFIX)))
+            fprintf(stderr, "Option %s not found.\n", e->key);
+        ret = AVERROR_OPTION_NOT_FOUND;
+        goto end;
+    }
+
+    t0 = av_gettime_relative();
+    while (!eof && res->frames < max_frames) {
+        eof = av_read_frame(fmt_ctx, &pkt) < 0;
+        if (!eof && pkt.stream_index != idx) {
+            av_packet_unref(&pkt);
+            continue;
+        }
+        ret = avcodec_send_packet(dec_ctx, eof ? NULL : &pkt);
+        if (!eof) {
+            av_packet_unref(&pkt);
+            nb_pkts++;
+        }
+        if (ret < 0 && ret != AVERROR_EOF)
+            goto end;
+        while (avcodec_receive_frame(dec_ctx, frame) >= 0) {
+            if (res->delay < 0)
+                res->delay = nb_pkts - 1;
+            res->frames++;
+            res->checksum = frame_checksum(res->checksum, frame);
+            av_frame_unref(frame);
+        }
+    }
+    res->time = av_gettime_relative() - t0;
+    ret = 0;
+
+end:
+    av_dict_free(&opts);
+    av_frame_free(&frame);
+    avcodec_free_context(&dec_ctx);
+    avformat_close_input(&fmt_ctx);
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    const char *configs[MAX_CONFIGS];
+    const char *input = NULL, *codec_name = NULL;
+    enum AVMediaType type = AVMEDIA_TYPE_VIDEO;
+    int64_t max_frames = INT64_MAX;
+    int nb_configs = 0, i, ret;
+
+    for (i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-a")) {
+            type = AVMEDIA_TYPE_AUDIO;
+        } else if (!strcmp(argv[i], "-c") && i + 1 < argc) {
+            codec_name = argv[++i];
+        } else if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+            max_frames = strtoll(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "-o") && i + 1 < argc && nb_configs < MAX_CONFIGS) {
+            configs[nb_configs++] = argv[++i];
+        } else if (!input && argv[i][0] != '-') {
+            input = argv[i];
+        } else {
+            return usage();
+        }
+    }
+    if (!input)
+        return usage();
+    if (!nb_configs)
+        configs[nb_configs++] = "";
+
+    printf("%-40s %8s %10s %8s %6s %8s\n", "config", "frames", "time (us)", "fps", "delay", "checksum");
+    for (i = 0; i < nb_configs; i++) {
+        Result res;
+
+        ret = bench(input, codec_name, configs[i], type, max_frames, &res);
+        if (ret < 0) {
+            fprintf(stderr, "%s: %s\n", configs[i], av_err2str(ret));
+            return 1;
+        }
+        printf("%-40s %8"PRId64" %10"PRId64" %8.1f %6"PRId64" %08lx\n",
+               configs[i][0] ? configs[i] : "(default)", res.frames, res.time,
+               res.time ? res.frames * 1000000.0 / res.time : 0.0, res.delay,
+               res.checksum);
+    }
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * Measure open time, demuxing speed, seek time and peak memory of a demuxer.
+ * make tools/demux_bench
+ * tools/demux_bench [-f fmt] [-o key=value]... [-p] [-s seeks] [-n maxpkts] input
+ */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if HAVE_GETRUSAGE
+#include <sys/time.h>
+#include <sys/resource.h>
+#endif
+
+#include "libavutil/dict.h"
+#include "libavutil/lfg.h"
+#include "libavutil/time.h"
+#include "libavformat/avformat.h"
+
+static int64_t peak_rss_kb(void)
+{
+#if HAVE_GETRUSAGE
+    struct rusage rusage;
+    getrusage(RUSAGE_SELF, &rusage);
+    return rusage.ru_maxrss;
+#else
+    return -1;
+#endif
+}
+
+static int usage(void)
+{
+    fprintf(stderr, "Usage: demux_bench [-f fmt] [-o key=value]... [-p] [-s seeks] [-n maxpkts] input\n"
+                    "-f fmt        force the input format\n"
+                    "-o key=value  pass an option to the demuxer\n"
+                    "-p            run avformat_find_stream_info() after opening\n"
+                    "-s seeks      number of random seeks to time after demuxing\n"
+                    "-n maxpkts    stop demuxing after this many packets\n");
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    AVFormatContext *fmt_ctx = NULL;
+    AVInputFormat *ifmt = NULL;
+    AVDictionary *opts = NULL;
+    AVPacket pkt;
+    const char *input = NULL;
+    int probe = 0, nb_seeks = 0, i, ret;
+    int64_t max_pkts = INT64_MAX, nb_pkts = 0, bytes = 0;
+    int64_t t0, t_open, t_demux, t_seek = 0;
+
+    for (i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-f") && i + 1 < argc) {
+            if (!(ifmt = av_find_input_format(argv[++i]))) {
+                fprintf(stderr, "Unknown input format %s\n", argv[i]);
+                return 1;
+            }
+        } else if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+            if (av_dict_parse_string(&opts, argv[++i], "=", ":", 0) < 0)
+                return usage();
+        } else if (!strcmp(argv[i], "-p")) {
+            probe = 1;
+        } else if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+            nb_seeks = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+            max_pkts = strtoll(argv[++i], NULL, 0);
+        } else if (!input && argv[i][0] != '-') {
+            input = argv[i];
+        } else {
+            return usage();
+        }
+    }
+    if (!input)
+        return usage();
+
+    t0 = av_gettime_relative();
+    ret = avformat_open_input(&fmt_ctx, input, ifmt, &opts);
+    if (ret < 0) {
+        fprintf(stderr, "Cannot open %s: %s\n", input, av_err2str(ret));
+        return 1;
+    }
+    if (probe && (ret = avformat_find_stream_info(fmt_ctx, NULL)) < 0) {
+        fprintf(stderr, "Cannot find stream info: %s\n", av_err2str(ret));
+        goto end;
+    }
+    t_open = av_gettime_relative() - t0;
+    printf("open: %"PRId64" us, %u streams, peak rss %"PRId64" kB\n",
+           t_open, fmt_ctx->nb_streams, peak_rss_kb());
+
+    t0 = av_gettime_relative();
+    while (nb_pkts < max_pkts && av_read_frame(fmt_ctx, &pkt) >= 0) {
+        nb_pkts++;
+        bytes += pkt.size;
+        av_packet_unref(&pkt);
+    }
+    t_demux = av_gettime_relative() - t0;
+    printf("demux: %"PRId64" packets, %"PRId64" bytes in %"PRId64" us (%.1f MB/s)\n",
+           nb_pkts, bytes, t_demux, t_demux ? bytes / (double)t_demux : 0.0);
+
+    if (nb_seeks > 0 && fmt_ctx->duration > 0) {
+        AVLFG lfg;
+        av_lfg_init(&lfg, 0xdeadbeef);
+        for (i = 0; i < nb_seeks; i++) {
+            int64_t ts = av_rescale(av_lfg_get(&lfg), fmt_ctx->duration, UINT32_MAX);
+            if (fmt_ctx->start_time != AV_NOPTS_VALUE)
+                ts += fmt_ctx->start_time;
+            t0 = av_gettime_relative();
+            ret = avformat_seek_file(fmt_ctx, -1, INT64_MIN, ts, ts, 0);
+            if (ret >= 0 && av_read_frame(fmt_ctx, &pkt) >= 0)
+                av_packet_unref(&pkt);
+            t_seek += av_gettime_relative() - t0;
+        }
+        printf("seek: %d seeks, %"PRId64" us average\n", nb_seeks, t_seek / nb_seeks);
+    }
+    printf("peak rss: %"PRId64" kB\n", peak_rss_kb());
+    ret = 0;
+
+end:
+    avformat_close_input(&fmt_ctx);
+    av_dict_free(&opts);
+    return ret < 0;
+}
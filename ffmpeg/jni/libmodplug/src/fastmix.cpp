@@ -9,6 +9,22 @@
 #include "sndfile.h"
 #include <math.h>
 
+// SIMD interpolators: SSE2 is checked at run time on x86, NEON builds
+// presume NEON (see CSoundFile::InitSysInfo)
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+#define MODPLUG_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) && !defined(__SSE2__)
+#define MPPSIMDCALL		__attribute__((target("sse2")))
+#endif
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON) || defined(__aarch64__)
+#define MODPLUG_NEON
+#include <arm_neon.h>
+#endif
+#ifndef MPPSIMDCALL
+#define MPPSIMDCALL
+#endif
+
 #ifdef MSC_VER
 #pragma bss_seg(".modplug")
 #endif
@@ -1251,6 +1267,488 @@ END_RAMPMIX_STFLT_INTERFACE()
 
 #endif
 
+/////////////////////////////////////////////////////
+// SIMD interpolators
+//
+// Same arithmetic as the SNDMIX_GET*SPLINE and SNDMIX_GET*FIRFILTER macros,
+// the products are summed in a different order which gives the same 32-bit
+// result. Stereo samples are interpolated for both channels at once.
+
+#if defined(MODPLUG_SSE2) || defined(MODPLUG_NEON)
+#define MODPLUG_SIMD
+
+#if defined(MODPLUG_SSE2)
+
+static inline MPPSIMDCALL __m128i SSE2_Widen8(__m128i x)
+{
+	return _mm_srai_epi16(_mm_unpacklo_epi8(x, x), 8);
+}
+
+// 4 mono samples * 4 coefs, summed
+static inline MPPSIMDCALL int SSE2_MonoDot4(__m128i smp, const signed short *lut)
+{
+	__m128i s = _mm_madd_epi16(smp, _mm_loadl_epi64((const __m128i *)lut));
+	s = _mm_add_epi32(s, _mm_srli_si128(s, 4));
+	return _mm_cvtsi128_si32(s);
+}
+
+// 4 stereo samples * 4 coefs (c0 c1 c0 c1 c2 c3 c2 c3), left sum in lane 0,
+// right sum in lane 1
+static inline MPPSIMDCALL __m128i SSE2_StereoDot4(__m128i smp, __m128i coefs)
+{
+	smp = _mm_shufflelo_epi16(smp, _MM_SHUFFLE(3,1,2,0));
+	smp = _mm_shufflehi_epi16(smp, _MM_SHUFFLE(3,1,2,0));
+	__m128i s = _mm_madd_epi16(smp, coefs);
+	return _mm_add_epi32(s, _mm_srli_si128(s, 8));
+}
+
+static inline MPPSIMDCALL void SSE2_StoreStereo(__m128i s, int &vol_l, int &vol_r)
+{
+	vol_l = _mm_cvtsi128_si32(s);
+	vol_r = _mm_cvtsi128_si32(_mm_srli_si128(s, 4));
+}
+
+static inline MPPSIMDCALL int SIMD_MonoSpline8(const signed char *p, const signed short *lut)
+{
+	int smp;
+	memcpy(&smp, p, 4);
+	return SSE2_MonoDot4(SSE2_Widen8(_mm_cvtsi32_si128(smp)), lut) >> SPLINE_8SHIFT;
+}
+
+static inline MPPSIMDCALL int SIMD_MonoSpline16(const signed short *p, const signed short *lut)
+{
+	return SSE2_MonoDot4(_mm_loadl_epi64((const __m128i *)p), lut) >> SPLINE_16SHIFT;
+}
+
+static inline MPPSIMDCALL int SIMD_MonoFir8(const signed char *p, const signed short *lut)
+{
+	__m128i s = _mm_madd_epi16(SSE2_Widen8(_mm_loadl_epi64((const __m128i *)p)),
+	                           _mm_loadu_si128((const __m128i *)lut));
+	s = _mm_add_epi32(s, _mm_srli_si128(s, 8));
+	s = _mm_add_epi32(s, _mm_srli_si128(s, 4));
+	return _mm_cvtsi128_si32(s) >> WFIR_8SHIFT;
+}
+
+static inline MPPSIMDCALL int SIMD_MonoFir16(const signed short *p, const signed short *lut)
+{
+	__m128i s = _mm_madd_epi16(_mm_loadu_si128((const __m128i *)p),
+	                           _mm_loadu_si128((const __m128i *)lut));
+	// vol1 (taps 0-3) in lane 0, vol2 (taps 4-7) in lane 2
+	s = _mm_srai_epi32(_mm_add_epi32(s, _mm_srli_si128(s, 4)), 1);
+	s = _mm_add_epi32(s, _mm_srli_si128(s, 8));
+	return _mm_cvtsi128_si32(s) >> (WFIR_16BITSHIFT-1);
+}
+
+static inline MPPSIMDCALL void SIMD_StereoSpline8(const signed char *p, const signed short *lut, int &vol_l, int &vol_r)
+{
+	__m128i c = _mm_loadl_epi64((const __m128i *)lut);
+	__m128i s = SSE2_StereoDot4(SSE2_Widen8(_mm_loadl_epi64((const __m128i *)p)), _mm_unpacklo_epi32(c, c));
+	SSE2_StoreStereo(_mm_srai_epi32(s, SPLINE_8SHIFT), vol_l, vol_r);
+}
+
+static inline MPPSIMDCALL void SIMD_StereoSpline16(const signed short *p, const signed short *lut, int &vol_l, int &vol_r)
+{
+	__m128i c = _mm_loadl_epi64((const __m128i *)lut);
+	__m128i s = SSE2_StereoDot4(_mm_loadu_si128((const __m128i *)p), _mm_unpacklo_epi32(c, c));
+	SSE2_StoreStereo(_mm_srai_epi32(s, SPLINE_16SHIFT), vol_l, vol_r);
+}
+
+static inline MPPSIMDCALL void SIMD_StereoFir8(const signed char *p, const signed short *lut, int &vol_l, int &vol_r)
+{
+	__m128i c = _mm_loadu_si128((const __m128i *)lut);
+	__m128i x = _mm_loadu_si128((const __m128i *)p);
+	__m128i s1 = SSE2_StereoDot4(_mm_srai_epi16(_mm_unpacklo_epi8(x, x), 8), _mm_unpacklo_epi32(c, c));
+	__m128i s2 = SSE2_StereoDot4(_mm_srai_epi16(_mm_unpackhi_epi8(x, x), 8), _mm_unpackhi_epi32(c, c));
+	SSE2_StoreStereo(_mm_srai_epi32(_mm_add_epi32(s1, s2), WFIR_8SHIFT), vol_l, vol_r);
+}
+
+static inline MPPSIMDCALL void SIMD_StereoFir16(const signed short *p, const signed short *lut, int &vol_l, int &vol_r)
+{
+	__m128i c = _mm_loadu_si128((const __m128i *)lut);
+	__m128i vol1 = SSE2_StereoDot4(_mm_loadu_si128((const __m128i *)p), _mm_unpacklo_epi32(c, c));
+	__m128i vol2 = SSE2_StereoDot4(_mm_loadu_si128((const __m128i *)(p+8)), _mm_unpackhi_epi32(c, c));
+	__m128i s = _mm_add_epi32(_mm_srai_epi32(vol1, 1), _mm_srai_epi32(vol2, 1));
+	SSE2_StoreStereo(_mm_srai_epi32(s, WFIR_16BITSHIFT-1), vol_l, vol_r);
+}
+
+#else // MODPLUG_NEON
+
+static inline int NEON_Sum(int32x4_t s)
+{
+	int32x2_t t = vadd_s32(vget_low_s32(s), vget_high_s32(s));
+	return vget_lane_s32(vpadd_s32(t, t), 0);
+}
+
+// left sum in lane 0, right sum in lane 1
+static inline int32x2_t NEON_SumStereo(int32x4_t l, int32x4_t r)
+{
+	return vpadd_s32(vadd_s32(vget_low_s32(l), vget_high_s32(l)),
+	                 vadd_s32(vget_low_s32(r), vget_high_s32(r)));
+}
+
+static inline int32x4_t NEON_Dot8(int16x8_t smp, int16x8_t c)
+{
+	return vmlal_s16(vmull_s16(vget_low_s16(smp), vget_low_s16(c)), vget_high_s16(smp), vget_high_s16(c));
+}
+
+static inline int SIMD_MonoSpline8(const signed char *p, const signed short *lut)
+{
+	int smp;
+	memcpy(&smp, p, 4);
+	int16x4_t x = vget_low_s16(vmovl_s8(vreinterpret_s8_s32(vdup_n_s32(smp))));
+	return NEON_Sum(vmull_s16(x, vld1_s16(lut))) >> SPLINE_8SHIFT;
+}
+
+static inline int SIMD_MonoSpline16(const signed short *p, const signed short *lut)
+{
+	return NEON_Sum(vmull_s16(vld1_s16(p), vld1_s16(lut))) >> SPLINE_16SHIFT;
+}
+
+static inline int SIMD_MonoFir8(const signed char *p, const signed short *lut)
+{
+	return NEON_Sum(NEON_Dot8(vmovl_s8(vld1_s8(p)), vld1q_s16(lut))) >> WFIR_8SHIFT;
+}
+
+static inline int SIMD_MonoFir16(const signed short *p, const signed short *lut)
+{
+	int16x8_t x = vld1q_s16(p), c = vld1q_s16(lut);
+	int vol1 = NEON_Sum(vmull_s16(vget_low_s16(x), vget_low_s16(c)));
+	int vol2 = NEON_Sum(vmull_s16(vget_high_s16(x), vget_high_s16(c)));
+	return ((vol1>>1)+(vol2>>1)) >> (WFIR_16BITSHIFT-1);
+}
+
+static inline void SIMD_StereoSpline8(const signed char *p, const signed short *lut, int &vol_l, int &vol_r)
+{
+	int16x8_t x = vmovl_s8(vld1_s8(p));
+	int16x4x2_t lr = vuzp_s16(vget_low_s16(x), vget_high_s16(x));
+	int16x4_t c = vld1_s16(lut);
+	int32x2_t s = vshr_n_s32(NEON_SumStereo(vmull_s16(lr.val[0], c), vmull_s16(lr.val[1], c)), SPLINE_8SHIFT);
+	vol_l = vget_lane_s32(s, 0);
+	vol_r = vget_lane_s32(s, 1);
+}
+
+static inline void SIMD_StereoSpline16(const signed short *p, const signed short *lut, int &vol_l, int &vol_r)
+{
+	int16x4x2_t lr = vld2_s16(p);
+	int16x4_t c = vld1_s16(lut);
+	int32x2_t s = vshr_n_s32(NEON_SumStereo(vmull_s16(lr.val[0], c), vmull_s16(lr.val[1], c)), SPLINE_16SHIFT);
+	vol_l = vget_lane_s32(s, 0);
+	vol_r = vget_lane_s32(s, 1);
+}
+
+static inline void SIMD_StereoFir8(const signed char *p, const signed short *lut, int &vol_l, int &vol_r)
+{
+	int8x8x2_t lr = vld2_s8(p);
+	int16x8_t c = vld1q_s16(lut);
+	int32x2_t s = NEON_SumStereo(NEON_Dot8(vmovl_s8(lr.val[0]), c), NEON_Dot8(vmovl_s8(lr.val[1]), c));
+	s = vshr_n_s32(s, WFIR_8SHIFT);
+	vol_l = vget_lane_s32(s, 0);
+	vol_r = vget_lane_s32(s, 1);
+}
+
+static inline void SIMD_StereoFir16(const signed short *p, const signed short *lut, int &vol_l, int &vol_r)
+{
+	int16x8x2_t lr = vld2q_s16(p);
+	int16x8_t c = vld1q_s16(lut);
+	int32x2_t vol1 = NEON_SumStereo(vmull_s16(vget_low_s16(lr.val[0]), vget_low_s16(c)),
+	                                vmull_s16(vget_low_s16(lr.val[1]), vget_low_s16(c)));
+	int32x2_t vol2 = NEON_SumStereo(vmull_s16(vget_high_s16(lr.val[0]), vget_high_s16(c)),
+	                                vmull_s16(vget_high_s16(lr.val[1]), vget_high_s16(c)));
+	int32x2_t s = vshr_n_s32(vadd_s32(vshr_n_s32(vol1, 1), vshr_n_s32(vol2, 1)), WFIR_16BITSHIFT-1);
+	vol_l = vget_lane_s32(s, 0);
+	vol_r = vget_lane_s32(s, 1);
+}
+
+#endif // MODPLUG_SSE2
+
+#define SNDMIX_GETMONOVOL8SIMDSPLINE \
+	int poshi	= nPos >> 16; \
+	int poslo	= (nPos >> SPLINE_FRACSHIFT) & SPLINE_FRACMASK; \
+	int vol		= SIMD_MonoSpline8(p+poshi-1, CzCUBICSPLINE::lut+poslo);
+
+#define SNDMIX_GETMONOVOL16SIMDSPLINE \
+	int poshi	= nPos >> 16; \
+	int poslo	= (nPos >> SPLINE_FRACSHIFT) & SPLINE_FRACMASK; \
+	int vol		= SIMD_MonoSpline16(p+poshi-1, CzCUBICSPLINE::lut+poslo);
+
+#define SNDMIX_GETMONOVOL8SIMDFIRFILTER \
+	int poshi  = nPos >> 16;\
+	int poslo  = (nPos & 0xFFFF);\
+	int firidx = ((poslo+WFIR_FRACHALVE)>>WFIR_FRACSHIFT) & WFIR_FRACMASK; \
+	int vol    = SIMD_MonoFir8(p+poshi+1-4, CzWINDOWEDFIR::lut+firidx);
+
+#define SNDMIX_GETMONOVOL16SIMDFIRFILTER \
+	int poshi  = nPos >> 16;\
+	int poslo  = (nPos & 0xFFFF);\
+	int firidx = ((poslo+WFIR_FRACHALVE)>>WFIR_FRACSHIFT) & WFIR_FRACMASK; \
+	int vol    = SIMD_MonoFir16(p+poshi+1-4, CzWINDOWEDFIR::lut+firidx);
+
+#define SNDMIX_GETSTEREOVOL8SIMDSPLINE \
+	int poshi	= nPos >> 16; \
+	int poslo	= (nPos >> SPLINE_FRACSHIFT) & SPLINE_FRACMASK; \
+	int vol_l, vol_r; \
+	SIMD_StereoSpline8(p+(poshi-1)*2, CzCUBICSPLINE::lut+poslo, vol_l, vol_r);
+
+#define SNDMIX_GETSTEREOVOL16SIMDSPLINE \
+	int poshi	= nPos >> 16; \
+	int poslo	= (nPos >> SPLINE_FRACSHIFT) & SPLINE_FRACMASK; \
+	int vol_l, vol_r; \
+	SIMD_StereoSpline16(p+(poshi-1)*2, CzCUBICSPLINE::lut+poslo, vol_l, vol_r);
+
+#define SNDMIX_GETSTEREOVOL8SIMDFIRFILTER \
+	int poshi   = nPos >> 16;\
+	int poslo   = (nPos & 0xFFFF);\
+	int firidx  = ((poslo+WFIR_FRACHALVE)>>WFIR_FRACSHIFT) & WFIR_FRACMASK; \
+	int vol_l, vol_r; \
+	SIMD_StereoFir8(p+(poshi+1-4)*2, CzWINDOWEDFIR::lut+firidx, vol_l, vol_r);
+
+#define SNDMIX_GETSTEREOVOL16SIMDFIRFILTER \
+	int poshi   = nPos >> 16;\
+	int poslo   = (nPos & 0xFFFF);\
+	int firidx  = ((poslo+WFIR_FRACHALVE)>>WFIR_FRACSHIFT) & WFIR_FRACMASK; \
+	int vol_l, vol_r; \
+	SIMD_StereoFir16(p+(poshi+1-4)*2, CzWINDOWEDFIR::lut+firidx, vol_l, vol_r);
+
+// Mono
+MPPSIMDCALL BEGIN_MIX_INTERFACE(SIMDMono8BitSplineMix)
+	SNDMIX_BEGINSAMPLELOOP8
+	SNDMIX_GETMONOVOL8SIMDSPLINE
+	SNDMIX_STOREMONOVOL
+END_MIX_INTERFACE()
+
+MPPSIMDCALL BEGIN_MIX_INTERFACE(SIMDMono16BitSplineMix)
+	SNDMIX_BEGINSAMPLELOOP16
+	SNDMIX_GETMONOVOL16SIMDSPLINE
+	SNDMIX_STOREMONOVOL
+END_MIX_INTERFACE()
+
+MPPSIMDCALL BEGIN_MIX_INTERFACE(SIMDMono8BitFirFilterMix)
+	SNDMIX_BEGINSAMPLELOOP8
+	SNDMIX_GETMONOVOL8SIMDFIRFILTER
+	SNDMIX_STOREMONOVOL
+END_MIX_INTERFACE()
+
+MPPSIMDCALL BEGIN_MIX_INTERFACE(SIMDMono16BitFirFilterMix)
+	SNDMIX_BEGINSAMPLELOOP16
+	SNDMIX_GETMONOVOL16SIMDFIRFILTER
+	SNDMIX_STOREMONOVOL
+END_MIX_INTERFACE()
+
+MPPSIMDCALL BEGIN_RAMPMIX_INTERFACE(SIMDMono8BitSplineRampMix)
+	SNDMIX_BEGINSAMPLELOOP8
+	SNDMIX_GETMONOVOL8SIMDSPLINE
+	SNDMIX_RAMPMONOVOL
+END_RAMPMIX_INTERFACE()
+
+MPPSIMDCALL BEGIN_RAMPMIX_INTERFACE(SIMDMono16BitSplineRampMix)
+	SNDMIX_BEGINSAMPLELOOP16
+	SNDMIX_GETMONOVOL16SIMDSPLINE
+	SNDMIX_RAMPMONOVOL
+END_RAMPMIX_INTERFACE()
+
+MPPSIMDCALL BEGIN_RAMPMIX_INTERFACE(SIMDMono8BitFirFilterRampMix)
+	SNDMIX_BEGINSAMPLELOOP8
+	SNDMIX_GETMONOVOL8SIMDFIRFILTER
+	SNDMIX_RAMPMONOVOL
+END_RAMPMIX_INTERFACE()
+
+MPPSIMDCALL BEGIN_RAMPMIX_INTERFACE(SIMDMono16BitFirFilterRampMix)
+	SNDMIX_BEGINSAMPLELOOP16
+	SNDMIX_GETMONOVOL16SIMDFIRFILTER
+	SNDMIX_RAMPMONOVOL
+END_RAMPMIX_INTERFACE()
+
+
+// Stereo
+MPPSIMDCALL BEGIN_MIX_INTERFACE(SIMDStereo8BitSplineMix)
+	SNDMIX_BEGINSAMPLELOOP8
+	SNDMIX_GETSTEREOVOL8SIMDSPLINE
+	SNDMIX_STORESTEREOVOL
+END_MIX_INTERFACE()
+
+MPPSIMDCALL BEGIN_MIX_INTERFACE(SIMDStereo16BitSplineMix)
+	SNDMIX_BEGINSAMPLELOOP16
+	SNDMIX_GETSTEREOVOL16SIMDSPLINE
+	SNDMIX_STORESTEREOVOL
+END_MIX_INTERFACE()
+
+MPPSIMDCALL BEGIN_MIX_INTERFACE(SIMDStereo8BitFirFilterMix)
+	SNDMIX_BEGINSAMPLELOOP8
+	SNDMIX_GETSTEREOVOL8SIMDFIRFILTER
+	SNDMIX_STORESTEREOVOL
+END_MIX_INTERFACE()
+
+MPPSIMDCALL BEGIN_MIX_INTERFACE(SIMDStereo16BitFirFilterMix)
+	SNDMIX_BEGINSAMPLELOOP16
+	SNDMIX_GETSTEREOVOL16SIMDFIRFILTER
+	SNDMIX_STORESTEREOVOL
+END_MIX_INTERFACE()
+
+MPPSIMDCALL BEGIN_RAMPMIX_INTERFACE(SIMDStereo8BitSplineRampMix)
+	SNDMIX_BEGINSAMPLELOOP8
+	SNDMIX_GETSTEREOVOL8SIMDSPLINE
+	SNDMIX_RAMPSTEREOVOL
+END_RAMPMIX_INTERFACE()
+
+MPPSIMDCALL BEGIN_RAMPMIX_INTERFACE(SIMDStereo16BitSplineRampMix)
+	SNDMIX_BEGINSAMPLELOOP16
+	SNDMIX_GETSTEREOVOL16SIMDSPLINE
+	SNDMIX_RAMPSTEREOVOL
+END_RAMPMIX_INTERFACE()
+
+MPPSIMDCALL BEGIN_RAMPMIX_INTERFACE(SIMDStereo8BitFirFilterRampMix)
+	SNDMIX_BEGINSAMPLELOOP8
+	SNDMIX_GETSTEREOVOL8SIMDFIRFILTER
+	SNDMIX_RAMPSTEREOVOL
+END_RAMPMIX_INTERFACE()
+
+MPPSIMDCALL BEGIN_RAMPMIX_INTERFACE(SIMDStereo16BitFirFilterRampMix)
+	SNDMIX_BEGINSAMPLELOOP16
+	SNDMIX_GETSTEREOVOL16SIMDFIRFILTER
+	SNDMIX_RAMPSTEREOVOL
+END_RAMPMIX_INTERFACE()
+
+
+#ifndef NO_FILTER
+
+// Mono Filter
+MPPSIMDCALL BEGIN_MIX_FLT_INTERFACE(SIMDFilterMono8BitSplineMix)
+	SNDMIX_BEGINSAMPLELOOP8
+	SNDMIX_GETMONOVOL8SIMDSPLINE
+	SNDMIX_PROCESSFILTER
+	SNDMIX_STOREMONOVOL
+END_MIX_FLT_INTERFACE()
+
+MPPSIMDCALL BEGIN_MIX_FLT_INTERFACE(SIMDFilterMono16BitSplineMix)
+	SNDMIX_BEGINSAMPLELOOP16
+	SNDMIX_GETMONOVOL16SIMDSPLINE
+	SNDMIX_PROCESSFILTER
+	SNDMIX_STOREMONOVOL
+END_MIX_FLT_INTERFACE()
+
+MPPSIMDCALL BEGIN_MIX_FLT_INTERFACE(SIMDFilterMono8BitFirFilterMix)
+	SNDMIX_BEGINSAMPLELOOP8
+	SNDMIX_GETMONOVOL8SIMDFIRFILTER
+	SNDMIX_PROCESSFILTER
+	SNDMIX_STOREMONOVOL
+END_MIX_FLT_INTERFACE()
+
+MPPSIMDCALL BEGIN_MIX_FLT_INTERFACE(SIMDFilterMono16BitFirFilterMix)
+	SNDMIX_BEGINSAMPLELOOP16
+	SNDMIX_GETMONOVOL16SIMDFIRFILTER
+	SNDMIX_PROCESSFILTER
+	SNDMIX_STOREMONOVOL
+END_MIX_FLT_INTERFACE()
+
+MPPSIMDCALL BEGIN_RAMPMIX_FLT_INTERFACE(SIMDFilterMono8BitSplineRampMix)
+	SNDMIX_BEGINSAMPLELOOP8
+	SNDMIX_GETMONOVOL8SIMDSPLINE
+	SNDMIX_PROCESSFILTER
+	SNDMIX_RAMPMONOVOL
+END_RAMPMIX_FLT_INTERFACE()
+
+MPPSIMDCALL BEGIN_RAMPMIX_FLT_INTERFACE(SIMDFilterMono16BitSplineRampMix)
+	SNDMIX_BEGINSAMPLELOOP16
+	SNDMIX_GETMONOVOL16SIMDSPLINE
+	SNDMIX_PROCESSFILTER
+	SNDMIX_RAMPMONOVOL
+END_RAMPMIX_FLT_INTERFACE()
+
+MPPSIMDCALL BEGIN_RAMPMIX_FLT_INTERFACE(SIMDFilterMono8BitFirFilterRampMix)
+	SNDMIX_BEGINSAMPLELOOP8
+	SNDMIX_GETMONOVOL8SIMDFIRFILTER
+	SNDMIX_PROCESSFILTER
+	SNDMIX_RAMPMONOVOL
+END_RAMPMIX_FLT_INTERFACE()
+
+MPPSIMDCALL BEGIN_RAMPMIX_FLT_INTERFACE(SIMDFilterMono16BitFirFilterRampMix)
+	SNDMIX_BEGINSAMPLELOOP16
+	SNDMIX_GETMONOVOL16SIMDFIRFILTER
+	SNDMIX_PROCESSFILTER
+	SNDMIX_RAMPMONOVOL
+END_RAMPMIX_FLT_INTERFACE()
+
+
+// Stereo Filter
+MPPSIMDCALL BEGIN_MIX_STFLT_INTERFACE(SIMDFilterStereo8BitSplineMix)
+	SNDMIX_BEGINSAMPLELOOP8
+	SNDMIX_GETSTEREOVOL8SIMDSPLINE
+	SNDMIX_PROCESSSTEREOFILTER
+	SNDMIX_STORESTEREOVOL
+END_MIX_STFLT_INTERFACE()
+
+MPPSIMDCALL BEGIN_MIX_STFLT_INTERFACE(SIMDFilterStereo16BitSplineMix)
+	SNDMIX_BEGINSAMPLELOOP16
+	SNDMIX_GETSTEREOVOL16SIMDSPLINE
+	SNDMIX_PROCESSSTEREOFILTER
+	SNDMIX_STORESTEREOVOL
+END_MIX_STFLT_INTERFACE()
+
+MPPSIMDCALL BEGIN_MIX_STFLT_INTERFACE(SIMDFilterStereo8BitFirFilterMix)
+	SNDMIX_BEGINSAMPLELOOP8
+	SNDMIX_GETSTEREOVOL8SIMDFIRFILTER
+	SNDMIX_PROCESSSTEREOFILTER
+	SNDMIX_STORESTEREOVOL
+END_MIX_STFLT_INTERFACE()
+
+MPPSIMDCALL BEGIN_MIX_STFLT_INTERFACE(SIMDFilterStereo16BitFirFilterMix)
+	SNDMIX_BEGINSAMPLELOOP16
+	SNDMIX_GETSTEREOVOL16SIMDFIRFILTER
+	SNDMIX_PROCESSSTEREOFILTER
+	SNDMIX_STORESTEREOVOL
+END_MIX_STFLT_INTERFACE()
+
+MPPSIMDCALL BEGIN_RAMPMIX_STFLT_INTERFACE(SIMDFilterStereo8BitSplineRampMix)
+	SNDMIX_BEGINSAMPLELOOP8
+	SNDMIX_GETSTEREOVOL8SIMDSPLINE
+	SNDMIX_PROCESSSTEREOFILTER
+	SNDMIX_RAMPSTEREOVOL
+END_RAMPMIX_STFLT_INTERFACE()
+
+MPPSIMDCALL BEGIN_RAMPMIX_STFLT_INTERFACE(SIMDFilterStereo16BitSplineRampMix)
+	SNDMIX_BEGINSAMPLELOOP16
+	SNDMIX_GETSTEREOVOL16SIMDSPLINE
+	SNDMIX_PROCESSSTEREOFILTER
+	SNDMIX_RAMPSTEREOVOL
+END_RAMPMIX_STFLT_INTERFACE()
+
+MPPSIMDCALL BEGIN_RAMPMIX_STFLT_INTERFACE(SIMDFilterStereo8BitFirFilterRampMix)
+	SNDMIX_BEGINSAMPLELOOP8
+	SNDMIX_GETSTEREOVOL8SIMDFIRFILTER
+	SNDMIX_PROCESSSTEREOFILTER
+	SNDMIX_RAMPSTEREOVOL
+END_RAMPMIX_STFLT_INTERFACE()
+
+MPPSIMDCALL BEGIN_RAMPMIX_STFLT_INTERFACE(SIMDFilterStereo16BitFirFilterRampMix)
+	SNDMIX_BEGINSAMPLELOOP16
+	SNDMIX_GETSTEREOVOL16SIMDFIRFILTER
+	SNDMIX_PROCESSSTEREOFILTER
+	SNDMIX_RAMPSTEREOVOL
+END_RAMPMIX_STFLT_INTERFACE()
+
+#else
+
+#define SIMDFilterMono8BitSplineMix	SIMDMono8BitSplineMix
+#define SIMDFilterMono16BitSplineMix	SIMDMono16BitSplineMix
+#define SIMDFilterMono8BitFirFilterMix	SIMDMono8BitFirFilterMix
+#define SIMDFilterMono16BitFirFilterMix	SIMDMono16BitFirFilterMix
+#define SIMDFilterMono8BitSplineRampMix	SIMDMono8BitSplineRampMix
+#define SIMDFilterMono16BitSplineRampMix	SIMDMono16BitSplineRampMix
+#define SIMDFilterMono8BitFirFilterRampMix	SIMDMono8BitFirFilterRampMix
+#define SIMDFilterMono16BitFirFilterRampMix	SIMDMono16BitFirFilterRampMix
+#define SIMDFilterStereo8BitSplineMix	SIMDStereo8BitSplineMix
+#define SIMDFilterStereo16BitSplineMix	SIMDStereo16BitSplineMix
+#define SIMDFilterStereo8BitFirFilterMix	SIMDStereo8BitFirFilterMix
+#define SIMDFilterStereo16BitFirFilterMix	SIMDStereo16BitFirFilterMix
+#define SIMDFilterStereo8BitSplineRampMix	SIMDStereo8BitSplineRampMix
+#define SIMDFilterStereo16BitSplineRampMix	SIMDStereo16BitSplineRampMix
+#define SIMDFilterStereo8BitFirFilterRampMix	SIMDStereo8BitFirFilterRampMix
+#define SIMDFilterStereo16BitFirFilterRampMix	SIMDStereo16BitFirFilterRampMix
+
+#endif // NO_FILTER
+
+#endif // MODPLUG_SIMD
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 // Mix function tables
@@ -1356,6 +1854,94 @@ const LPMIXINTERFACE gpFastMixFunctionTable[2*2*16] =
         FilterStereo8BitFirFilterRampMix, FilterStereo16BitFirFilterRampMix,
 };
 
+#ifdef MODPLUG_SIMD
+// Same tables using the SIMD interpolators
+const LPMIXINTERFACE gpMixFunctionTableSIMD[2*2*16] =
+{
+	// No SRC
+	Mono8BitMix, Mono16BitMix, Stereo8BitMix, Stereo16BitMix,
+	Mono8BitRampMix, Mono16BitRampMix, Stereo8BitRampMix, 
+            Stereo16BitRampMix,
+	// No SRC, Filter
+	FilterMono8BitMix, FilterMono16BitMix, FilterStereo8BitMix, 
+        FilterStereo16BitMix, FilterMono8BitRampMix, FilterMono16BitRampMix, 
+	FilterStereo8BitRampMix, FilterStereo16BitRampMix,
+	// Linear SRC
+	Mono8BitLinearMix, Mono16BitLinearMix, Stereo8BitLinearMix,
+	Stereo16BitLinearMix, Mono8BitLinearRampMix, Mono16BitLinearRampMix,
+	Stereo8BitLinearRampMix,Stereo16BitLinearRampMix,
+	// Linear SRC, Filter
+	FilterMono8BitLinearMix, FilterMono16BitLinearMix, 
+        FilterStereo8BitLinearMix, FilterStereo16BitLinearMix,
+	FilterMono8BitLinearRampMix, FilterMono16BitLinearRampMix,
+        FilterStereo8BitLinearRampMix, FilterStereo16BitLinearRampMix,
+
+	// Spline SRC
+	SIMDMono8BitSplineMix, SIMDMono16BitSplineMix, SIMDStereo8BitSplineMix, 
+        SIMDStereo16BitSplineMix, SIMDMono8BitSplineRampMix, SIMDMono16BitSplineRampMix,
+	SIMDStereo8BitSplineRampMix,SIMDStereo16BitSplineRampMix,
+	// Spline SRC, Filter
+	SIMDFilterMono8BitSplineMix, SIMDFilterMono16BitSplineMix, 
+        SIMDFilterStereo8BitSplineMix, SIMDFilterStereo16BitSplineMix,
+	SIMDFilterMono8BitSplineRampMix, SIMDFilterMono16BitSplineRampMix,
+        SIMDFilterStereo8BitSplineRampMix, SIMDFilterStereo16BitSplineRampMix,
+
+	// FirFilter  SRC
+	SIMDMono8BitFirFilterMix, SIMDMono16BitFirFilterMix, SIMDStereo8BitFirFilterMix,
+	SIMDStereo16BitFirFilterMix, SIMDMono8BitFirFilterRampMix, 
+        SIMDMono16BitFirFilterRampMix, SIMDStereo8BitFirFilterRampMix, 
+        SIMDStereo16BitFirFilterRampMix,
+	// FirFilter  SRC, Filter
+	SIMDFilterMono8BitFirFilterMix, SIMDFilterMono16BitFirFilterMix, 
+        SIMDFilterStereo8BitFirFilterMix, SIMDFilterStereo16BitFirFilterMix,
+	SIMDFilterMono8BitFirFilterRampMix, SIMDFilterMono16BitFirFilterRampMix,
+        SIMDFilterStereo8BitFirFilterRampMix, SIMDFilterStereo16BitFirFilterRampMix
+};
+
+const LPMIXINTERFACE gpFastMixFunctionTableSIMD[2*2*16] =
+{
+	// No SRC
+	FastMono8BitMix, FastMono16BitMix, Stereo8BitMix, Stereo16BitMix,
+	FastMono8BitRampMix, FastMono16BitRampMix, Stereo8BitRampMix,
+        Stereo16BitRampMix,
+	// No SRC, Filter
+	FilterMono8BitMix, FilterMono16BitMix, FilterStereo8BitMix, 
+        FilterStereo16BitMix, FilterMono8BitRampMix, FilterMono16BitRampMix,
+        FilterStereo8BitRampMix, FilterStereo16BitRampMix,
+	// Linear SRC
+	FastMono8BitLinearMix, FastMono16BitLinearMix, Stereo8BitLinearMix,
+        Stereo16BitLinearMix, FastMono8BitLinearRampMix, 
+        FastMono16BitLinearRampMix, Stereo8BitLinearRampMix, 
+        Stereo16BitLinearRampMix,
+	// Linear SRC, Filter
+	FilterMono8BitLinearMix, FilterMono16BitLinearMix, 
+        FilterStereo8BitLinearMix, FilterStereo16BitLinearMix,
+	FilterMono8BitLinearRampMix, FilterMono16BitLinearRampMix, 
+        FilterStereo8BitLinearRampMix, FilterStereo16BitLinearRampMix,
+
+	// Spline SRC
+	SIMDMono8BitSplineMix, SIMDMono16BitSplineMix, SIMDStereo8BitSplineMix, 
+        SIMDStereo16BitSplineMix, SIMDMono8BitSplineRampMix, SIMDMono16BitSplineRampMix,
+        SIMDStereo8BitSplineRampMix, SIMDStereo16BitSplineRampMix,
+	// Spline SRC, Filter
+	SIMDFilterMono8BitSplineMix, SIMDFilterMono16BitSplineMix, 
+        SIMDFilterStereo8BitSplineMix, SIMDFilterStereo16BitSplineMix,
+	SIMDFilterMono8BitSplineRampMix, SIMDFilterMono16BitSplineRampMix, 
+        SIMDFilterStereo8BitSplineRampMix, SIMDFilterStereo16BitSplineRampMix,
+
+	// FirFilter SRC
+	SIMDMono8BitFirFilterMix, SIMDMono16BitFirFilterMix, SIMDStereo8BitFirFilterMix,
+        SIMDStereo16BitFirFilterMix, SIMDMono8BitFirFilterRampMix, 
+        SIMDMono16BitFirFilterRampMix, SIMDStereo8BitFirFilterRampMix, 
+        SIMDStereo16BitFirFilterRampMix,
+	// FirFilter SRC, Filter
+	SIMDFilterMono8BitFirFilterMix, SIMDFilterMono16BitFirFilterMix, 
+        SIMDFilterStereo8BitFirFilterMix, SIMDFilterStereo16BitFirFilterMix,
+	SIMDFilterMono8BitFirFilterRampMix, SIMDFilterMono16BitFirFilterRampMix, 
+        SIMDFilterStereo8BitFirFilterRampMix, SIMDFilterStereo16BitFirFilterRampMix,
+};
+#endif
+
 
 /////////////////////////////////////////////////////////////////////////
 
@@ -1470,13 +2056,65 @@ static LONG MPPFASTCALL GetSampleCount(MODCHANNEL *pChn, LONG nSamples)
 }
 
 
+#if defined(MODPLUG_SSE2) && !defined(__x86_64__) && !defined(_M_X64)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__GNUC__)
+#include <cpuid.h>
+#endif
+
+static BOOL X86_HaveSSE2()
+//------------------------
+{
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 1);
+	return (info[3] & (1 << 26)) ? TRUE : FALSE;
+#elif defined(__GNUC__)
+	unsigned int eax, ebx, ecx, edx;
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return FALSE;
+	return (edx & bit_SSE2) ? TRUE : FALSE;
+#else
+	return FALSE;
+#endif
+}
+#endif
+
+
+DWORD CSoundFile::InitSysInfo()
+//-----------------------------
+{
+	DWORD d = gdwSysInfo & ~(SYSMIX_SSE2|SYSMIX_NEON);
+#if defined(MODPLUG_SSE2)
+#if defined(__x86_64__) || defined(_M_X64)
+	d |= SYSMIX_SSE2;
+#else
+	if (X86_HaveSSE2()) d |= SYSMIX_SSE2;
+#endif
+#elif defined(MODPLUG_NEON)
+	d |= SYSMIX_NEON;
+#endif
+	gdwSysInfo = d;
+	return d;
+}
+
+
 UINT CSoundFile::CreateStereoMix(int count)
 //-----------------------------------------
 {
 	LPLONG pOfsL, pOfsR;
 	DWORD nchused, nchmixed;
+	const LPMIXINTERFACE *pMixTable = gpMixFunctionTable;
+	const LPMIXINTERFACE *pFastMixTable = gpFastMixFunctionTable;
 
 	if (!count) return 0;
+#ifdef MODPLUG_SIMD
+	if ((gdwSoundSetup & SNDMIX_ENABLEMMX) && (gdwSysInfo & (SYSMIX_SSE2|SYSMIX_NEON)))
+	{
+		pMixTable = gpMixFunctionTableSIMD;
+		pFastMixTable = gpFastMixFunctionTableSIMD;
+	}
+#endif
 #ifndef MODPLUG_FASTSOUNDLIB
 	if (gnChannels > 2) X86_InitMixBuffer(MixRearBuffer, count*2);
 #endif
@@ -1514,10 +2152,10 @@ UINT CSoundFile::CreateStereoMix(int count)
 		if ((nFlags < 0x40) && (pChannel->nLeftVol == pChannel->nRightVol)
 		 && ((!pChannel->nRampLength) || (pChannel->nLeftRamp == pChannel->nRightRamp)))
 		{
-			pMixFuncTable = gpFastMixFunctionTable;
+			pMixFuncTable = pFastMixTable;
 		} else
 		{
-			pMixFuncTable = gpMixFunctionTable;
+			pMixFuncTable = pMixTable;
 		}
 		nsamples = count;
 #ifndef MODPLUG_NO_REVERB
@@ -1606,6 +2244,83 @@ UINT CSoundFile::CreateStereoMix(int count)
 }
 
 
+// Same as CreateStereoMix, but only moves the channels forward without mixing
+void CSoundFile::SkipStereoMix(int count)
+//---------------------------------------
+{
+	DWORD nchmixed = 0;
+
+	if (!count) return;
+	for (UINT nChn=0; nChn<m_nMixChannels; nChn++)
+	{
+		MODCHANNEL * const pChannel = &Chn[ChnMix[nChn]];
+		LONG nSmpCount;
+		int nsamples = count;
+		UINT naddmix = 0;
+
+		if (!pChannel->pCurrentSample) continue;
+		pChannel->nROfs = pChannel->nLOfs = 0;
+		pChannel->nFilter_Y1 = pChannel->nFilter_Y2 = 0;
+		pChannel->nFilter_Y3 = pChannel->nFilter_Y4 = 0;
+		do
+		{
+			UINT nrampsamples = nsamples;
+			if (pChannel->nRampLength > 0)
+			{
+				if ((LONG)nrampsamples > pChannel->nRampLength) nrampsamples = pChannel->nRampLength;
+			}
+			if ((nSmpCount = GetSampleCount(pChannel, nrampsamples)) <= 0)
+			{
+				pChannel->pCurrentSample = NULL;
+				pChannel->nLength = 0;
+				pChannel->nPos = 0;
+				pChannel->nPosLo = 0;
+				pChannel->nRampLength = 0;
+				pChannel->dwFlags &= ~CHN_PINGPONGFLAG;
+				break;
+			}
+			LONG delta = (pChannel->nInc * (LONG)nSmpCount) + (LONG)pChannel->nPosLo;
+			pChannel->nPosLo = delta & 0xFFFF;
+			pChannel->nPos += (delta >> 16);
+			// The mixer only ramps the channels it does mix
+			if (((nchmixed < m_nMaxMixChannels) || (gdwSoundSetup & SNDMIX_DIRECTTODISK))
+			 && ((pChannel->nRampLength) || (pChannel->nLeftVol|pChannel->nRightVol)))
+			{
+				if (pChannel->nRampLength)
+				{
+					pChannel->nRampRightVol += pChannel->nRightRamp * nSmpCount;
+					pChannel->nRampLeftVol += pChannel->nLeftRamp * nSmpCount;
+					pChannel->nRightVol = pChannel->nRampRightVol >> VOLUMERAMPPRECISION;
+					pChannel->nLeftVol = pChannel->nRampLeftVol >> VOLUMERAMPPRECISION;
+				}
+				naddmix = 1;
+			} else
+			{
+				naddmix = 0;
+			}
+			nsamples -= nSmpCount;
+			if (pChannel->nRampLength)
+			{
+				pChannel->nRampLength -= nSmpCount;
+				if (pChannel->nRampLength <= 0)
+				{
+					pChannel->nRampLength = 0;
+					pChannel->nRightVol = pChannel->nNewRightVol;
+					pChannel->nLeftVol = pChannel->nNewLeftVol;
+					pChannel->nRightRamp = pChannel->nLeftRamp = 0;
+					if ((pChannel->dwFlags & CHN_NOTEFADE) && (!(pChannel->nFadeOutVol)))
+					{
+						pChannel->nLength = 0;
+						pChannel->pCurrentSample = NULL;
+					}
+				}
+			}
+		} while (nsamples > 0);
+		nchmixed += naddmix;
+	}
+}
+
+
 #ifdef MSC_VER
 #pragma warning (disable:4100)
 #endif
@@ -1991,6 +2706,29 @@ DWORD MPPASMCALL X86_Convert32To32(LPVOID lp16, int *pBuffer, DWORD lSampleCount
 }
 #endif
 
+// Floating-point output: [-1,1) for the [MIXING_CLIPMIN,MIXING_CLIPMAX] range,
+// not clipped
+DWORD MPPASMCALL X86_Convert32ToFloat(LPVOID lpBuffer, int *pBuffer, DWORD lSampleCount, LPLONG lpMin, LPLONG lpMax)
+//------------------------------------------------------------------------------------------------------------
+{
+	const float fScale = 1.0f / (float)(MIXING_CLIPMAX+1);
+	int vumin = *lpMin, vumax = *lpMax;
+	float *p = (float *)lpBuffer;
+
+	for (UINT i=0; i<lSampleCount; i++)
+	{
+		int n = pBuffer[i];
+		vumin = (n < vumin) ? n : vumin;
+		vumax = (n > vumax) ? n : vumax;
+		p[i] = (float)n * fScale;
+	}
+	if (vumin < MIXING_CLIPMIN) vumin = MIXING_CLIPMIN;
+	if (vumax > MIXING_CLIPMAX) vumax = MIXING_CLIPMAX;
+	*lpMin = vumin;
+	*lpMax = vumax;
+	return lSampleCount * 4;
+}
+
 
 #ifdef MSC_VER
 void MPPASMCALL X86_InitMixBuffer(int *pBuffer, UINT nSamples)
@@ -2207,6 +2945,12 @@ void MPPASMCALL X86_StereoFill(int *pBuffer, UINT nSamples, LPLONG lpROfs, LPLON
 	{
 		int x_r = (rofs + (((-rofs)>>31) & OFSDECAYMASK)) >> OFSDECAYSHIFT;
 		int x_l = (lofs + (((-lofs)>>31) & OFSDECAYMASK)) >> OFSDECAYSHIFT;
+		// |ofs| < 256 never decays any further, the rest is silence
+		if ((!x_r) && (!x_l))
+		{
+			X86_InitMixBuffer(pBuffer+i*2, (nSamples-i)*2);
+			break;
+		}
 		rofs -= x_r;
 		lofs -= x_l;
 		pBuffer[i*2] = x_r;
@@ -2271,6 +3015,7 @@ void MPPASMCALL X86_EndChannelOfs(MODCHANNEL *pChannel, int *pBuffer, UINT nSamp
 	{
 		int x_r = (rofs + (((-rofs)>>31) & OFSDECAYMASK)) >> OFSDECAYSHIFT;
 		int x_l = (lofs + (((-lofs)>>31) & OFSDECAYMASK)) >> OFSDECAYSHIFT;
+		if ((!x_r) && (!x_l)) break;
 		rofs -= x_r;
 		lofs -= x_l;
 		pBuffer[i*2] += x_r;
@@ -240,6 +240,8 @@ typedef const BYTE * LPCBYTE;
 #define SYSMIX_WINDOWSNT	0x02
 #define SYSMIX_SLOWCPU		0x04
 #define SYSMIX_FASTCPU		0x08
+#define SYSMIX_SSE2			0x10	// SSE2 interpolators (x86)
+#define SYSMIX_NEON			0x20	// NEON interpolators (ARM)
 
 // Module flags
 #define SONG_EMBEDMIDICFG	0x0001
@@ -277,6 +279,7 @@ typedef const BYTE * LPCBYTE;
 #define SNDMIX_ENABLEMMX		0x20000
 #define SNDMIX_NOBACKWARDJUMPS	0x40000
 #define SNDMIX_MAXDEFAULTPAN	0x80000	// Used by the MOD loader
+#define SNDMIX_FLOATOUTPUT		0x100000	// 32-bit output is float
 
 
 // Reverb Types (GM2 Presets)
@@ -452,6 +455,44 @@ typedef struct _MODCOMMAND
 	BYTE param;
 } MODCOMMAND, *LPMODCOMMAND;
 
+
+// Seek index: playback state at an order boundary, see CSoundFile::SetCurrentTime()
+#define SEEK_SNAPSHOT_INTERVAL	5	// seconds between two snapshots, at least
+
+typedef struct _MODSNAPSHOT
+{
+	DWORD dwSamples;		// song position in samples at the mixing rate
+	UINT nChannels;			// entries in Chn, the other channels are silent
+	MODCHANNEL *Chn;
+	DWORD dwSongFlags;
+	UINT nTickCount, nPatternDelay, nFrameDelay;
+	UINT nMusicSpeed, nMusicTempo;
+	UINT nNextRow, nRow;
+	UINT nPattern, nCurrentPattern, nNextPattern;
+	UINT nGlobalVolume, nOldGlbVolSlide;
+	LONG nRepeatCount;
+	DWORD nGlobalFadeSamples, nGlobalFadeMaxSamples;
+} MODSNAPSHOT;
+
+
+// Seekable module file, see CSoundFile::Create(const MODREADER *)
+typedef struct _MODREADER
+{
+	LPVOID pOpaque;
+	int (*Read)(LPVOID pOpaque, LPVOID lpBuffer, int nBytes);	// bytes read, <= 0 at the end or on error
+	int (*Seek)(LPVOID pOpaque, long nOffset);					// absolute offset, < 0 on error
+	DWORD dwLength;
+} MODREADER;
+
+// Sample data left in the file by ReadSample() while loading from a MODREADER
+typedef struct _MODDEFERREDSAMPLE
+{
+	signed char *pSample;	// buffer allocated for it, NULL if none
+	MODINSTRUMENT Ins;		// sample header after ReadSample()
+	UINT nFlags, nType;
+	DWORD dwOffset, dwLength;
+} MODDEFERREDSAMPLE;
+
 ////////////////////////////////////////////////////////////////////
 // Mix Plugins
 #define MIXPLUG_MIXREADY			0x01	// Set when cleared
@@ -585,6 +626,12 @@ public:	// for Editing
 	LONG m_nMinPeriod, m_nMaxPeriod, m_nRepeatCount, m_nInitialRepeatCount;
 	DWORD m_nGlobalFadeSamples, m_nGlobalFadeMaxSamples;
 	UINT m_nMaxOrderPosition;
+	MODSNAPSHOT *m_pSnapshots;						// Seek index
+	UINT m_nSnapshots, m_nMaxSnapshots;
+	DWORD m_dwSnapshotRate, m_dwSeekLength;
+	const MODREADER *m_pReader;						// Deferred sample data
+	LPCBYTE m_lpReaderStream;
+	MODDEFERREDSAMPLE *m_pDeferredSamples;
 	UINT m_nPatternNames;
 	LPSTR m_lpszSongComments, m_lpszPatternNames;
 	char m_szNames[MAX_INSTRUMENTS][32];    // changed from CHAR
@@ -596,6 +643,7 @@ public:
 
 public:
 	BOOL Create(LPCBYTE lpStream, DWORD dwMemLength=0);
+	BOOL Create(const MODREADER *pReader);
 	BOOL Destroy();
 	UINT GetType() const { return m_nType; }
 	UINT GetNumChannels() const;
@@ -613,6 +661,7 @@ public:
 	UINT GetMaxPosition() const;
 	void SetCurrentPos(UINT nPos);
 	void SetCurrentOrder(UINT nOrder);
+	void SetCurrentTime(DWORD nSample);
 	void GetTitle(LPSTR s) const { lstrcpyn(s,m_szNames[0],32); }
 	LPCSTR GetTitle() const { return m_szNames[0]; }
 	UINT GetSampleName(UINT nSample,LPSTR s=NULL) const;
@@ -681,6 +730,8 @@ public:
 
 	UINT Read(LPVOID lpBuffer, UINT cbBuffer);
 	UINT CreateStereoMix(int count);
+	void SkipStereoMix(int count);
+	UINT SkipTick(UINT nMaxSamples);
 	BOOL FadeSong(UINT msec);
 	BOOL GlobalFadeSong(UINT msec);
 	UINT GetTotalTickCount() const { return m_nTotalCount; }
@@ -690,7 +741,7 @@ public:
 	// Mixer Config
 	static BOOL InitPlayer(BOOL bReset=FALSE);
 	static BOOL SetMixConfig(UINT nStereoSeparation, UINT nMaxMixChannels);
-	static BOOL SetWaveConfig(UINT nRate,UINT nBits,UINT nChannels,BOOL bMMX=FALSE);
+	static BOOL SetWaveConfig(UINT nRate,UINT nBits,UINT nChannels,BOOL bMMX=FALSE,BOOL bFloat=FALSE);
 	static BOOL SetResamplingMode(UINT nMode); // SRCMODE_XXXX
 	static BOOL IsStereo() { return (gnChannels > 1) ? TRUE : FALSE; }
 	static DWORD GetSampleRate() { return gdwMixingFreq; }
@@ -715,6 +766,12 @@ public:
 	static BOOL SetXBassParameters(UINT nDepth, UINT nRange);
 	// [Surround level 0(quiet)-100(heavy)] [delay in ms, usually 5-40ms]
 	static BOOL SetSurroundParameters(UINT nDepth, UINT nDelay);
+public:
+	// Seek index
+	BOOL InitSeekIndex();
+	void FreeSeekIndex();
+	BOOL SaveSnapshot(DWORD dwSamples);
+	void RestoreSnapshot(const MODSNAPSHOT *pSnap);
 public:
 	BOOL ReadNote();
 	BOOL ProcessRow();
@@ -762,6 +819,8 @@ public:
 	UINT PackSample(int &sample, int next);
 	BOOL CanPackSample(LPSTR pSample, UINT nLen, UINT nPacking, BYTE *result=NULL);
 	UINT ReadSample(MODINSTRUMENT *pIns, UINT nFlags, LPCSTR pMemFile, DWORD dwMemLength);
+	UINT DeferSample(MODINSTRUMENT *pIns, UINT nFlags, LPCSTR pMemFile, DWORD dwMemLength);
+	BOOL ReadDeferredSamples();
 	BOOL DestroySample(UINT nSample);
 	BOOL DestroyInstrument(UINT nInstr);
 	BOOL IsSampleUsed(UINT nSample);
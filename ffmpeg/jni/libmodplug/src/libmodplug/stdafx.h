@@ -106,10 +106,8 @@ inline LONG MulDiv (long a, long b, long c)
 #define GlobalFreePtr(p) free((void *)(p))
 inline int8_t * GlobalAllocPtr(unsigned int, size_t size)
 {
-  int8_t * p = (int8_t *) malloc(size);
-
-  if (p != NULL) memset(p, 0, size);
-  return p;
+  // calloc() leaves fresh pages untouched until they are written
+  return (int8_t *) calloc(size, 1);
 }
 
 inline void ProcessPlugins(int n) {}
@@ -17,7 +17,7 @@ namespace ModPlug
 {
 	ModPlug_Settings gSettings =
 	{
-		MODPLUG_ENABLE_OVERSAMPLING | MODPLUG_ENABLE_NOISE_REDUCTION,
+		MODPLUG_ENABLE_OVERSAMPLING | MODPLUG_ENABLE_NOISE_REDUCTION | MODPLUG_ENABLE_SIMD,
 
 		2, // mChannels
 		16, // mBits
@@ -63,7 +63,9 @@ namespace ModPlug
 		{
 			CSoundFile::SetWaveConfig(gSettings.mFrequency,
                                                   gSettings.mBits,
-			                          gSettings.mChannels);
+			                          gSettings.mChannels,
+			                          gSettings.mFlags & MODPLUG_ENABLE_SIMD,
+			                          gSettings.mFlags & MODPLUG_ENABLE_FLOAT_OUTPUT);
 			CSoundFile::SetMixConfig(gSettings.mStereoSeparation,
                                                  gSettings.mMaxMixChannels);
 
@@ -97,6 +99,27 @@ ModPlugFile* ModPlug_Load(const void* data, int size)
 	}
 }
 
+ModPlugFile* ModPlug_LoadReader(const ModPlugReader* reader)
+{
+	ModPlugFile* result = new ModPlugFile;
+	MODREADER r;
+	r.pOpaque = reader->opaque;
+	r.Read = reader->read;
+	r.Seek = reader->seek;
+	r.dwLength = reader->size > 0 && reader->size <= 0x7FFFFFFF ? (DWORD)reader->size : 0;
+	ModPlug::UpdateSettings(true);
+	if(result->mSoundFile.Create(&r))
+	{
+		result->mSoundFile.SetRepeatCount(ModPlug::gSettings.mLoopCount);
+		return result;
+	}
+	else
+	{
+		delete result;
+		return NULL;
+	}
+}
+
 void ModPlug_Unload(ModPlugFile* file)
 {
 	file->mSoundFile.Destroy();
@@ -251,18 +274,9 @@ ModPlugNote* ModPlug_GetPattern(ModPlugFile* file,int pattern,unsigned int* numr
 
 void ModPlug_Seek(ModPlugFile* file, int millisecond)
 {
-	int maxpos;
-	int maxtime = file->mSoundFile.GetSongTime() * 1000;
-	float postime;
-
-	if(millisecond > maxtime)
-		millisecond = maxtime;
-	maxpos = file->mSoundFile.GetMaxPosition();
-	postime = 0.0f;
-	if (maxtime != 0)
-		postime = (float)maxpos / (float)maxtime;
-
-	file->mSoundFile.SetCurrentPos((int)(millisecond * postime));
+	if(millisecond < 0)
+		millisecond = 0;
+	file->mSoundFile.SetCurrentTime((DWORD)(((LONGLONG)millisecond * CSoundFile::GetSampleRate()) / 1000));
 }
 
 void ModPlug_GetSettings(ModPlug_Settings* settings)
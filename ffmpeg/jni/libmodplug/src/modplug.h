@@ -44,6 +44,22 @@ typedef void (*ModPlugMixerProc)(int*, unsigned long, unsigned long);
  * file, and [size] should be the size of that block.
  * Return the loaded mod file on success, or NULL on failure. */
 MODPLUG_EXPORT ModPlugFile* ModPlug_Load(const void* data, int size);
+/* Seekable input for ModPlug_LoadReader().  [read] reads up to [size] bytes at the
+ * current position and returns the number of bytes read, 0 at the end of the file or
+ * a negative value on error.  [seek] moves to the absolute byte [offset] and returns a
+ * negative value on error.  [size] is the size of the file in bytes. */
+typedef struct _ModPlugReader {
+	void* opaque;
+	int  (*read)(void* opaque, void* buffer, int size);
+	int  (*seek)(void* opaque, long offset);
+	long size;
+} ModPlugReader;
+
+/* Load a mod file from [reader].  Plain PCM and IT compressed sample data is read
+ * again from the reader once the file itself has been parsed and freed, so that the
+ * file and the decoded samples are not in memory at the same time.  The reader is not
+ * used after this returns. */
+MODPLUG_EXPORT ModPlugFile* ModPlug_LoadReader(const ModPlugReader* reader);
 /* Unload a mod file. */
 MODPLUG_EXPORT void ModPlug_Unload(ModPlugFile* file);
 
@@ -59,12 +75,10 @@ MODPLUG_EXPORT const char* ModPlug_GetName(ModPlugFile* file);
  * accurate, especially in the case of mods with loops. */
 MODPLUG_EXPORT int ModPlug_GetLength(ModPlugFile* file);
 
-/* Seek to a particular position in the song.  Note that seeking and MODs don't mix very
- * well.  Some mods will be missing instruments for a short time after a seek, as ModPlug
- * does not scan the sequence backwards to find out which instruments were supposed to be
- * playing at that time.  (Doing so would be difficult and not very reliable.)  Also,
- * note that seeking is not very exact in some mods -- especially those for which
- * ModPlug_GetLength() does not report the full length. */
+/* Seek to a particular position in the song.  The channel and effect state at that
+ * position is found by playing the song without mixing from the nearest earlier snapshot
+ * of it.  Snapshots are kept every few seconds of the song, the first time a seek plays
+ * past them.  The song then continues as if it had been played from the start. */
 MODPLUG_EXPORT void ModPlug_Seek(ModPlugFile* file, int millisecond);
 
 enum _ModPlug_Flags
@@ -73,7 +87,9 @@ enum _ModPlug_Flags
 	MODPLUG_ENABLE_NOISE_REDUCTION  = 1 << 1,  /* Enable noise reduction */
 	MODPLUG_ENABLE_REVERB           = 1 << 2,  /* Enable reverb */
 	MODPLUG_ENABLE_MEGABASS         = 1 << 3,  /* Enable megabass */
-	MODPLUG_ENABLE_SURROUND         = 1 << 4   /* Enable surround sound. */
+	MODPLUG_ENABLE_SURROUND         = 1 << 4,  /* Enable surround sound. */
+	MODPLUG_ENABLE_SIMD             = 1 << 5,  /* Use the SSE2/NEON mixer when the CPU has it */
+	MODPLUG_ENABLE_FLOAT_OUTPUT     = 1 << 6   /* With mBits = 32, output floats in [-1, 1) */
 };
 
 enum _ModPlug_ResamplingMode
@@ -91,7 +107,8 @@ typedef struct _ModPlug_Settings
 	/* Note that ModPlug always decodes sound at 44100kHz, 32 bit, stereo and then
 	 * down-mixes to the settings you choose. */
 	int mChannels;       /* Number of channels - 1 for mono or 2 for stereo */
-	int mBits;           /* Bits per sample - 8, 16, or 32 */
+	int mBits;           /* Bits per sample - 8, 16, or 32 (integer, or float with
+	                      * MODPLUG_ENABLE_FLOAT_OUTPUT) */
 	int mFrequency;      /* Sampling rate - 11025, 22050, or 44100 */
 	int mResamplingMode; /* One of MODPLUG_RESAMPLE_*, above */
 
@@ -109,7 +126,7 @@ typedef struct _ModPlug_Settings
 } ModPlug_Settings;
 
 /* Get and set the mod decoder settings.  All options, except for channels, bits-per-sample,
- * sampling rate, and loop count, will take effect immediately.  Those options which don't
+ * sampling rate, loop count, SIMD and float output, will take effect immediately.  Those options which don't
  * take effect immediately will take effect the next time you load a mod. */
 MODPLUG_EXPORT void ModPlug_GetSettings(ModPlug_Settings* settings);
 MODPLUG_EXPORT void ModPlug_SetSettings(const ModPlug_Settings* settings);
@@ -0,0 +1,173 @@
+/*
+ * This source code is public domain.
+ *
+ * Mixer benchmark: renders each module for a given time once with the C
+ * mixer and once with the SSE2/NEON mixer, prints the CPU time of both and
+ * checks that the output is identical.
+ *
+ * modplug_bench [-s seconds] [-r nearest|linear|spline|fir] [-F rate]
+ *               [-m channels] [-f] module...
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "modplug.h"
+
+#define BUFFER_SIZE	16384
+
+typedef struct
+{
+	double time;		// CPU time in seconds
+	double rendered;	// rendered audio in seconds
+	unsigned int crc;	// FNV-1a of the output
+} BenchResult;
+
+static void usage(void)
+{
+	fprintf(stderr,
+	        "Usage: modplug_bench [options] module...\n"
+	        "-s seconds  audio rendered per module, default 60\n"
+	        "-r mode     resampling: nearest, linear, spline or fir (default)\n"
+	        "-F rate     output sample rate, default 48000\n"
+	        "-m channels maximum number of mixed channels, default 256\n"
+	        "-f          float output instead of 16-bit\n");
+}
+
+static char *read_file(const char *name, long *size)
+{
+	FILE *f = fopen(name, "rb");
+	char *data = NULL;
+
+	if (!f) return NULL;
+	if (!fseek(f, 0, SEEK_END) && (*size = ftell(f)) > 0 && !fseek(f, 0, SEEK_SET))
+	{
+		data = (char *)malloc(*size);
+		if (data && fread(data, 1, *size, f) != (size_t)*size)
+		{
+			free(data);
+			data = NULL;
+		}
+	}
+	fclose(f);
+	return data;
+}
+
+static int bench(const char *data, long size, const ModPlug_Settings *settings,
+                 double seconds, BenchResult *res)
+{
+	static unsigned char buf[BUFFER_SIZE];
+	int frame = settings->mChannels * settings->mBits / 8;
+	long frames = 0, total = (long)(seconds * settings->mFrequency);
+	unsigned int crc = 2166136261u;
+	ModPlugFile *f;
+	clock_t t0;
+
+	ModPlug_SetSettings(settings);
+	if (!(f = ModPlug_Load(data, size))) return -1;
+
+	t0 = clock();
+	while (frames < total)
+	{
+		int want = BUFFER_SIZE / frame, n, i;
+		if (want > total - frames) want = total - frames;
+		n = ModPlug_Read(f, buf, want * frame);
+		if (n <= 0)
+		{
+			// restart short modules until enough audio is rendered
+			if (!frames) break;
+			ModPlug_Seek(f, 0);
+			if ((n = ModPlug_Read(f, buf, want * frame)) <= 0) break;
+		}
+		for (i = 0; i < n; i++) crc = (crc ^ buf[i]) * 16777619u;
+		frames += n / frame;
+	}
+	res->time = (double)(clock() - t0) / CLOCKS_PER_SEC;
+	res->rendered = (double)frames / settings->mFrequency;
+	res->crc = crc;
+	ModPlug_Unload(f);
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	ModPlug_Settings settings;
+	double seconds = 60;
+	int i, mismatch = 0, nfiles = 0;
+
+	ModPlug_GetSettings(&settings);
+	settings.mFlags = MODPLUG_ENABLE_OVERSAMPLING;
+	settings.mChannels = 2;
+	settings.mBits = 16;
+	settings.mFrequency = 48000;
+	settings.mResamplingMode = MODPLUG_RESAMPLE_FIR;
+	settings.mMaxMixChannels = 256;
+	settings.mLoopCount = 0;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "-s") && i + 1 < argc)
+			seconds = atof(argv[++i]);
+		else if (!strcmp(argv[i], "-F") && i + 1 < argc)
+			settings.mFrequency = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-m") && i + 1 < argc)
+			settings.mMaxMixChannels = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-f"))
+		{
+			settings.mFlags |= MODPLUG_ENABLE_FLOAT_OUTPUT;
+			settings.mBits = 32;
+		}
+		else if (!strcmp(argv[i], "-r") && i + 1 < argc)
+		{
+			const char *m = argv[++i];
+			if (!strcmp(m, "nearest")) settings.mResamplingMode = MODPLUG_RESAMPLE_NEAREST;
+			else if (!strcmp(m, "linear")) settings.mResamplingMode = MODPLUG_RESAMPLE_LINEAR;
+			else if (!strcmp(m, "spline")) settings.mResamplingMode = MODPLUG_RESAMPLE_SPLINE;
+			else if (!strcmp(m, "fir")) settings.mResamplingMode = MODPLUG_RESAMPLE_FIR;
+			else { usage(); return 1; }
+		}
+		else if (argv[i][0] == '-')
+		{
+			usage();
+			return 1;
+		}
+		else
+			argv[++nfiles] = argv[i];
+	}
+	if (!nfiles || seconds <= 0)
+	{
+		usage();
+		return 1;
+	}
+
+	printf("%-32s %8s %10s %10s %8s\n", "module", "audio(s)", "C (s)", "SIMD (s)", "speedup");
+	for (i = 1; i <= nfiles; i++)
+	{
+		BenchResult c, simd;
+		long size;
+		char *data = read_file(argv[i], &size);
+
+		if (!data)
+		{
+			fprintf(stderr, "%s: cannot read\n", argv[i]);
+			return 1;
+		}
+		settings.mFlags &= ~MODPLUG_ENABLE_SIMD;
+		if (bench(data, size, &settings, seconds, &c) < 0)
+		{
+			fprintf(stderr, "%s: cannot load\n", argv[i]);
+			free(data);
+			return 1;
+		}
+		settings.mFlags |= MODPLUG_ENABLE_SIMD;
+		bench(data, size, &settings, seconds, &simd);
+		free(data);
+
+		printf("%-32s %8.1f %10.3f %10.3f %7.2fx%s\n", argv[i], c.rendered, c.time, simd.time,
+		       simd.time > 0 ? c.time / simd.time : 0.0,
+		       (c.crc != simd.crc || c.rendered != simd.rendered) ? "  OUTPUT MISMATCH" : "");
+		if (c.crc != simd.crc || c.rendered != simd.rendered) mismatch = 1;
+	}
+	return mismatch;
+}
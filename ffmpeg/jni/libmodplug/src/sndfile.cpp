@@ -62,6 +62,12 @@ CSoundFile::CSoundFile()
 	m_nMinPeriod = 0x20;
 	m_nMaxPeriod = 0x7FFF;
 	m_nRepeatCount = 0;
+	m_pSnapshots = NULL;
+	m_nSnapshots = m_nMaxSnapshots = 0;
+	m_dwSnapshotRate = m_dwSeekLength = 0;
+	m_pReader = NULL;
+	m_lpReaderStream = NULL;
+	m_pDeferredSamples = NULL;
 	memset(Chn, 0, sizeof(Chn));
 	memset(ChnMix, 0, sizeof(ChnMix));
 	memset(Ins, 0, sizeof(Ins));
@@ -272,6 +278,46 @@ BOOL CSoundFile::Create(LPCBYTE lpStream, DWORD dwMemLength)
 }
 
 
+BOOL CSoundFile::Create(const MODREADER *pReader)
+//-----------------------------------------------
+// Same as Create(LPCBYTE, DWORD), but the sample data that ReadSample() can decode
+// from a known range of the file is only read again once the file itself is freed,
+// so that the file and the decoded samples are not both held in memory.
+{
+	DWORD dwMemLength = pReader->dwLength, dwPos = 0;
+	LPBYTE lpStream;
+	BOOL bOk;
+
+	if ((!dwMemLength) || (pReader->Seek(pReader->pOpaque, 0) < 0)) return FALSE;
+	if ((lpStream = (LPBYTE)GlobalAllocPtr(GHND, dwMemLength)) == NULL) return FALSE;
+	while (dwPos < dwMemLength)
+	{
+		int n = pReader->Read(pReader->pOpaque, lpStream+dwPos, dwMemLength-dwPos);
+		if (n <= 0) break;
+		dwPos += n;
+	}
+	// Truncated file: load what could be read, as Create(LPCBYTE, DWORD) would
+	if (dwPos == dwMemLength)
+	{
+		m_pDeferredSamples = new MODDEFERREDSAMPLE[MAX_SAMPLES];
+		memset(m_pDeferredSamples, 0, MAX_SAMPLES * sizeof(MODDEFERREDSAMPLE));
+		m_pReader = pReader;
+		m_lpReaderStream = lpStream;
+	}
+	bOk = Create(lpStream, dwPos);
+	GlobalFreePtr(lpStream);
+	m_lpReaderStream = NULL;
+	if (m_pDeferredSamples)
+	{
+		if (bOk) bOk = ReadDeferredSamples();
+		delete [] m_pDeferredSamples;
+		m_pDeferredSamples = NULL;
+	}
+	m_pReader = NULL;
+	return bOk;
+}
+
+
 BOOL CSoundFile::Destroy()
 
 //------------------------
@@ -325,6 +371,7 @@ BOOL CSoundFile::Destroy()
 			m_MixPlugins[i].pMixPlugin = NULL;
 		}
 	}
+	FreeSeekIndex();
 	m_nType = MOD_TYPE_NONE;
 	m_nChannels = m_nSamples = m_nInstruments = 0;
 	return TRUE;
@@ -465,12 +512,13 @@ UINT CSoundFile::GetRawSongComments(LPSTR s, UINT len, UINT linesize)
 }
 
 
-BOOL CSoundFile::SetWaveConfig(UINT nRate,UINT nBits,UINT nChannels,BOOL bMMX)
-//----------------------------------------------------------------------------
+BOOL CSoundFile::SetWaveConfig(UINT nRate,UINT nBits,UINT nChannels,BOOL bMMX,BOOL bFloat)
+//----------------------------------------------------------------------------------------
 {
 	BOOL bReset = FALSE;
-	DWORD d = gdwSoundSetup & ~SNDMIX_ENABLEMMX;
+	DWORD d = gdwSoundSetup & ~(SNDMIX_ENABLEMMX|SNDMIX_FLOATOUTPUT);
 	if (bMMX) d |= SNDMIX_ENABLEMMX;
+	if ((bFloat) && (nBits == 32)) d |= SNDMIX_FLOATOUTPUT;
 	if ((gdwMixingFreq != nRate) || (gnBitsPerSample != nBits) || (gnChannels != nChannels) || (d != gdwSoundSetup)) bReset = TRUE;
 	gnChannels = nChannels;
 	gdwSoundSetup = d;
@@ -718,6 +766,179 @@ void CSoundFile::SetCurrentOrder(UINT nPos)
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+// Seek index
+//
+// Seeking by time needs the channel and effect state at that time, which
+// only playing the song from the start gives. SetCurrentTime() restores the
+// last snapshot of the state before the position and plays the remaining
+// rows without mixing. When it plays past the last snapshot, it adds one at
+// the first order boundary after every SEEK_SNAPSHOT_INTERVAL seconds.
+
+// Song flags which are part of the playback state
+#define SONG_PLAYSTATE	(SONG_PATTERNLOOP|SONG_CPUVERYHIGH|SONG_FADINGSONG|SONG_ENDREACHED|SONG_GLOBALFADE|SONG_FIRSTTICK)
+
+BOOL CSoundFile::SaveSnapshot(DWORD dwSamples)
+//--------------------------------------------
+{
+	MODSNAPSHOT *pSnap;
+	UINT nChannels = m_nChannels;
+
+	// New note actions may play in the channels above m_nChannels
+	for (UINT i=m_nChannels; i<MAX_CHANNELS; i++) if (Chn[i].nLength) nChannels = i+1;
+	if (m_nSnapshots >= m_nMaxSnapshots)
+	{
+		UINT nMaxSnapshots = (m_nMaxSnapshots) ? m_nMaxSnapshots*2 : 64;
+		pSnap = new MODSNAPSHOT[nMaxSnapshots];
+		if (!pSnap) return FALSE;
+		if (m_pSnapshots)
+		{
+			memcpy(pSnap, m_pSnapshots, m_nSnapshots * sizeof(MODSNAPSHOT));
+			delete [] m_pSnapshots;
+		}
+		m_pSnapshots = pSnap;
+		m_nMaxSnapshots = nMaxSnapshots;
+	}
+	pSnap = &m_pSnapshots[m_nSnapshots];
+	pSnap->Chn = new MODCHANNEL[nChannels];
+	if (!pSnap->Chn) return FALSE;
+	memcpy(pSnap->Chn, Chn, nChannels * sizeof(MODCHANNEL));
+	pSnap->dwSamples = dwSamples;
+	pSnap->nChannels = nChannels;
+	pSnap->dwSongFlags = m_dwSongFlags & SONG_PLAYSTATE;
+	pSnap->nTickCount = m_nTickCount;
+	pSnap->nPatternDelay = m_nPatternDelay;
+	pSnap->nFrameDelay = m_nFrameDelay;
+	pSnap->nMusicSpeed = m_nMusicSpeed;
+	pSnap->nMusicTempo = m_nMusicTempo;
+	pSnap->nNextRow = m_nNextRow;
+	pSnap->nRow = m_nRow;
+	pSnap->nPattern = m_nPattern;
+	pSnap->nCurrentPattern = m_nCurrentPattern;
+	pSnap->nNextPattern = m_nNextPattern;
+	pSnap->nGlobalVolume = m_nGlobalVolume;
+	pSnap->nOldGlbVolSlide = m_nOldGlbVolSlide;
+	pSnap->nRepeatCount = m_nRepeatCount;
+	pSnap->nGlobalFadeSamples = m_nGlobalFadeSamples;
+	pSnap->nGlobalFadeMaxSamples = m_nGlobalFadeMaxSamples;
+	m_nSnapshots++;
+	return TRUE;
+}
+
+
+void CSoundFile::RestoreSnapshot(const MODSNAPSHOT *pSnap)
+//--------------------------------------------------------
+{
+	memcpy(Chn, pSnap->Chn, pSnap->nChannels * sizeof(MODCHANNEL));
+	memset(&Chn[pSnap->nChannels], 0, (MAX_CHANNELS - pSnap->nChannels) * sizeof(MODCHANNEL));
+	m_dwSongFlags = (m_dwSongFlags & ~SONG_PLAYSTATE) | pSnap->dwSongFlags;
+	m_nTickCount = pSnap->nTickCount;
+	m_nPatternDelay = pSnap->nPatternDelay;
+	m_nFrameDelay = pSnap->nFrameDelay;
+	m_nMusicSpeed = pSnap->nMusicSpeed;
+	m_nMusicTempo = pSnap->nMusicTempo;
+	m_nNextRow = pSnap->nNextRow;
+	m_nRow = pSnap->nRow;
+	m_nPattern = pSnap->nPattern;
+	m_nCurrentPattern = pSnap->nCurrentPattern;
+	m_nNextPattern = pSnap->nNextPattern;
+	m_nGlobalVolume = pSnap->nGlobalVolume;
+	m_nOldGlbVolSlide = pSnap->nOldGlbVolSlide;
+	m_nRepeatCount = pSnap->nRepeatCount;
+	m_nGlobalFadeSamples = pSnap->nGlobalFadeSamples;
+	m_nGlobalFadeMaxSamples = pSnap->nGlobalFadeMaxSamples;
+	m_nMixChannels = 0;
+	m_nBufferCount = 0;
+}
+
+
+void CSoundFile::FreeSeekIndex()
+//------------------------------
+{
+	for (UINT i=0; i<m_nSnapshots; i++) delete [] m_pSnapshots[i].Chn;
+	if (m_pSnapshots) delete [] m_pSnapshots;
+	m_pSnapshots = NULL;
+	m_nSnapshots = m_nMaxSnapshots = 0;
+	m_dwSnapshotRate = m_dwSeekLength = 0;
+}
+
+
+BOOL CSoundFile::InitSeekIndex()
+//------------------------------
+{
+	LONGLONG nMaxSamples = (m_nInitialRepeatCount > 0) ? m_nInitialRepeatCount+1 : 1;
+
+	FreeSeekIndex();
+	// Bound songs which loop forever
+	nMaxSamples *= (LONGLONG)(GetSongTime() + 1) * gdwMixingFreq;
+	m_dwSeekLength = (nMaxSamples > 0x7FFFFFFF) ? 0x7FFFFFFF : (DWORD)nMaxSamples;
+	SetCurrentPos(0);
+	m_nRepeatCount = m_nInitialRepeatCount;
+	if (!SaveSnapshot(0)) return FALSE;
+	m_dwSnapshotRate = gdwMixingFreq;
+	return TRUE;
+}
+
+
+void CSoundFile::SetCurrentTime(DWORD nSample)
+//--------------------------------------------
+{
+	DWORD dwSamples = 0, dwNextSnapshot = 0xFFFFFFFF;
+	BOOL bEnd;
+
+	if ((!m_nSnapshots) || (m_dwSnapshotRate != gdwMixingFreq)) InitSeekIndex();
+	bEnd = (nSample >= m_dwSeekLength) ? TRUE : FALSE;
+	if (bEnd) nSample = m_dwSeekLength;
+	if (m_nSnapshots)
+	{
+		// Last snapshot before nSample
+		UINT nMin = 0, nMax = m_nSnapshots;
+		while (nMax - nMin > 1)
+		{
+			UINT nMid = (nMin + nMax) >> 1;
+			if (m_pSnapshots[nMid].dwSamples <= nSample) nMin = nMid; else nMax = nMid;
+		}
+		RestoreSnapshot(&m_pSnapshots[nMin]);
+		dwSamples = m_pSnapshots[nMin].dwSamples;
+		// Extend the index when playing past its last snapshot
+		if (nMin == m_nSnapshots-1) dwNextSnapshot = dwSamples + SEEK_SNAPSHOT_INTERVAL * gdwMixingFreq;
+	} else
+	{
+		SetCurrentPos(0);
+		m_nRepeatCount = m_nInitialRepeatCount;
+	}
+	while (dwSamples + 1 < nSample)
+	{
+		// Snapshots are taken between two ticks, when the next one starts a new order
+		if ((!m_nBufferCount) && (dwSamples >= dwNextSnapshot) && (m_nNextPattern != m_nCurrentPattern)
+		 && (m_nTickCount+1 >= m_nMusicSpeed * (m_nPatternDelay+1) + m_nFrameDelay))
+		{
+			if (SaveSnapshot(dwSamples))
+				dwNextSnapshot = dwSamples + SEEK_SNAPSHOT_INTERVAL * gdwMixingFreq;
+			else
+				dwNextSnapshot = 0xFFFFFFFF;
+		}
+		UINT nSkipped = SkipTick(nSample - dwSamples - 1);
+		if (!nSkipped)
+		{
+			m_dwSeekLength = dwSamples;
+			break;
+		}
+		dwSamples += nSkipped;
+	}
+	if (bEnd)
+	{
+		m_dwSongFlags |= SONG_ENDREACHED;
+	} else
+	// Mix the last sample, so that the click removal of the playing channels is right
+	if (dwSamples + 1 == nSample)
+	{
+		BYTE buf[16];
+		Read(buf, gnChannels * gnBitsPerSample / 8);
+	}
+}
+
+
 void CSoundFile::ResetChannels()
 //------------------------------
 {
@@ -1099,6 +1320,7 @@ UINT CSoundFile::ReadSample(MODINSTRUMENT *pIns, UINT nFlags, LPCSTR lpMemFile,
 
 	// Disable >2Gb samples,(preventing buffer overflow in AllocateSample)
 	if ((!pIns) || ((int)pIns->nLength < 4) || (!lpMemFile)) return 0;
+	if ((m_pDeferredSamples) && ((len = DeferSample(pIns, nFlags, lpMemFile, dwMemLength)) != 0)) return len;
 	if (pIns->nLength > MAX_SAMPLE_LENGTH) pIns->nLength = MAX_SAMPLE_LENGTH;
 	pIns->uFlags &= ~(CHN_16BIT|CHN_STEREO);
 	if (nFlags & RSF_16BIT)
@@ -1547,6 +1769,213 @@ UINT CSoundFile::ReadSample(MODINSTRUMENT *pIns, UINT nFlags, LPCSTR lpMemFile,
 }
 
 
+UINT CSoundFile::DeferSample(MODINSTRUMENT *pIns, UINT nFlags, LPCSTR lpMemFile, DWORD dwMemLength)
+//-------------------------------------------------------------------------------------------------
+// ReadSample() without the decoding, for the formats whose size in the file is known
+// up front. The sample gets a zeroed buffer and the header ReadSample() would leave,
+// its data is decoded by ReadDeferredSamples(). Returns 0 if it must be read now.
+{
+	DWORD dwOffset = (LPCBYTE)lpMemFile - m_lpReaderStream, dwLength, dwRet;
+	UINT nSample = pIns - Ins, nLength = pIns->nLength, mem = pIns->nLength+6;
+
+	if ((nSample < 1) || (nSample >= MAX_SAMPLES)
+	 || ((LPCBYTE)lpMemFile < m_lpReaderStream) || (dwOffset >= m_pReader->dwLength)
+	 || (dwMemLength > m_pReader->dwLength - dwOffset)) return 0;
+	if (nLength > MAX_SAMPLE_LENGTH) nLength = MAX_SAMPLE_LENGTH;
+	switch(nFlags)
+	{
+	case RS_PCM8S:
+	case RS_PCM8U:
+		if (nLength > dwMemLength) nLength = dwMemLength;
+		dwLength = dwRet = nLength;
+		break;
+	case RS_PCM8D:
+		dwLength = dwRet = nLength;
+		break;
+	case RS_PCM16S:
+	case RS_PCM16D:
+	case RS_PCM16U:
+	case RS_STPCM8S:
+	case RS_STPCM8U:
+	case RS_STPCM8D:
+		dwLength = dwRet = nLength * 2;
+		break;
+	case RS_STPCM16S:
+	case RS_STPCM16U:
+	case RS_STPCM16D:
+		dwLength = dwRet = nLength * 4;
+		break;
+	// IT 2.14 compressed samples: blocks of 0x8000 (8-bit) or 0x4000 (16-bit) samples,
+	// each with the size of its packed data in front
+	case RS_IT2148:
+	case RS_IT21416:
+	case RS_IT2158:
+	case RS_IT21516:
+		{
+			UINT nBlock = (nFlags & RSF_16BIT) ? 0x4000 : 0x8000;
+			if (dwMemLength < 4) return 0;
+			dwLength = 0;
+			for (UINT n=0; (n<nLength) && (dwLength+2 <= dwMemLength); n+=nBlock)
+			{
+				dwLength += 2 + bswapLE16(*((const WORD *)(lpMemFile+dwLength)));
+			}
+			// The unpacker may look one byte past the last block
+			dwLength += 4;
+			if (dwLength > dwMemLength) dwLength = dwMemLength;
+			dwRet = dwMemLength;
+		}
+		break;
+	default:
+		return 0;
+	}
+	if ((!dwLength) || (dwLength > dwMemLength)) return 0;
+	MODDEFERREDSAMPLE *pDeferred = &m_pDeferredSamples[nSample];
+	if (nFlags & RSF_16BIT) mem *= 2;
+	if (nFlags & RSF_STEREO) mem *= 2;
+	if ((pIns->pSample = AllocateSample(mem)) == NULL) return 0;
+	pIns->nLength = nLength;
+	pIns->uFlags &= ~(CHN_16BIT|CHN_STEREO);
+	if (nFlags & RSF_16BIT) pIns->uFlags |= CHN_16BIT;
+	if (nFlags & RSF_STEREO) pIns->uFlags |= CHN_STEREO;
+	AdjustSampleLoop(pIns);
+	pDeferred->pSample = pIns->pSample;
+	pDeferred->Ins = *pIns;
+	pDeferred->nFlags = nFlags;
+	pDeferred->nType = m_nType;
+	pDeferred->dwOffset = dwOffset;
+	pDeferred->dwLength = dwLength;
+	return dwRet;
+}
+
+
+BOOL CSoundFile::ReadDeferredSamples()
+//------------------------------------
+// Decodes the samples DeferSample() left in the file, reading each one from the file
+// again. Mono PCM is read into the sample buffer and converted there, IT compressed
+// samples are unpacked into it, only stereo samples go through ReadSample() again.
+{
+	MODDEFERREDSAMPLE *pDeferred = m_pDeferredSamples;
+	LPBYTE lpBuffer = NULL;
+	DWORD dwBufferLength = 0;
+	UINT nType = m_nType;
+	BOOL bOk = TRUE;
+
+	// Not deferred again by ReadSample()
+	m_pDeferredSamples = NULL;
+	for (UINT i=1; i<MAX_SAMPLES; i++)
+	{
+		MODDEFERREDSAMPLE *p = &pDeferred[i];
+		MODINSTRUMENT ins = p->Ins;
+		BOOL bInPlace = !(p->nFlags & (RSF_STEREO|0x10));
+		LPBYTE lpDest;
+		DWORD dwPos = 0;
+
+		// Sample destroyed or read again by the loader
+		if ((!p->pSample) || (Ins[i].pSample != p->pSample)) continue;
+		if (bInPlace)
+		{
+			lpDest = (LPBYTE)p->pSample;
+		} else
+		{
+			if (p->dwLength > dwBufferLength)
+			{
+				if (lpBuffer) GlobalFreePtr(lpBuffer);
+				// Zero padding for the IT unpacker
+				if ((lpBuffer = (LPBYTE)GlobalAllocPtr(GHND, p->dwLength+8)) == NULL)
+				{
+					bOk = FALSE;
+					break;
+				}
+				dwBufferLength = p->dwLength;
+			}
+			lpDest = lpBuffer;
+			memset(lpBuffer+p->dwLength, 0, 8);
+		}
+		if (m_pReader->Seek(m_pReader->pOpaque, p->dwOffset) < 0)
+		{
+			bOk = FALSE;
+			break;
+		}
+		while (dwPos < p->dwLength)
+		{
+			int n = m_pReader->Read(m_pReader->pOpaque, lpDest+dwPos, p->dwLength-dwPos);
+			if (n <= 0) break;
+			dwPos += n;
+		}
+		if (dwPos < p->dwLength)
+		{
+			bOk = FALSE;
+			break;
+		}
+		m_nType = p->nType;
+		switch(p->nFlags)
+		{
+		case RS_PCM8S:
+			break;
+		case RS_PCM8U:
+			{
+				signed char *pSample = p->pSample;
+				for (UINT j=0; j<p->dwLength; j++) pSample[j] = (signed char)(pSample[j] - 0x80);
+			}
+			break;
+		case RS_PCM8D:
+			{
+				signed char *pSample = p->pSample;
+				int delta = 0;
+				for (UINT j=0; j<p->dwLength; j++)
+				{
+					delta += pSample[j];
+					pSample[j] = (signed char)delta;
+				}
+			}
+			break;
+		case RS_PCM16S:
+			{
+				int16_t *pSample = (int16_t *)p->pSample;
+				for (UINT j=0; j<p->dwLength; j+=2, pSample++) *pSample = bswapLE16(*pSample);
+			}
+			break;
+		case RS_PCM16D:
+			{
+				int16_t *pSample = (int16_t *)p->pSample;
+				int delta16 = 0;
+				for (UINT j=0; j<p->dwLength; j+=2, pSample++)
+				{
+					delta16 += bswapLE16(*pSample);
+					*pSample = (int16_t)delta16;
+				}
+			}
+			break;
+		case RS_PCM16U:
+			{
+				int16_t *pSample = (int16_t *)p->pSample;
+				for (UINT j=0; j<p->dwLength; j+=2, pSample++) *pSample = bswapLE16(*pSample) - 0x8000;
+			}
+			break;
+		case RS_IT2148:
+		case RS_IT2158:
+			ITUnpack8Bit(p->pSample, ins.nLength, lpBuffer, p->dwLength, (p->nFlags == RS_IT2158));
+			break;
+		case RS_IT21416:
+		case RS_IT21516:
+			ITUnpack16Bit(p->pSample, ins.nLength, lpBuffer, p->dwLength, (p->nFlags == RS_IT21516));
+			break;
+		default:
+			ins.pSample = NULL;
+			ReadSample(&ins, p->nFlags, (LPCSTR)lpBuffer, p->dwLength);
+			FreeSample(Ins[i].pSample);
+			Ins[i].pSample = ins.pSample;
+			if (!ins.pSample) Ins[i].nLength = 0;
+		}
+		if (ins.pSample == p->pSample) AdjustSampleLoop(&ins);
+		m_nType = nType;
+	}
+	if (lpBuffer) GlobalFreePtr(lpBuffer);
+	m_pDeferredSamples = pDeferred;
+	return bOk;
+}
+
+
 void CSoundFile::AdjustSampleLoop(MODINSTRUMENT *pIns)
 //----------------------------------------------------
 {
@@ -1885,6 +2314,7 @@ BOOL CSoundFile::DestroySample(UINT nSample)
 	MODINSTRUMENT *pins = &Ins[nSample];
 	signed char *pSample = pins->pSample;
 	pins->pSample = NULL;
+	if (m_pDeferredSamples) m_pDeferredSamples[nSample].pSample = NULL;
 	pins->nLength = 0;
 	pins->uFlags &= ~(CHN_16BIT);
 	for (UINT i=0; i<MAX_CHANNELS; i++)
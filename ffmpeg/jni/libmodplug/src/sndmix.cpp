@@ -47,6 +47,7 @@ extern DWORD MPPASMCALL X86_Convert32To8(LPVOID lpBuffer, int *, DWORD nSamples,
 extern DWORD MPPASMCALL X86_Convert32To16(LPVOID lpBuffer, int *, DWORD nSamples, LPLONG, LPLONG);
 extern DWORD MPPASMCALL X86_Convert32To24(LPVOID lpBuffer, int *, DWORD nSamples, LPLONG, LPLONG);
 extern DWORD MPPASMCALL X86_Convert32To32(LPVOID lpBuffer, int *, DWORD nSamples, LPLONG, LPLONG);
+extern DWORD MPPASMCALL X86_Convert32ToFloat(LPVOID lpBuffer, int *, DWORD nSamples, LPLONG, LPLONG);
 extern UINT MPPASMCALL X86_AGC(int *pBuffer, UINT nSamples, UINT nAGC);
 extern VOID MPPASMCALL X86_Dither(int *pBuffer, UINT nSamples, UINT nBits);
 extern VOID MPPASMCALL X86_InterleaveFrontRear(int *pFrontBuf, int *pRearBuf, DWORD nSamples);
@@ -181,6 +182,7 @@ BOOL CSoundFile::InitPlayer(BOOL bReset)
 	if (m_nMaxMixChannels > MAX_CHANNELS) m_nMaxMixChannels = MAX_CHANNELS;
 	if (gdwMixingFreq < 4000) gdwMixingFreq = 4000;
 	if (gdwMixingFreq > MAX_SAMPLE_RATE) gdwMixingFreq = MAX_SAMPLE_RATE;
+	InitSysInfo();
 	gnVolumeRampSamples = (gdwMixingFreq * VOLUMERAMPLEN) / 100000;
 	if (gnVolumeRampSamples < 8) gnVolumeRampSamples = 8;
 	gnDryROfsVol = gnDryLOfsVol = 0;
@@ -251,7 +253,11 @@ UINT CSoundFile::Read(LPVOID lpDestBuffer, UINT cbBuffer)
 	if (gnBitsPerSample == 16) { lSampleSize *= 2; pCvt = X86_Convert32To16; }
 #ifndef MODPLUG_FASTSOUNDLIB
 	else if (gnBitsPerSample == 24) { lSampleSize *= 3; pCvt = X86_Convert32To24; }
-	else if (gnBitsPerSample == 32) { lSampleSize *= 4; pCvt = X86_Convert32To32; }
+	else if (gnBitsPerSample == 32)
+	{
+		lSampleSize *= 4;
+		pCvt = (gdwSoundSetup & SNDMIX_FLOATOUTPUT) ? X86_Convert32ToFloat : X86_Convert32To32;
+	}
 #endif
 	lMax = cbBuffer / lSampleSize;
 	if ((!lMax) || (!lpBuffer) || (!m_nChannels)) return 0;
@@ -340,6 +346,30 @@ MixDone:
 }
 
 
+// Plays the song without mixing until the end of the current tick, at most nMaxSamples.
+// Returns the number of samples skipped, 0 at the end of the song.
+UINT CSoundFile::SkipTick(UINT nMaxSamples)
+//-----------------------------------------
+{
+	UINT lCount;
+
+	if (m_dwSongFlags & SONG_ENDREACHED) return 0;
+	if (!m_nBufferCount)
+	{
+		if ((m_dwSongFlags & SONG_FADINGSONG) || (!ReadNote()))
+		{
+			m_dwSongFlags |= SONG_ENDREACHED;
+			return 0;
+		}
+	}
+	lCount = m_nBufferCount;
+	if (lCount > nMaxSamples) lCount = nMaxSamples;
+	SkipStereoMix(lCount);
+	m_nBufferCount -= lCount;
+	return lCount;
+}
+
+
 
 /////////////////////////////////////////////////////////////////////////////
 // Handles navigation/effects
@@ -30,17 +30,63 @@
 #endif
 
 #include "pitch.h"
+#include "mdct.h"
 
 #if defined(OPUS_HAVE_RTCD)
 
 # if defined(FIXED_POINT)
 opus_val32 (*const CELT_PITCH_XCORR_IMPL[OPUS_ARCHMASK+1])(const opus_val16 *,
-    const opus_val16 *, opus_val32 *, int , int) = {
+    const opus_val16 *, opus_val32 *, int , int, int) = {
   celt_pitch_xcorr_c,               /* ARMv4 */
   MAY_HAVE_EDSP(celt_pitch_xcorr),  /* EDSP */
   MAY_HAVE_MEDIA(celt_pitch_xcorr), /* Media */
   MAY_HAVE_NEON(celt_pitch_xcorr)   /* NEON */
 };
+
+#  if defined(OPUS_ARM_MAY_HAVE_NEON_INTR)
+void (*const XCORR_KERNEL_IMPL[OPUS_ARCHMASK+1])(const opus_val16 *,
+    const opus_val16 *, opus_val32 *, int) = {
+  xcorr_kernel_c,                   /* ARMv4 */
+  xcorr_kernel_c,                   /* EDSP */
+  xcorr_kernel_c,                   /* Media */
+  xcorr_kernel_neon_fixed           /* NEON */
+};
+
+opus_val32 (*const CELT_INNER_PROD_IMPL[OPUS_ARCHMASK+1])(const opus_val16 *,
+    const opus_val16 *, int) = {
+  celt_inner_prod_c,                /* ARMv4 */
+  celt_inner_prod_c,                /* EDSP */
+  celt_inner_prod_c,                /* Media */
+  celt_inner_prod_neon              /* NEON */
+};
+
+void (*const DUAL_INNER_PROD_IMPL[OPUS_ARCHMASK+1])(const opus_val16 *,
+    const opus_val16 *, const opus_val16 *, int, opus_val32 *,
+    opus_val32 *) = {
+  dual_inner_prod_c,                /* ARMv4 */
+  dual_inner_prod_c,                /* EDSP */
+  dual_inner_prod_c,                /* Media */
+  dual_inner_prod_neon              /* NEON */
+};
+
+void (*const COMB_FILTER_CONST_IMPL[OPUS_ARCHMASK+1])(opus_val32 *,
+    opus_val32 *, int, int, opus_val16, opus_val16, opus_val16) = {
+  comb_filter_const_c,              /* ARMv4 */
+  comb_filter_const_c,              /* EDSP */
+  comb_filter_const_c,              /* Media */
+  comb_filter_const_neon            /* NEON */
+};
+
+void (*const CLT_MDCT_BACKWARD_IMPL[OPUS_ARCHMASK+1])(const mdct_lookup *,
+    kiss_fft_scalar *, kiss_fft_scalar * OPUS_RESTRICT,
+    const opus_val16 * OPUS_RESTRICT, int, int, int) = {
+  clt_mdct_backward_c,              /* ARMv4 */
+  clt_mdct_backward_c,              /* EDSP */
+  clt_mdct_backward_c,              /* Media */
+  clt_mdct_backward_neon            /* NEON */
+};
+#  endif
+
 # else
 #  error "Floating-point implementation is not supported by ARM asm yet." \
  "Reconfigure with --disable-rtcd or send patches."
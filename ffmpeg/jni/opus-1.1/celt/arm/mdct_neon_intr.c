@@ -0,0 +1,312 @@
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <arm_neon.h>
+#include "mdct.h"
+#include "kiss_fft.h"
+#include "_kiss_fft_guts.h"
+#include "stack_alloc.h"
+
+#if defined(FIXED_POINT)
+
+/* S_MUL(a, t) for 16-bit twiddles already shifted up by 16. The twiddles,
+   sine and window are all non-negative, so vqdmulhq_s32() never saturates
+   and matches the C macro exactly. */
+#define S_MUL_NEON(a, t) vqdmulhq_s32(a, t)
+
+static OPUS_INLINE int32x4_t rev_s32_neon(int32x4_t v)
+{
+   v = vrev64q_s32(v);
+   return vcombine_s32(vget_high_s32(v), vget_low_s32(v));
+}
+
+/* Loads p[0..3] as 32-bit values shifted up by 16 */
+static OPUS_INLINE int32x4_t load_16x4_neon(const opus_int16 *p)
+{
+   return vshll_n_s16(vld1_s16(p), 16);
+}
+
+/* Loads p[3], p[2], p[1], p[0] as 32-bit values shifted up by 16 */
+static OPUS_INLINE int32x4_t load_16x4_rev_neon(const opus_int16 *p)
+{
+   return vshll_n_s16(vrev64_s16(vld1_s16(p)), 16);
+}
+
+/* Loads tw[0], tw[stride], tw[2*stride] and tw[3*stride], the real and
+   imaginary parts shifted up by 16. The FFT twiddles are never -32768, so
+   S_MUL_NEON() stays exact with them too. */
+static OPUS_INLINE int32x4x2_t load_twiddles_neon(const kiss_twiddle_cpx *tw,
+      size_t stride)
+{
+   int16x4x2_t v;
+   int32x4x2_t t;
+   v.val[0] = vdup_n_s16(0);
+   v.val[1] = vdup_n_s16(0);
+   v = vld2_lane_s16(&tw[0].r, v, 0);
+   v = vld2_lane_s16(&tw[stride].r, v, 1);
+   v = vld2_lane_s16(&tw[2*stride].r, v, 2);
+   v = vld2_lane_s16(&tw[3*stride].r, v, 3);
+   t.val[0] = vshll_n_s16(v.val[0], 16);
+   t.val[1] = vshll_n_s16(v.val[1], 16);
+   return t;
+}
+
+/* C_MULC() of four complex values */
+static OPUS_INLINE int32x4x2_t c_mulc_neon(int32x4x2_t a, int32x4x2_t t)
+{
+   int32x4x2_t m;
+   m.val[0] = vaddq_s32(S_MUL_NEON(a.val[0], t.val[0]), S_MUL_NEON(a.val[1], t.val[1]));
+   m.val[1] = vsubq_s32(S_MUL_NEON(a.val[1], t.val[0]), S_MUL_NEON(a.val[0], t.val[1]));
+   return m;
+}
+
+/* ki_bfly4() from kiss_fft.c, four butterflies at a time */
+static void ki_bfly4_neon(kiss_fft_cpx *Fout, const size_t fstride,
+      const kiss_fft_state *st, int m, int N, int mm)
+{
+   const kiss_twiddle_cpx *tw1,*tw2,*tw3;
+   const size_t m2=2*m;
+   const size_t m3=3*m;
+   int i, j;
+
+   kiss_fft_cpx * Fout_beg = Fout;
+   for (i=0;i<N;i++)
+   {
+      Fout = Fout_beg + i*mm;
+      tw3 = tw2 = tw1 = st->twiddles;
+      for (j=0;j+4<=m;j+=4)
+      {
+         int32x4x2_t f0, s0, s1, s2, y;
+         int32x4_t s3r, s3i, s4r, s4i, s5r, s5i;
+         s0 = c_mulc_neon(vld2q_s32(&Fout[m].r), load_twiddles_neon(tw1, fstride));
+         s1 = c_mulc_neon(vld2q_s32(&Fout[m2].r), load_twiddles_neon(tw2, 2*fstride));
+         s2 = c_mulc_neon(vld2q_s32(&Fout[m3].r), load_twiddles_neon(tw3, 3*fstride));
+         f0 = vld2q_s32(&Fout[0].r);
+
+         s5r = vsubq_s32(f0.val[0], s1.val[0]);
+         s5i = vsubq_s32(f0.val[1], s1.val[1]);
+         f0.val[0] = vaddq_s32(f0.val[0], s1.val[0]);
+         f0.val[1] = vaddq_s32(f0.val[1], s1.val[1]);
+         s3r = vaddq_s32(s0.val[0], s2.val[0]);
+         s3i = vaddq_s32(s0.val[1], s2.val[1]);
+         s4r = vsubq_s32(s0.val[0], s2.val[0]);
+         s4i = vsubq_s32(s0.val[1], s2.val[1]);
+         y.val[0] = vsubq_s32(f0.val[0], s3r);
+         y.val[1] = vsubq_s32(f0.val[1], s3i);
+         vst2q_s32(&Fout[m2].r, y);
+         y.val[0] = vaddq_s32(f0.val[0], s3r);
+         y.val[1] = vaddq_s32(f0.val[1], s3i);
+         vst2q_s32(&Fout[0].r, y);
+         tw1 += 4*fstride;
+         tw2 += 8*fstride;
+         tw3 += 12*fstride;
+
+         y.val[0] = vsubq_s32(s5r, s4i);
+         y.val[1] = vaddq_s32(s5i, s4r);
+         vst2q_s32(&Fout[m].r, y);
+         y.val[0] = vaddq_s32(s5r, s4i);
+         y.val[1] = vsubq_s32(s5i, s4r);
+         vst2q_s32(&Fout[m3].r, y);
+         Fout += 4;
+      }
+      for (;j<m;j++)
+      {
+         kiss_fft_cpx scratch[6];
+         C_MULC(scratch[0],Fout[m] , *tw1 );
+         C_MULC(scratch[1],Fout[m2] , *tw2 );
+         C_MULC(scratch[2],Fout[m3] , *tw3 );
+
+         C_SUB( scratch[5] , *Fout, scratch[1] );
+         C_ADDTO(*Fout, scratch[1]);
+         C_ADD( scratch[3] , scratch[0] , scratch[2] );
+         C_SUB( scratch[4] , scratch[0] , scratch[2] );
+         C_SUB( Fout[m2], *Fout, scratch[3] );
+         tw1 += fstride;
+         tw2 += fstride*2;
+         tw3 += fstride*3;
+         C_ADDTO( *Fout , scratch[3] );
+
+         Fout[m].r = scratch[5].r - scratch[4].i;
+         Fout[m].i = scratch[5].i + scratch[4].r;
+         Fout[m3].r = scratch[5].r + scratch[4].i;
+         Fout[m3].i = scratch[5].i - scratch[4].r;
+         ++Fout;
+      }
+   }
+}
+
+/* The pre- and post-rotation are only vectorized for the long, unstrided
+   transform (shift == 0, stride == 1), which has contiguous inputs and
+   twiddles. That's the common case of a 20 ms frame without transients. The
+   FFT and the TDAC are vectorized for all sizes. */
+void clt_mdct_backward_neon(const mdct_lookup *l, kiss_fft_scalar *in,
+      kiss_fft_scalar * OPUS_RESTRICT out,
+      const opus_val16 * OPUS_RESTRICT window, int overlap, int shift, int stride)
+{
+   int i;
+   int N, N2, N4;
+   int contiguous;
+   kiss_twiddle_scalar sine;
+   const kiss_twiddle_scalar *t;
+   int32x4_t vecSine;
+   VARDECL(kiss_fft_scalar, f2);
+   SAVE_STACK;
+
+   contiguous = shift == 0 && stride == 1;
+   N = l->n;
+   N >>= shift;
+   N2 = N>>1;
+   N4 = N>>2;
+   ALLOC(f2, N2, kiss_fft_scalar);
+   /* sin(x) ~= x here */
+   sine = TRIG_UPSCALE*(QCONST16(0.7853981f, 15)+N2)/N;
+   vecSine = vdupq_n_s32((opus_int32)sine << 16);
+   t = &l->trig[0];
+
+   /* Pre-rotate */
+   {
+      const kiss_fft_scalar * OPUS_RESTRICT xp2 = in+stride*(N2-1);
+      kiss_fft_scalar * OPUS_RESTRICT yp = f2;
+      for(i=0;contiguous&&i<N4-3;i+=4)
+      {
+         int32x4x2_t a, b, y;
+         int32x4_t x1, x2, t0, t1, yr, yi;
+         a = vld2q_s32(&in[2*i]);
+         b = vld2q_s32(&xp2[-2*i-7]);
+         x1 = a.val[0];
+         x2 = rev_s32_neon(b.val[1]);
+         t0 = load_16x4_neon(&t[i]);
+         t1 = load_16x4_rev_neon(&t[N4-i-3]);
+         yr = vsubq_s32(S_MUL_NEON(x1, t1), S_MUL_NEON(x2, t0));
+         yi = vnegq_s32(vaddq_s32(S_MUL_NEON(x2, t1), S_MUL_NEON(x1, t0)));
+         /* works because the cos is nearly one */
+         y.val[0] = vsubq_s32(yr, S_MUL_NEON(yi, vecSine));
+         y.val[1] = vaddq_s32(yi, S_MUL_NEON(yr, vecSine));
+         vst2q_s32(&yp[2*i], y);
+      }
+      for(;i<N4;i++)
+      {
+         kiss_fft_scalar yr, yi;
+         yr = -S_MUL(xp2[-2*i*stride], t[i<<shift]) + S_MUL(in[2*i*stride],t[(N4-i)<<shift]);
+         yi =  -S_MUL(xp2[-2*i*stride], t[(N4-i)<<shift]) - S_MUL(in[2*i*stride],t[i<<shift]);
+         yp[2*i] = yr - S_MUL(yi,sine);
+         yp[2*i+1] = yi + S_MUL(yr,sine);
+      }
+   }
+
+   /* Inverse N/4 complex FFT. This one should *not* downscale even in fixed-point */
+   opus_ifft_bfly4(l->kfft[shift], (kiss_fft_cpx *)f2,
+         (kiss_fft_cpx *)(out+(overlap>>1)), ki_bfly4_neon);
+
+   /* Post-rotate and de-shuffle from both ends of the buffer at once to make
+      it in-place. Pair i and pair N4-1-i are processed together, four of
+      each per iteration. */
+   {
+      kiss_fft_scalar * OPUS_RESTRICT yp = out+(overlap>>1);
+      for(i=0;contiguous&&i+4<=N4>>1;i+=4)
+      {
+         int32x4x2_t p, q, r, s;
+         int32x4_t re1, im1, t0, t1, t2, t3, yr0, yi0, yr1, yi1;
+         kiss_fft_scalar *yp1 = yp+2*(N4-4-i);
+         p = vld2q_s32(&yp[2*i]);
+         q = vld2q_s32(yp1);
+         re1 = rev_s32_neon(q.val[0]);
+         im1 = rev_s32_neon(q.val[1]);
+         t0 = load_16x4_neon(&t[i]);
+         t1 = load_16x4_rev_neon(&t[N4-i-3]);
+         t2 = load_16x4_rev_neon(&t[N4-i-4]);
+         t3 = load_16x4_neon(&t[i+1]);
+         /* We'd scale up by 2 here, but instead it's done when mixing the windows */
+         yr0 = vsubq_s32(S_MUL_NEON(p.val[0], t0), S_MUL_NEON(p.val[1], t1));
+         yi0 = vaddq_s32(S_MUL_NEON(p.val[1], t0), S_MUL_NEON(p.val[0], t1));
+         yr1 = vsubq_s32(S_MUL_NEON(re1, t2), S_MUL_NEON(im1, t3));
+         yi1 = vaddq_s32(S_MUL_NEON(im1, t2), S_MUL_NEON(re1, t3));
+         /* works because the cos is nearly one */
+         r.val[0] = vsubq_s32(S_MUL_NEON(yi0, vecSine), yr0);
+         r.val[1] = vaddq_s32(yi1, S_MUL_NEON(yr1, vecSine));
+         s.val[0] = rev_s32_neon(vsubq_s32(S_MUL_NEON(yi1, vecSine), yr1));
+         s.val[1] = rev_s32_neon(vaddq_s32(yi0, S_MUL_NEON(yr0, vecSine)));
+         vst2q_s32(&yp[2*i], r);
+         vst2q_s32(yp1, s);
+      }
+      /* Loop to (N4+1)>>1 to handle odd N4. When N4 is odd, the
+         middle pair will be computed twice. */
+      for(;i<(N4+1)>>1;i++)
+      {
+         kiss_fft_scalar * OPUS_RESTRICT yp0 = yp+2*i;
+         kiss_fft_scalar * OPUS_RESTRICT yp1 = yp+2*(N4-1-i);
+         kiss_fft_scalar re, im, yr, yi;
+         kiss_twiddle_scalar t0, t1;
+         re = yp0[0];
+         im = yp0[1];
+         t0 = t[i<<shift];
+         t1 = t[(N4-i)<<shift];
+         yr = S_MUL(re,t0) - S_MUL(im,t1);
+         yi = S_MUL(im,t0) + S_MUL(re,t1);
+         re = yp1[0];
+         im = yp1[1];
+         yp0[0] = -(yr - S_MUL(yi,sine));
+         yp1[1] = yi + S_MUL(yr,sine);
+
+         t0 = t[(N4-i-1)<<shift];
+         t1 = t[(i+1)<<shift];
+         yr = S_MUL(re,t0) - S_MUL(im,t1);
+         yi = S_MUL(im,t0) + S_MUL(re,t1);
+         yp1[0] = -(yr - S_MUL(yi,sine));
+         yp0[1] = yi + S_MUL(yr,sine);
+      }
+   }
+
+   /* Mirror on both sides for TDAC */
+   {
+      kiss_fft_scalar * OPUS_RESTRICT xp1 = out+overlap-1;
+      for(i=0;i+4<=overlap>>1;i+=4)
+      {
+         int32x4_t x1, x2, w1, w2;
+         x2 = vld1q_s32(&out[i]);
+         x1 = rev_s32_neon(vld1q_s32(&xp1[-i-3]));
+         w1 = load_16x4_neon(&window[i]);
+         w2 = load_16x4_rev_neon(&window[overlap-i-4]);
+         vst1q_s32(&out[i], vsubq_s32(S_MUL_NEON(x2, w2), S_MUL_NEON(x1, w1)));
+         vst1q_s32(&xp1[-i-3], rev_s32_neon(
+               vaddq_s32(S_MUL_NEON(x2, w1), S_MUL_NEON(x1, w2))));
+      }
+      for(;i<overlap/2;i++)
+      {
+         kiss_fft_scalar x1, x2;
+         x1 = xp1[-i];
+         x2 = out[i];
+         out[i] = MULT16_32_Q15(window[overlap-1-i], x2) - MULT16_32_Q15(window[i], x1);
+         xp1[-i] = MULT16_32_Q15(window[i], x2) + MULT16_32_Q15(window[overlap-1-i], x1);
+      }
+   }
+   RESTORE_STACK;
+}
+
+#endif
@@ -34,7 +34,7 @@
 
 #  if defined(OPUS_ARM_MAY_HAVE_NEON)
 opus_val32 celt_pitch_xcorr_neon(const opus_val16 *_x, const opus_val16 *_y,
-    opus_val32 *xcorr, int len, int max_pitch);
+    opus_val32 *xcorr, int len, int max_pitch, int arch);
 #  endif
 
 #  if defined(OPUS_ARM_MAY_HAVE_MEDIA)
@@ -43,13 +43,79 @@ opus_val32 celt_pitch_xcorr_neon(const opus_val16 *_x, const opus_val16 *_y,
 
 #  if defined(OPUS_ARM_MAY_HAVE_EDSP)
 opus_val32 celt_pitch_xcorr_edsp(const opus_val16 *_x, const opus_val16 *_y,
-    opus_val32 *xcorr, int len, int max_pitch);
+    opus_val32 *xcorr, int len, int max_pitch, int arch);
 #  endif
 
-#  if !defined(OPUS_HAVE_RTCD)
+#  if !defined(OPUS_HAVE_RTCD) && defined(OPUS_ARM_ASM)
 #   define OVERRIDE_PITCH_XCORR (1)
 #   define celt_pitch_xcorr(_x, _y, xcorr, len, max_pitch, arch) \
-  ((void)(arch),PRESUME_NEON(celt_pitch_xcorr)(_x, _y, xcorr, len, max_pitch))
+  ((void)(arch),PRESUME_NEON(celt_pitch_xcorr)(_x, _y, xcorr, len, max_pitch, \
+        arch))
+#  endif
+
+#  if defined(OPUS_ARM_MAY_HAVE_NEON_INTR) || \
+  defined(OPUS_ARM_PRESUME_NEON_INTR)
+void xcorr_kernel_neon_fixed(const opus_val16 *x, const opus_val16 *y,
+    opus_val32 sum[4], int len);
+
+opus_val32 celt_inner_prod_neon(const opus_val16 *x, const opus_val16 *y,
+    int N);
+
+void dual_inner_prod_neon(const opus_val16 *x, const opus_val16 *y01,
+    const opus_val16 *y02, int N, opus_val32 *xy1, opus_val32 *xy2);
+
+void comb_filter_const_neon(opus_val32 *y, opus_val32 *x, int T, int N,
+    opus_val16 g10, opus_val16 g11, opus_val16 g12);
+#  endif
+
+#  if defined(OPUS_HAVE_RTCD) && defined(OPUS_ARM_MAY_HAVE_NEON_INTR)
+
+extern void (*const XCORR_KERNEL_IMPL[OPUS_ARCHMASK+1])(const opus_val16 *,
+    const opus_val16 *, opus_val32 *, int);
+
+extern opus_val32 (*const CELT_INNER_PROD_IMPL[OPUS_ARCHMASK+1])(
+    const opus_val16 *, const opus_val16 *, int);
+
+extern void (*const DUAL_INNER_PROD_IMPL[OPUS_ARCHMASK+1])(const opus_val16 *,
+    const opus_val16 *, const opus_val16 *, int, opus_val32 *, opus_val32 *);
+
+extern void (*const COMB_FILTER_CONST_IMPL[OPUS_ARCHMASK+1])(opus_val32 *,
+    opus_val32 *, int, int, opus_val16, opus_val16, opus_val16);
+
+#   define OVERRIDE_XCORR_KERNEL
+#   define xcorr_kernel(x, y, sum, len, arch) \
+  ((*XCORR_KERNEL_IMPL[(arch)&OPUS_ARCHMASK])(x, y, sum, len))
+
+#   define OVERRIDE_CELT_INNER_PROD
+#   define celt_inner_prod(x, y, N, arch) \
+  ((*CELT_INNER_PROD_IMPL[(arch)&OPUS_ARCHMASK])(x, y, N))
+
+#   define OVERRIDE_DUAL_INNER_PROD
+#   define dual_inner_prod(x, y01, y02, N, xy1, xy2, arch) \
+  ((*DUAL_INNER_PROD_IMPL[(arch)&OPUS_ARCHMASK])(x, y01, y02, N, xy1, xy2))
+
+#   define OVERRIDE_COMB_FILTER_CONST
+#   define comb_filter_const(y, x, T, N, g10, g11, g12, arch) \
+  ((*COMB_FILTER_CONST_IMPL[(arch)&OPUS_ARCHMASK])(y, x, T, N, g10, g11, g12))
+
+#  elif defined(OPUS_ARM_PRESUME_NEON_INTR)
+
+#   define OVERRIDE_XCORR_KERNEL
+#   define xcorr_kernel(x, y, sum, len, arch) \
+  ((void)(arch),xcorr_kernel_neon_fixed(x, y, sum, len))
+
+#   define OVERRIDE_CELT_INNER_PROD
+#   define celt_inner_prod(x, y, N, arch) \
+  ((void)(arch),celt_inner_prod_neon(x, y, N))
+
+#   define OVERRIDE_DUAL_INNER_PROD
+#   define dual_inner_prod(x, y01, y02, N, xy1, xy2, arch) \
+  ((void)(arch),dual_inner_prod_neon(x, y01, y02, N, xy1, xy2))
+
+#   define OVERRIDE_COMB_FILTER_CONST
+#   define comb_filter_const(y, x, T, N, g10, g11, g12, arch) \
+  ((void)(arch),comb_filter_const_neon(y, x, T, N, g10, g11, g12))
+
 #  endif
 
 # endif
@@ -0,0 +1,187 @@
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <arm_neon.h>
+#include "pitch.h"
+
+#if defined(FIXED_POINT)
+
+/* Sum of the four lanes, wrapping like the scalar accumulation */
+static OPUS_INLINE opus_val32 hsum_s32_neon(int32x4_t v)
+{
+   int32x2_t s = vadd_s32(vget_low_s32(v), vget_high_s32(v));
+   return vget_lane_s32(vpadd_s32(s, s), 0);
+}
+
+void xcorr_kernel_neon_fixed(const opus_val16 *x, const opus_val16 *y,
+      opus_val32 sum[4], int len)
+{
+   int j;
+   int32x4_t a;
+   int16x4_t y0;
+
+   celt_assert(len>=3);
+   a = vld1q_s32(sum);
+   /* y0 holds y[j..j+3]. The scalar kernel reads up to y[len+2], so the
+      loops never load past that. */
+   y0 = vld1_s16(y);
+   for (j=0;j+8<len;j+=8)
+   {
+      int16x8_t xx = vld1q_s16(&x[j]);
+      int16x8_t yy = vld1q_s16(&y[j+4]);
+      int16x4_t x0 = vget_low_s16(xx);
+      int16x4_t x4 = vget_high_s16(xx);
+      int16x4_t y4 = vget_low_s16(yy);
+      int16x4_t y8 = vget_high_s16(yy);
+      a = vmlal_lane_s16(a, y0, x0, 0);
+      a = vmlal_lane_s16(a, y4, x4, 0);
+      a = vmlal_lane_s16(a, vext_s16(y0, y4, 1), x0, 1);
+      a = vmlal_lane_s16(a, vext_s16(y4, y8, 1), x4, 1);
+      a = vmlal_lane_s16(a, vext_s16(y0, y4, 2), x0, 2);
+      a = vmlal_lane_s16(a, vext_s16(y4, y8, 2), x4, 2);
+      a = vmlal_lane_s16(a, vext_s16(y0, y4, 3), x0, 3);
+      a = vmlal_lane_s16(a, vext_s16(y4, y8, 3), x4, 3);
+      y0 = y8;
+   }
+   for (;j<len;j++)
+   {
+      a = vmlal_s16(a, y0, vdup_n_s16(x[j]));
+      if (j+1<len)
+         y0 = vext_s16(y0, vld1_dup_s16(&y[j+4]), 1);
+   }
+   vst1q_s32(sum, a);
+}
+
+opus_val32 celt_inner_prod_neon(const opus_val16 *x, const opus_val16 *y,
+      int N)
+{
+   int i;
+   opus_val32 xy;
+   int32x4_t xy0 = vdupq_n_s32(0);
+   int32x4_t xy1 = vdupq_n_s32(0);
+
+   for (i=0;i<N-7;i+=8)
+   {
+      int16x8_t xx = vld1q_s16(&x[i]);
+      int16x8_t yy = vld1q_s16(&y[i]);
+      xy0 = vmlal_s16(xy0, vget_low_s16(xx), vget_low_s16(yy));
+      xy1 = vmlal_s16(xy1, vget_high_s16(xx), vget_high_s16(yy));
+   }
+   if (i<N-3)
+   {
+      xy0 = vmlal_s16(xy0, vld1_s16(&x[i]), vld1_s16(&y[i]));
+      i += 4;
+   }
+   xy = hsum_s32_neon(vaddq_s32(xy0, xy1));
+
+   for (;i<N;i++)
+      xy = MAC16_16(xy, x[i], y[i]);
+   return xy;
+}
+
+void dual_inner_prod_neon(const opus_val16 *x, const opus_val16 *y01,
+      const opus_val16 *y02, int N, opus_val32 *xy1, opus_val32 *xy2)
+{
+   int i;
+   opus_val32 xy01, xy02;
+   int32x4_t sum1 = vdupq_n_s32(0);
+   int32x4_t sum2 = vdupq_n_s32(0);
+
+   for (i=0;i<N-7;i+=8)
+   {
+      int16x8_t xx = vld1q_s16(&x[i]);
+      int16x8_t yy1 = vld1q_s16(&y01[i]);
+      int16x8_t yy2 = vld1q_s16(&y02[i]);
+      sum1 = vmlal_s16(sum1, vget_low_s16(xx), vget_low_s16(yy1));
+      sum1 = vmlal_s16(sum1, vget_high_s16(xx), vget_high_s16(yy1));
+      sum2 = vmlal_s16(sum2, vget_low_s16(xx), vget_low_s16(yy2));
+      sum2 = vmlal_s16(sum2, vget_high_s16(xx), vget_high_s16(yy2));
+   }
+   xy01 = hsum_s32_neon(sum1);
+   xy02 = hsum_s32_neon(sum2);
+
+   for (;i<N;i++)
+   {
+      xy01 = MAC16_16(xy01, x[i], y01[i]);
+      xy02 = MAC16_16(xy02, x[i], y02[i]);
+   }
+   *xy1 = xy01;
+   *xy2 = xy02;
+}
+
+/* vqdmulhq_s32(x, g<<16) is MULT16_32_Q15(g, x); it can only saturate for
+   g == -32768, which the comb filter gains never reach. The filter may run
+   in place (y == x): with T >= COMBFILTER_MINPERIOD the loads only see
+   outputs of earlier iterations, exactly like the scalar loop. */
+void comb_filter_const_neon(opus_val32 *y, opus_val32 *x, int T, int N,
+      opus_val16 g10, opus_val16 g11, opus_val16 g12)
+{
+   int i;
+   opus_val32 x0, x1, x2, x3, x4;
+   int32x4_t vecG10, vecG11, vecG12;
+
+   vecG10 = vdupq_n_s32((opus_int32)g10 << 16);
+   vecG11 = vdupq_n_s32((opus_int32)g11 << 16);
+   vecG12 = vdupq_n_s32((opus_int32)g12 << 16);
+   for (i=0;i<N-3;i+=4)
+   {
+      const opus_val32 *xp = &x[i-T-2];
+      int32x4_t vecX4 = vld1q_s32(&xp[0]);
+      int32x4_t vecX3 = vld1q_s32(&xp[1]);
+      int32x4_t vecX2 = vld1q_s32(&xp[2]);
+      int32x4_t vecX1 = vld1q_s32(&xp[3]);
+      int32x4_t vecX0 = vld1q_s32(&xp[4]);
+      int32x4_t vecY = vld1q_s32(&x[i]);
+      vecY = vaddq_s32(vecY, vqdmulhq_s32(vecX2, vecG10));
+      vecY = vaddq_s32(vecY, vqdmulhq_s32(vaddq_s32(vecX1, vecX3), vecG11));
+      vecY = vaddq_s32(vecY, vqdmulhq_s32(vaddq_s32(vecX0, vecX4), vecG12));
+      vst1q_s32(&y[i], vecY);
+   }
+   if (i<N)
+   {
+      x4 = x[i-T-2];
+      x3 = x[i-T-1];
+      x2 = x[i-T];
+      x1 = x[i-T+1];
+      for (;i<N;i++)
+      {
+         x0=x[i-T+2];
+         y[i] = x[i]
+                  + MULT16_32_Q15(g10,x2)
+                  + MULT16_32_Q15(g11,ADD32(x1,x3))
+                  + MULT16_32_Q15(g12,ADD32(x0,x4));
+         x4=x3;
+         x3=x2;
+         x2=x1;
+         x1=x0;
+      }
+   }
+}
+
+#endif
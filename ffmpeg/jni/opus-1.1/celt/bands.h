@@ -101,11 +101,12 @@ void haar1(celt_norm *X, int N0, int stride);
 void quant_all_bands(int encode, const CELTMode *m, int start, int end,
       celt_norm * X, celt_norm * Y, unsigned char *collapse_masks, const celt_ener *bandE, int *pulses,
       int shortBlocks, int spread, int dual_stereo, int intensity, int *tf_res,
-      opus_int32 total_bits, opus_int32 balance, ec_ctx *ec, int M, int codedBands, opus_uint32 *seed);
+      opus_int32 total_bits, opus_int32 balance, ec_ctx *ec, int M, int codedBands,
+      opus_uint32 *seed, int arch);
 
 void anti_collapse(const CELTMode *m, celt_norm *X_, unsigned char *collapse_masks, int LM, int C, int size,
       int start, int end, opus_val16 *logE, opus_val16 *prev1logE,
-      opus_val16 *prev2logE, int *pulses, opus_uint32 seed);
+      opus_val16 *prev2logE, int *pulses, opus_uint32 seed, int arch);
 
 opus_uint32 celt_lcg_rand(opus_uint32 seed);
 
@@ -116,6 +116,10 @@ typedef struct {
 #define OPUS_SET_ENERGY_MASK_REQUEST    10026
 #define OPUS_SET_ENERGY_MASK(x) OPUS_SET_ENERGY_MASK_REQUEST, __opus_check_val16_ptr(x)
 
+/* Selects the run-time architecture, clamped to what the CPU supports */
+#define CELT_SET_ARCH_REQUEST    10028
+#define CELT_SET_ARCH(x) CELT_SET_ARCH_REQUEST, __opus_check_int(x)
+
 /* Encoder stuff */
 
 int celt_encoder_get_size(int channels);
@@ -200,7 +204,7 @@ void celt_preemphasis(const opus_val16 * OPUS_RESTRICT pcmp, celt_sig * OPUS_RES
 
 void comb_filter(opus_val32 *y, opus_val32 *x, int T0, int T1, int N,
       opus_val16 g0, opus_val16 g1, int tapset0, int tapset1,
-      const opus_val16 *window, int overlap);
+      const opus_val16 *window, int overlap, int arch);
 
 void init_caps(const CELTMode *m,int *cap,int LM,int C);
 
@@ -208,7 +212,7 @@ void init_caps(const CELTMode *m,int *cap,int LM,int C);
 void deemphasis(celt_sig *in[], opus_val16 *pcm, int N, int C, int downsample, const opus_val16 *coef, celt_sig *mem, celt_sig * OPUS_RESTRICT scratch);
 
 void compute_inv_mdcts(const CELTMode *mode, int shortBlocks, celt_sig *X,
-      celt_sig * OPUS_RESTRICT out_mem[], int C, int LM);
+      celt_sig * OPUS_RESTRICT out_mem[], int C, int LM, int arch);
 #endif
 
 #ifdef __cplusplus
@@ -31,7 +31,8 @@
 #include "opus_types.h"
 #include "opus_defines.h"
 
-#if defined(OPUS_HAVE_RTCD) && defined(OPUS_ARM_ASM)
+#if defined(OPUS_HAVE_RTCD) && \
+  (defined(OPUS_ARM_ASM) || defined(OPUS_ARM_MAY_HAVE_NEON_INTR))
 #include "arm/armcpu.h"
 
 /* We currently support 4 ARM variants:
@@ -42,6 +43,15 @@
  */
 #define OPUS_ARCHMASK 3
 
+#elif defined(OPUS_HAVE_RTCD) && defined(OPUS_X86_MAY_HAVE_SSE4_1)
+#include "x86/x86cpu.h"
+
+/* We currently support 2 x86 variants:
+ * arch[0] -> non-SIMD
+ * arch[1] -> SSE4.1
+ */
+#define OPUS_ARCHMASK 1
+
 #else
 #define OPUS_ARCHMASK 0
 
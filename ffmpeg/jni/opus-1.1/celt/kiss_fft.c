@@ -665,7 +665,8 @@ void opus_fft(const kiss_fft_state *st,const kiss_fft_cpx *fin,kiss_fft_cpx *fou
     }
 }
 
-void opus_ifft(const kiss_fft_state *st,const kiss_fft_cpx *fin,kiss_fft_cpx *fout)
+static OPUS_INLINE void opus_ifft_impl(const kiss_fft_state *st,
+      const kiss_fft_cpx *fin, kiss_fft_cpx *fout, ki_bfly4_func bfly4)
 {
    int m2, m;
    int p;
@@ -702,7 +703,7 @@ void opus_ifft(const kiss_fft_state *st,const kiss_fft_cpx *fin,kiss_fft_cpx *fo
          ki_bfly2(fout,fstride[i]<<shift,st,m, fstride[i], m2);
          break;
       case 4:
-         ki_bfly4(fout,fstride[i]<<shift,st,m, fstride[i], m2);
+         bfly4(fout,fstride[i]<<shift,st,m, fstride[i], m2);
          break;
 #ifndef RADIX_TWO_ONLY
       case 3:
@@ -717,3 +718,14 @@ void opus_ifft(const kiss_fft_state *st,const kiss_fft_cpx *fin,kiss_fft_cpx *fo
    }
 }
 
+void opus_ifft(const kiss_fft_state *st,const kiss_fft_cpx *fin,kiss_fft_cpx *fout)
+{
+   opus_ifft_impl(st, fin, fout, ki_bfly4);
+}
+
+void opus_ifft_bfly4(const kiss_fft_state *st,const kiss_fft_cpx *fin,
+      kiss_fft_cpx *fout, ki_bfly4_func bfly4)
+{
+   opus_ifft_impl(st, fin, fout, bfly4);
+}
+
@@ -130,6 +130,14 @@ kiss_fft_state *opus_fft_alloc(int nfft,void * mem,size_t * lenmem);
 void opus_fft(const kiss_fft_state *cfg,const kiss_fft_cpx *fin,kiss_fft_cpx *fout);
 void opus_ifft(const kiss_fft_state *cfg,const kiss_fft_cpx *fin,kiss_fft_cpx *fout);
 
+/* Radix-4 inverse butterfly, see ki_bfly4() in kiss_fft.c */
+typedef void (*ki_bfly4_func)(kiss_fft_cpx *Fout, const size_t fstride,
+      const kiss_fft_state *st, int m, int N, int mm);
+
+/* Same as opus_ifft(), with the radix-4 stages done by bfly4 */
+void opus_ifft_bfly4(const kiss_fft_state *cfg,const kiss_fft_cpx *fin,
+      kiss_fft_cpx *fout, ki_bfly4_func bfly4);
+
 void opus_fft_free(const kiss_fft_state *cfg);
 
 #ifdef __cplusplus
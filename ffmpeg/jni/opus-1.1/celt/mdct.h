@@ -63,8 +63,22 @@ void clt_mdct_forward(const mdct_lookup *l, kiss_fft_scalar *in,
 
 /** Compute a backward MDCT (no scaling) and performs weighted overlap-add
     (scales implicitly by 1/2) */
-void clt_mdct_backward(const mdct_lookup *l, kiss_fft_scalar *in,
+void clt_mdct_backward_c(const mdct_lookup *l, kiss_fft_scalar *in,
       kiss_fft_scalar * OPUS_RESTRICT out,
       const opus_val16 * OPUS_RESTRICT window, int overlap, int shift, int stride);
 
+#if defined(OPUS_X86_MAY_HAVE_SSE4_1) && defined(FIXED_POINT)
+#include "x86/mdct_sse.h"
+#endif
+
+#if (defined(OPUS_ARM_MAY_HAVE_NEON_INTR) || \
+  defined(OPUS_ARM_PRESUME_NEON_INTR)) && defined(FIXED_POINT)
+#include "arm/mdct_arm.h"
+#endif
+
+#if !defined(OVERRIDE_CLT_MDCT_BACKWARD)
+#define clt_mdct_backward(_l, _in, _out, _window, _overlap, _shift, _stride, _arch) \
+   ((void)(_arch),clt_mdct_backward_c(_l, _in, _out, _window, _overlap, _shift, _stride))
+#endif
+
 #endif
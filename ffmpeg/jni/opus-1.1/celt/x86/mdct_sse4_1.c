@@ -0,0 +1,317 @@
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_SSE4_1) && defined(FIXED_POINT)
+
+#include <smmintrin.h>
+#include "mdct.h"
+#include "kiss_fft.h"
+#include "_kiss_fft_guts.h"
+#include "stack_alloc.h"
+#include "x86/x86cpu.h"
+
+/* S_MUL(a, b) on four lanes, b holding 16-bit values in 32-bit lanes */
+static OPUS_INLINE OPUS_SSE4_1_TARGET __m128i s_mul_sse4_1(__m128i a, __m128i b)
+{
+   __m128i lo, hi;
+   lo = _mm_srli_epi64(_mm_mul_epi32(a, b), 15);
+   hi = _mm_slli_epi64(_mm_mul_epi32(_mm_srli_epi64(a, 32),
+         _mm_srli_epi64(b, 32)), 17);
+   return _mm_blend_epi16(lo, hi, 0xCC);
+}
+
+/* Loads p[0..3] sign-extended to 32 bits */
+static OPUS_INLINE OPUS_SSE4_1_TARGET __m128i load_16x4_sse4_1(
+      const opus_int16 *p)
+{
+   return _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *)p));
+}
+
+/* Loads p[3], p[2], p[1], p[0] sign-extended to 32 bits */
+static OPUS_INLINE OPUS_SSE4_1_TARGET __m128i load_16x4_rev_sse4_1(
+      const opus_int16 *p)
+{
+   return _mm_shuffle_epi32(load_16x4_sse4_1(p), _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+#define SHUFFLE_EPI32_2(a, b, imm) _mm_castps_si128(_mm_shuffle_ps( \
+      _mm_castsi128_ps(a), _mm_castsi128_ps(b), imm))
+
+/* C_MULC() of two complex values, t holding the twiddles sign-extended to
+   32 bits */
+static OPUS_INLINE OPUS_SSE4_1_TARGET __m128i c_mulc_sse4_1(__m128i a, __m128i t)
+{
+   __m128i p, q;
+   /* ar*tr, ai*ti and ar*ti, ai*tr */
+   p = s_mul_sse4_1(a, t);
+   q = s_mul_sse4_1(a, _mm_shuffle_epi32(t, _MM_SHUFFLE(2, 3, 0, 1)));
+   p = _mm_add_epi32(p, _mm_shuffle_epi32(p, _MM_SHUFFLE(2, 3, 0, 1)));
+   q = _mm_sub_epi32(q, _mm_shuffle_epi32(q, _MM_SHUFFLE(2, 3, 0, 1)));
+   return _mm_blend_epi16(p, q, 0xCC);
+}
+
+/* tw[0] and tw[stride], sign-extended */
+static OPUS_INLINE OPUS_SSE4_1_TARGET __m128i load_twiddles_sse4_1(
+      const kiss_twiddle_cpx *tw, size_t stride)
+{
+   return _mm_setr_epi32(tw[0].r, tw[0].i, tw[stride].r, tw[stride].i);
+}
+
+/* ki_bfly4() from kiss_fft.c, two butterflies at a time */
+static OPUS_SSE4_1_TARGET void ki_bfly4_sse4_1(kiss_fft_cpx *Fout,
+      const size_t fstride, const kiss_fft_state *st, int m, int N, int mm)
+{
+   const kiss_twiddle_cpx *tw1,*tw2,*tw3;
+   const size_t m2=2*m;
+   const size_t m3=3*m;
+   int i, j;
+
+   kiss_fft_cpx * Fout_beg = Fout;
+   for (i=0;i<N;i++)
+   {
+      Fout = Fout_beg + i*mm;
+      tw3 = tw2 = tw1 = st->twiddles;
+      for (j=0;j+2<=m;j+=2)
+      {
+         __m128i f0, s0, s1, s2, s3, s4, s5, s4x;
+         s0 = c_mulc_sse4_1(_mm_loadu_si128((__m128i *)&Fout[m]),
+               load_twiddles_sse4_1(tw1, fstride));
+         s1 = c_mulc_sse4_1(_mm_loadu_si128((__m128i *)&Fout[m2]),
+               load_twiddles_sse4_1(tw2, 2*fstride));
+         s2 = c_mulc_sse4_1(_mm_loadu_si128((__m128i *)&Fout[m3]),
+               load_twiddles_sse4_1(tw3, 3*fstride));
+         f0 = _mm_loadu_si128((__m128i *)Fout);
+
+         s5 = _mm_sub_epi32(f0, s1);
+         f0 = _mm_add_epi32(f0, s1);
+         s3 = _mm_add_epi32(s0, s2);
+         s4 = _mm_sub_epi32(s0, s2);
+         _mm_storeu_si128((__m128i *)&Fout[m2], _mm_sub_epi32(f0, s3));
+         _mm_storeu_si128((__m128i *)Fout, _mm_add_epi32(f0, s3));
+         tw1 += 2*fstride;
+         tw2 += 4*fstride;
+         tw3 += 6*fstride;
+
+         /* Fout[m] = s5 + (-s4.i, s4.r), Fout[m3] = s5 - (-s4.i, s4.r) */
+         s4x = _mm_shuffle_epi32(s4, _MM_SHUFFLE(2, 3, 0, 1));
+         s4x = _mm_blend_epi16(_mm_sub_epi32(_mm_setzero_si128(), s4x), s4x, 0xCC);
+         _mm_storeu_si128((__m128i *)&Fout[m], _mm_add_epi32(s5, s4x));
+         _mm_storeu_si128((__m128i *)&Fout[m3], _mm_sub_epi32(s5, s4x));
+         Fout += 2;
+      }
+      for (;j<m;j++)
+      {
+         kiss_fft_cpx scratch[6];
+         C_MULC(scratch[0],Fout[m] , *tw1 );
+         C_MULC(scratch[1],Fout[m2] , *tw2 );
+         C_MULC(scratch[2],Fout[m3] , *tw3 );
+
+         C_SUB( scratch[5] , *Fout, scratch[1] );
+         C_ADDTO(*Fout, scratch[1]);
+         C_ADD( scratch[3] , scratch[0] , scratch[2] );
+         C_SUB( scratch[4] , scratch[0] , scratch[2] );
+         C_SUB( Fout[m2], *Fout, scratch[3] );
+         tw1 += fstride;
+         tw2 += fstride*2;
+         tw3 += fstride*3;
+         C_ADDTO( *Fout , scratch[3] );
+
+         Fout[m].r = scratch[5].r - scratch[4].i;
+         Fout[m].i = scratch[5].i + scratch[4].r;
+         Fout[m3].r = scratch[5].r + scratch[4].i;
+         Fout[m3].i = scratch[5].i - scratch[4].r;
+         ++Fout;
+      }
+   }
+}
+
+/* The pre- and post-rotation are only vectorized for the long, unstrided
+   transform (shift == 0, stride == 1), which has contiguous inputs and
+   twiddles. That's the common case of a 20 ms frame without transients. The
+   FFT and the TDAC are vectorized for all sizes. */
+OPUS_SSE4_1_TARGET
+void clt_mdct_backward_sse4_1(const mdct_lookup *l, kiss_fft_scalar *in,
+      kiss_fft_scalar * OPUS_RESTRICT out,
+      const opus_val16 * OPUS_RESTRICT window, int overlap, int shift, int stride)
+{
+   int i;
+   int N, N2, N4;
+   int contiguous;
+   kiss_twiddle_scalar sine;
+   const kiss_twiddle_scalar *t;
+   __m128i vecSine;
+   VARDECL(kiss_fft_scalar, f2);
+   SAVE_STACK;
+
+   contiguous = shift == 0 && stride == 1;
+   N = l->n;
+   N >>= shift;
+   N2 = N>>1;
+   N4 = N>>2;
+   ALLOC(f2, N2, kiss_fft_scalar);
+   /* sin(x) ~= x here */
+   sine = TRIG_UPSCALE*(QCONST16(0.7853981f, 15)+N2)/N;
+   vecSine = _mm_set1_epi32(sine);
+   t = &l->trig[0];
+
+   /* Pre-rotate */
+   {
+      const kiss_fft_scalar * OPUS_RESTRICT xp2 = in+stride*(N2-1);
+      kiss_fft_scalar * OPUS_RESTRICT yp = f2;
+      for(i=0;contiguous&&i<N4-3;i+=4)
+      {
+         __m128i a, b, x1, x2, t0, t1, yr, yi, y0, y1;
+         a = _mm_loadu_si128((const __m128i *)&in[2*i]);
+         b = _mm_loadu_si128((const __m128i *)&in[2*i+4]);
+         x1 = SHUFFLE_EPI32_2(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+         a = _mm_loadu_si128((const __m128i *)&xp2[-2*i-7]);
+         b = _mm_loadu_si128((const __m128i *)&xp2[-2*i-3]);
+         x2 = SHUFFLE_EPI32_2(b, a, _MM_SHUFFLE(1, 3, 1, 3));
+         t0 = load_16x4_sse4_1(&t[i]);
+         t1 = load_16x4_rev_sse4_1(&t[N4-i-3]);
+         yr = _mm_sub_epi32(s_mul_sse4_1(x1, t1), s_mul_sse4_1(x2, t0));
+         yi = _mm_sub_epi32(_mm_setzero_si128(),
+               _mm_add_epi32(s_mul_sse4_1(x2, t1), s_mul_sse4_1(x1, t0)));
+         /* works because the cos is nearly one */
+         y0 = _mm_sub_epi32(yr, s_mul_sse4_1(yi, vecSine));
+         y1 = _mm_add_epi32(yi, s_mul_sse4_1(yr, vecSine));
+         _mm_storeu_si128((__m128i *)&yp[2*i], _mm_unpacklo_epi32(y0, y1));
+         _mm_storeu_si128((__m128i *)&yp[2*i+4], _mm_unpackhi_epi32(y0, y1));
+      }
+      for(;i<N4;i++)
+      {
+         kiss_fft_scalar yr, yi;
+         yr = -S_MUL(xp2[-2*i*stride], t[i<<shift]) + S_MUL(in[2*i*stride],t[(N4-i)<<shift]);
+         yi =  -S_MUL(xp2[-2*i*stride], t[(N4-i)<<shift]) - S_MUL(in[2*i*stride],t[i<<shift]);
+         yp[2*i] = yr - S_MUL(yi,sine);
+         yp[2*i+1] = yi + S_MUL(yr,sine);
+      }
+   }
+
+   /* Inverse N/4 complex FFT. This one should *not* downscale even in fixed-point */
+   opus_ifft_bfly4(l->kfft[shift], (kiss_fft_cpx *)f2,
+         (kiss_fft_cpx *)(out+(overlap>>1)), ki_bfly4_sse4_1);
+
+   /* Post-rotate and de-shuffle from both ends of the buffer at once to make
+      it in-place. Pair i and pair N4-1-i are processed together, four of
+      each per iteration. */
+   {
+      kiss_fft_scalar * OPUS_RESTRICT yp = out+(overlap>>1);
+      for(i=0;contiguous&&i+4<=N4>>1;i+=4)
+      {
+         __m128i p, q, r, s, re0, im0, re1, im1, t0, t1, t2, t3;
+         __m128i yr0, yi0, yr1, yi1, a, b, c, d;
+         kiss_fft_scalar *yp1 = yp+2*(N4-4-i);
+         p = _mm_loadu_si128((const __m128i *)&yp[2*i]);
+         q = _mm_loadu_si128((const __m128i *)&yp[2*i+4]);
+         r = _mm_loadu_si128((const __m128i *)&yp1[0]);
+         s = _mm_loadu_si128((const __m128i *)&yp1[4]);
+         re0 = SHUFFLE_EPI32_2(p, q, _MM_SHUFFLE(2, 0, 2, 0));
+         im0 = SHUFFLE_EPI32_2(p, q, _MM_SHUFFLE(3, 1, 3, 1));
+         re1 = SHUFFLE_EPI32_2(s, r, _MM_SHUFFLE(0, 2, 0, 2));
+         im1 = SHUFFLE_EPI32_2(s, r, _MM_SHUFFLE(1, 3, 1, 3));
+         t0 = load_16x4_sse4_1(&t[i]);
+         t1 = load_16x4_rev_sse4_1(&t[N4-i-3]);
+         t2 = load_16x4_rev_sse4_1(&t[N4-i-4]);
+         t3 = load_16x4_sse4_1(&t[i+1]);
+         /* We'd scale up by 2 here, but instead it's done when mixing the windows */
+         yr0 = _mm_sub_epi32(s_mul_sse4_1(re0, t0), s_mul_sse4_1(im0, t1));
+         yi0 = _mm_add_epi32(s_mul_sse4_1(im0, t0), s_mul_sse4_1(re0, t1));
+         yr1 = _mm_sub_epi32(s_mul_sse4_1(re1, t2), s_mul_sse4_1(im1, t3));
+         yi1 = _mm_add_epi32(s_mul_sse4_1(im1, t2), s_mul_sse4_1(re1, t3));
+         /* works because the cos is nearly one */
+         a = _mm_sub_epi32(s_mul_sse4_1(yi0, vecSine), yr0);
+         b = _mm_add_epi32(yi1, s_mul_sse4_1(yr1, vecSine));
+         c = _mm_sub_epi32(s_mul_sse4_1(yi1, vecSine), yr1);
+         d = _mm_add_epi32(yi0, s_mul_sse4_1(yr0, vecSine));
+         _mm_storeu_si128((__m128i *)&yp[2*i], _mm_unpacklo_epi32(a, b));
+         _mm_storeu_si128((__m128i *)&yp[2*i+4], _mm_unpackhi_epi32(a, b));
+         _mm_storeu_si128((__m128i *)&yp1[4], _mm_shuffle_epi32(
+               _mm_unpacklo_epi32(c, d), _MM_SHUFFLE(1, 0, 3, 2)));
+         _mm_storeu_si128((__m128i *)&yp1[0], _mm_shuffle_epi32(
+               _mm_unpackhi_epi32(c, d), _MM_SHUFFLE(1, 0, 3, 2)));
+      }
+      /* Loop to (N4+1)>>1 to handle odd N4. When N4 is odd, the
+         middle pair will be computed twice. */
+      for(;i<(N4+1)>>1;i++)
+      {
+         kiss_fft_scalar * OPUS_RESTRICT yp0 = yp+2*i;
+         kiss_fft_scalar * OPUS_RESTRICT yp1 = yp+2*(N4-1-i);
+         kiss_fft_scalar re, im, yr, yi;
+         kiss_twiddle_scalar t0, t1;
+         re = yp0[0];
+         im = yp0[1];
+         t0 = t[i<<shift];
+         t1 = t[(N4-i)<<shift];
+         yr = S_MUL(re,t0) - S_MUL(im,t1);
+         yi = S_MUL(im,t0) + S_MUL(re,t1);
+         re = yp1[0];
+         im = yp1[1];
+         yp0[0] = -(yr - S_MUL(yi,sine));
+         yp1[1] = yi + S_MUL(yr,sine);
+
+         t0 = t[(N4-i-1)<<shift];
+         t1 = t[(i+1)<<shift];
+         yr = S_MUL(re,t0) - S_MUL(im,t1);
+         yi = S_MUL(im,t0) + S_MUL(re,t1);
+         yp1[0] = -(yr - S_MUL(yi,sine));
+         yp0[1] = yi + S_MUL(yr,sine);
+      }
+   }
+
+   /* Mirror on both sides for TDAC */
+   {
+      kiss_fft_scalar * OPUS_RESTRICT xp1 = out+overlap-1;
+      for(i=0;i+4<=overlap>>1;i+=4)
+      {
+         __m128i x1, x2, w1, w2;
+         x2 = _mm_loadu_si128((const __m128i *)&out[i]);
+         x1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&xp1[-i-3]),
+               _MM_SHUFFLE(0, 1, 2, 3));
+         w1 = load_16x4_sse4_1(&window[i]);
+         w2 = load_16x4_rev_sse4_1(&window[overlap-i-4]);
+         _mm_storeu_si128((__m128i *)&out[i], _mm_sub_epi32(
+               s_mul_sse4_1(x2, w2), s_mul_sse4_1(x1, w1)));
+         _mm_storeu_si128((__m128i *)&xp1[-i-3], _mm_shuffle_epi32(
+               _mm_add_epi32(s_mul_sse4_1(x2, w1), s_mul_sse4_1(x1, w2)),
+               _MM_SHUFFLE(0, 1, 2, 3)));
+      }
+      for(;i<overlap/2;i++)
+      {
+         kiss_fft_scalar x1, x2;
+         x1 = xp1[-i];
+         x2 = out[i];
+         out[i] = MULT16_32_Q15(window[overlap-1-i], x2) - MULT16_32_Q15(window[i], x1);
+         xp1[-i] = MULT16_32_Q15(window[i], x2) + MULT16_32_Q15(window[overlap-1-i], x1);
+      }
+   }
+   RESTORE_STACK;
+}
+
+#endif
@@ -32,11 +32,68 @@
 #ifndef PITCH_SSE_H
 #define PITCH_SSE_H
 
-#include <xmmintrin.h>
 #include "arch.h"
 
+#if defined(FIXED_POINT)
+
+#include "x86cpu.h"
+
+void xcorr_kernel_sse4_1(const opus_val16 *x, const opus_val16 *y,
+      opus_val32 sum[4], int len);
+
+opus_val32 celt_inner_prod_sse4_1(const opus_val16 *x, const opus_val16 *y,
+      int N);
+
+void dual_inner_prod_sse4_1(const opus_val16 *x, const opus_val16 *y01,
+      const opus_val16 *y02, int N, opus_val32 *xy1, opus_val32 *xy2);
+
+void comb_filter_const_sse4_1(opus_val32 *y, opus_val32 *x, int T, int N,
+      opus_val16 g10, opus_val16 g11, opus_val16 g12);
+
+# if defined(OPUS_HAVE_RTCD)
+
+/* The generic pitch correlation calls the run-time selected xcorr_kernel */
+#  define OVERRIDE_PITCH_XCORR (1)
+#  define celt_pitch_xcorr celt_pitch_xcorr_c
+
+extern void (*const XCORR_KERNEL_IMPL[OPUS_ARCHMASK+1])(const opus_val16 *,
+      const opus_val16 *, opus_val32 *, int);
+
+extern opus_val32 (*const CELT_INNER_PROD_IMPL[OPUS_ARCHMASK+1])(
+      const opus_val16 *, const opus_val16 *, int);
+
+extern void (*const DUAL_INNER_PROD_IMPL[OPUS_ARCHMASK+1])(const opus_val16 *,
+      const opus_val16 *, const opus_val16 *, int, opus_val32 *, opus_val32 *);
+
+extern void (*const COMB_FILTER_CONST_IMPL[OPUS_ARCHMASK+1])(opus_val32 *,
+      opus_val32 *, int, int, opus_val16, opus_val16, opus_val16);
+
+#  define OVERRIDE_XCORR_KERNEL
+#  define xcorr_kernel(x, y, sum, len, arch) \
+    ((*XCORR_KERNEL_IMPL[(arch)&OPUS_ARCHMASK])(x, y, sum, len))
+
+#  define OVERRIDE_CELT_INNER_PROD
+#  define celt_inner_prod(x, y, N, arch) \
+    ((*CELT_INNER_PROD_IMPL[(arch)&OPUS_ARCHMASK])(x, y, N))
+
+#  define OVERRIDE_DUAL_INNER_PROD
+#  define dual_inner_prod(x, y01, y02, N, xy1, xy2, arch) \
+    ((*DUAL_INNER_PROD_IMPL[(arch)&OPUS_ARCHMASK])(x, y01, y02, N, xy1, xy2))
+
+#  define OVERRIDE_COMB_FILTER_CONST
+#  define comb_filter_const(y, x, T, N, g10, g11, g12, arch) \
+    ((*COMB_FILTER_CONST_IMPL[(arch)&OPUS_ARCHMASK])(y, x, T, N, g10, g11, g12))
+
+# endif
+
+#else
+
+#include <xmmintrin.h>
 #define OVERRIDE_XCORR_KERNEL
-static OPUS_INLINE void xcorr_kernel(const opus_val16 *x, const opus_val16 *y, opus_val32 sum[4], int len)
+#define xcorr_kernel(x, y, sum, len, arch) \
+    ((void)(arch),xcorr_kernel_sse(x, y, sum, len))
+
+static OPUS_INLINE void xcorr_kernel_sse(const opus_val16 *x, const opus_val16 *y, opus_val32 sum[4], int len)
 {
    int j;
    __m128 xsum1, xsum2;
@@ -72,7 +129,10 @@ static OPUS_INLINE void xcorr_kernel(const opus_val16 *x, const opus_val16 *y, o
 }
 
 #define OVERRIDE_DUAL_INNER_PROD
-static OPUS_INLINE void dual_inner_prod(const opus_val16 *x, const opus_val16 *y01, const opus_val16 *y02,
+#define dual_inner_prod(x, y01, y02, N, xy1, xy2, arch) \
+    ((void)(arch),dual_inner_prod_sse(x, y01, y02, N, xy1, xy2))
+
+static OPUS_INLINE void dual_inner_prod_sse(const opus_val16 *x, const opus_val16 *y01, const opus_val16 *y02,
       int N, opus_val32 *xy1, opus_val32 *xy2)
 {
    int i;
@@ -102,7 +162,10 @@ static OPUS_INLINE void dual_inner_prod(const opus_val16 *x, const opus_val16 *y
 }
 
 #define OVERRIDE_COMB_FILTER_CONST
-static OPUS_INLINE void comb_filter_const(opus_val32 *y, opus_val32 *x, int T, int N,
+#define comb_filter_const(y, x, T, N, g10, g11, g12, arch) \
+    ((void)(arch),comb_filter_const_sse(y, x, T, N, g10, g11, g12))
+
+static OPUS_INLINE void comb_filter_const_sse(opus_val32 *y, opus_val32 *x, int T, int N,
       opus_val16 g10, opus_val16 g11, opus_val16 g12)
 {
    int i;
@@ -154,3 +217,5 @@ static OPUS_INLINE void comb_filter_const(opus_val32 *y, opus_val32 *x, int T, i
 }
 
 #endif
+
+#endif
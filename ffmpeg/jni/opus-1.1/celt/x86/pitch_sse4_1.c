@@ -0,0 +1,214 @@
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_SSE4_1) && defined(FIXED_POINT)
+
+#include <smmintrin.h>
+#include "pitch.h"
+#include "x86/x86cpu.h"
+
+/* Returns MULT16_32_Q15(b, a) for each lane, b holding 16-bit values in
+   32-bit lanes. The 64-bit products are exact, so this matches the C macro
+   including its wrap-around. */
+static OPUS_INLINE OPUS_SSE4_1_TARGET __m128i mult16_32_q15_sse4_1(__m128i a,
+      __m128i b)
+{
+   __m128i lo, hi;
+   lo = _mm_srli_epi64(_mm_mul_epi32(a, b), 15);
+   hi = _mm_slli_epi64(_mm_mul_epi32(_mm_srli_epi64(a, 32),
+         _mm_srli_epi64(b, 32)), 17);
+   return _mm_blend_epi16(lo, hi, 0xCC);
+}
+
+static OPUS_INLINE OPUS_SSE4_1_TARGET opus_val32 hsum_epi32_sse4_1(__m128i v)
+{
+   v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+   v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+   return _mm_cvtsi128_si32(v);
+}
+
+OPUS_SSE4_1_TARGET
+void xcorr_kernel_sse4_1(const opus_val16 *x, const opus_val16 *y,
+      opus_val32 sum[4], int len)
+{
+   int j;
+   __m128i sum0, sum1, sum2, sum3, vecSum;
+
+   celt_assert(len>=3);
+   sum0 = sum1 = sum2 = sum3 = _mm_setzero_si128();
+   for (j=0;j<len-7;j+=8)
+   {
+      __m128i vecX = _mm_loadu_si128((const __m128i *)&x[j]);
+      sum0 = _mm_add_epi32(sum0, _mm_madd_epi16(vecX,
+            _mm_loadu_si128((const __m128i *)&y[j])));
+      sum1 = _mm_add_epi32(sum1, _mm_madd_epi16(vecX,
+            _mm_loadu_si128((const __m128i *)&y[j+1])));
+      sum2 = _mm_add_epi32(sum2, _mm_madd_epi16(vecX,
+            _mm_loadu_si128((const __m128i *)&y[j+2])));
+      sum3 = _mm_add_epi32(sum3, _mm_madd_epi16(vecX,
+            _mm_loadu_si128((const __m128i *)&y[j+3])));
+   }
+
+   /* Transpose and add, lane k ends up with the sum for y+k */
+   sum0 = _mm_hadd_epi32(_mm_hadd_epi32(sum0, sum1),
+         _mm_hadd_epi32(sum2, sum3));
+   vecSum = _mm_add_epi32(_mm_loadu_si128((const __m128i *)sum), sum0);
+
+   for (;j<len;j++)
+   {
+      __m128i vecX = _mm_set1_epi32(x[j]);
+      __m128i vecY = _mm_cvtepi16_epi32(
+            _mm_loadl_epi64((const __m128i *)&y[j]));
+      vecSum = _mm_add_epi32(vecSum, _mm_mullo_epi32(vecX, vecY));
+   }
+
+   _mm_storeu_si128((__m128i *)sum, vecSum);
+}
+
+OPUS_SSE4_1_TARGET
+opus_val32 celt_inner_prod_sse4_1(const opus_val16 *x, const opus_val16 *y,
+      int N)
+{
+   int i;
+   opus_val32 xy;
+   __m128i sum0, sum1;
+
+   sum0 = sum1 = _mm_setzero_si128();
+   for (i=0;i<N-15;i+=16)
+   {
+      sum0 = _mm_add_epi32(sum0, _mm_madd_epi16(
+            _mm_loadu_si128((const __m128i *)&x[i]),
+            _mm_loadu_si128((const __m128i *)&y[i])));
+      sum1 = _mm_add_epi32(sum1, _mm_madd_epi16(
+            _mm_loadu_si128((const __m128i *)&x[i+8]),
+            _mm_loadu_si128((const __m128i *)&y[i+8])));
+   }
+   if (i<N-7)
+   {
+      sum0 = _mm_add_epi32(sum0, _mm_madd_epi16(
+            _mm_loadu_si128((const __m128i *)&x[i]),
+            _mm_loadu_si128((const __m128i *)&y[i])));
+      i += 8;
+   }
+   if (i<N-3)
+   {
+      sum1 = _mm_add_epi32(sum1, _mm_madd_epi16(
+            _mm_loadl_epi64((const __m128i *)&x[i]),
+            _mm_loadl_epi64((const __m128i *)&y[i])));
+      i += 4;
+   }
+   xy = hsum_epi32_sse4_1(_mm_add_epi32(sum0, sum1));
+
+   for (;i<N;i++)
+      xy = MAC16_16(xy, x[i], y[i]);
+   return xy;
+}
+
+OPUS_SSE4_1_TARGET
+void dual_inner_prod_sse4_1(const opus_val16 *x, const opus_val16 *y01,
+      const opus_val16 *y02, int N, opus_val32 *xy1, opus_val32 *xy2)
+{
+   int i;
+   opus_val32 xy01, xy02;
+   __m128i sum1, sum2;
+
+   sum1 = sum2 = _mm_setzero_si128();
+   for (i=0;i<N-7;i+=8)
+   {
+      __m128i vecX = _mm_loadu_si128((const __m128i *)&x[i]);
+      sum1 = _mm_add_epi32(sum1, _mm_madd_epi16(vecX,
+            _mm_loadu_si128((const __m128i *)&y01[i])));
+      sum2 = _mm_add_epi32(sum2, _mm_madd_epi16(vecX,
+            _mm_loadu_si128((const __m128i *)&y02[i])));
+   }
+   xy01 = hsum_epi32_sse4_1(sum1);
+   xy02 = hsum_epi32_sse4_1(sum2);
+
+   for (;i<N;i++)
+   {
+      xy01 = MAC16_16(xy01, x[i], y01[i]);
+      xy02 = MAC16_16(xy02, x[i], y02[i]);
+   }
+   *xy1 = xy01;
+   *xy2 = xy02;
+}
+
+/* The filter may run in place (y == x). The vectors read x[i-T-2..i-T+5],
+   which with T >= COMBFILTER_MINPERIOD are always outputs of earlier
+   iterations, exactly like in the scalar loop. */
+OPUS_SSE4_1_TARGET
+void comb_filter_const_sse4_1(opus_val32 *y, opus_val32 *x, int T, int N,
+      opus_val16 g10, opus_val16 g11, opus_val16 g12)
+{
+   int i;
+   opus_val32 x0, x1, x2, x3, x4;
+   __m128i vecG10, vecG11, vecG12;
+
+   vecG10 = _mm_set1_epi32(g10);
+   vecG11 = _mm_set1_epi32(g11);
+   vecG12 = _mm_set1_epi32(g12);
+   for (i=0;i<N-3;i+=4)
+   {
+      const opus_val32 *xp = &x[i-T-2];
+      __m128i vecX0, vecX1, vecX2, vecX3, vecX4, vecY;
+      vecX4 = _mm_loadu_si128((const __m128i *)&xp[0]);
+      vecX3 = _mm_loadu_si128((const __m128i *)&xp[1]);
+      vecX2 = _mm_loadu_si128((const __m128i *)&xp[2]);
+      vecX1 = _mm_loadu_si128((const __m128i *)&xp[3]);
+      vecX0 = _mm_loadu_si128((const __m128i *)&xp[4]);
+      vecY = _mm_loadu_si128((const __m128i *)&x[i]);
+      vecY = _mm_add_epi32(vecY, mult16_32_q15_sse4_1(vecX2, vecG10));
+      vecY = _mm_add_epi32(vecY, mult16_32_q15_sse4_1(
+            _mm_add_epi32(vecX1, vecX3), vecG11));
+      vecY = _mm_add_epi32(vecY, mult16_32_q15_sse4_1(
+            _mm_add_epi32(vecX0, vecX4), vecG12));
+      _mm_storeu_si128((__m128i *)&y[i], vecY);
+   }
+   if (i<N)
+   {
+      x4 = x[i-T-2];
+      x3 = x[i-T-1];
+      x2 = x[i-T];
+      x1 = x[i-T+1];
+      for (;i<N;i++)
+      {
+         x0=x[i-T+2];
+         y[i] = x[i]
+                  + MULT16_32_Q15(g10,x2)
+                  + MULT16_32_Q15(g11,ADD32(x1,x3))
+                  + MULT16_32_Q15(g12,ADD32(x0,x4));
+         x4=x3;
+         x3=x2;
+         x2=x1;
+         x1=x0;
+      }
+   }
+}
+
+#endif
@@ -0,0 +1,98 @@
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "x86/x86cpu.h"
+#include "celt_lpc.h"
+#include "pitch.h"
+#include "mdct.h"
+
+#if defined(OPUS_HAVE_RTCD)
+
+# if defined(FIXED_POINT)
+
+void (*const XCORR_KERNEL_IMPL[OPUS_ARCHMASK + 1])(
+      const opus_val16 *x,
+      const opus_val16 *y,
+      opus_val32       sum[4],
+      int              len
+) = {
+  xcorr_kernel_c,                  /* non-sse */
+  MAY_HAVE_SSE4_1(xcorr_kernel)    /* sse4.1 */
+};
+
+opus_val32 (*const CELT_INNER_PROD_IMPL[OPUS_ARCHMASK + 1])(
+      const opus_val16 *x,
+      const opus_val16 *y,
+      int              N
+) = {
+  celt_inner_prod_c,               /* non-sse */
+  MAY_HAVE_SSE4_1(celt_inner_prod) /* sse4.1 */
+};
+
+void (*const DUAL_INNER_PROD_IMPL[OPUS_ARCHMASK + 1])(
+      const opus_val16 *x,
+      const opus_val16 *y01,
+      const opus_val16 *y02,
+      int              N,
+      opus_val32       *xy1,
+      opus_val32       *xy2
+) = {
+  dual_inner_prod_c,               /* non-sse */
+  MAY_HAVE_SSE4_1(dual_inner_prod) /* sse4.1 */
+};
+
+void (*const COMB_FILTER_CONST_IMPL[OPUS_ARCHMASK + 1])(
+      opus_val32 *y,
+      opus_val32 *x,
+      int         T,
+      int         N,
+      opus_val16  g10,
+      opus_val16  g11,
+      opus_val16  g12
+) = {
+  comb_filter_const_c,               /* non-sse */
+  MAY_HAVE_SSE4_1(comb_filter_const) /* sse4.1 */
+};
+
+void (*const CLT_MDCT_BACKWARD_IMPL[OPUS_ARCHMASK + 1])(
+      const mdct_lookup               *l,
+      kiss_fft_scalar                 *in,
+      kiss_fft_scalar * OPUS_RESTRICT out,
+      const opus_val16 * OPUS_RESTRICT window,
+      int                              overlap,
+      int                              shift,
+      int                              stride
+) = {
+  clt_mdct_backward_c,               /* non-sse */
+  MAY_HAVE_SSE4_1(clt_mdct_backward) /* sse4.1 */
+};
+
+# endif
+
+#endif
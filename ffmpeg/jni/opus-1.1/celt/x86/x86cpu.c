@@ -0,0 +1,75 @@
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#if defined(OPUS_HAVE_RTCD) && defined(OPUS_X86_MAY_HAVE_SSE4_1)
+
+#include "cpu_support.h"
+#include "opus_types.h"
+
+#if defined(_MSC_VER)
+# include <intrin.h>
+
+static void cpuid(unsigned int info[4], unsigned int leaf)
+{
+   __cpuid((int *)info, leaf);
+}
+
+#elif defined(__GNUC__)
+# include <cpuid.h>
+
+static void cpuid(unsigned int info[4], unsigned int leaf)
+{
+   if (!__get_cpuid(leaf, &info[0], &info[1], &info[2], &info[3]))
+      info[0] = info[1] = info[2] = info[3] = 0;
+}
+
+#else
+# error "Configured to use x86 run-time CPU detection but no cpuid method " \
+   "is available for your compiler. Reconfigure with --disable-rtcd."
+#endif
+
+int opus_select_arch(void)
+{
+   unsigned int info[4] = {0, 0, 0, 0};
+   int arch = 0;
+
+   cpuid(info, 0);
+   if (info[0] < 1)
+      return arch;
+   cpuid(info, 1);
+
+   /* SSE4.1 is bit 19 of ECX */
+   if (!(info[2] & (1 << 19)))
+      return arch;
+   arch++;
+
+   return arch;
+}
+
+#endif
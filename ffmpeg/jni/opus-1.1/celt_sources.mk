@@ -17,10 +17,20 @@ celt/quant_bands.c \
 celt/rate.c \
 celt/vq.c
 
+CELT_SOURCES_SSE4_1 = \
+celt/x86/x86cpu.c \
+celt/x86/x86_celt_map.c \
+celt/x86/pitch_sse4_1.c \
+celt/x86/mdct_sse4_1.c
+
 CELT_SOURCES_ARM = \
 celt/arm/armcpu.c \
 celt/arm/arm_celt_map.c
 
+CELT_SOURCES_ARM_NEON_INTR = \
+celt/arm/pitch_neon_intr.c \
+celt/arm/mdct_neon_intr.c
+
 CELT_SOURCES_ARM_ASM = \
 celt/arm/celt_pitch_xcorr_arm.s
 
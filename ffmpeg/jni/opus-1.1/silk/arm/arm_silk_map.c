@@ -0,0 +1,50 @@
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "main.h"
+
+#if defined(OPUS_HAVE_RTCD) && defined(FIXED_POINT) && \
+  defined(OPUS_ARM_MAY_HAVE_NEON_INTR)
+
+void (*const SILK_DECODE_SHORT_TERM_PREDICTION_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    opus_int32                  sLPC_Q14[],
+    const opus_int32            pres_Q14[],
+    const opus_int16            A_Q12[],
+    opus_int16                  xq[],
+    opus_int32                  Gain_Q10,
+    opus_int                    LPC_order,
+    opus_int                    length
+) = {
+    silk_decode_short_term_prediction_c,        /* ARMv4 */
+    silk_decode_short_term_prediction_c,        /* EDSP */
+    silk_decode_short_term_prediction_c,        /* Media */
+    silk_decode_short_term_prediction_neon      /* NEON */
+};
+
+#endif
@@ -0,0 +1,121 @@
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <arm_neon.h>
+#include "main.h"
+
+#if defined(FIXED_POINT)
+
+/* silk_SMLAWB() per lane: vqdmulh by c << 15 gives floor( b * c / 65536 ) and
+   cannot saturate for 16-bit c */
+static OPUS_INLINE int32x4_t silk_SMULWB_neon( int32x4_t b, int32x4_t c_Q15 )
+{
+    return vqdmulhq_s32( b, c_Q15 );
+}
+
+/* The last 16 (or 12 for order 10) samples of the LPC state are kept in
+   registers, oldest first, and shifted by one sample per output. The
+   coefficients are stored reversed to match, and zero padded for order 10. */
+void silk_decode_short_term_prediction_neon(
+    opus_int32                  sLPC_Q14[],                     /* I/O  LPC state                                   */
+    const opus_int32            pres_Q14[],                     /* I    LPC excitation                              */
+    const opus_int16            A_Q12[],                        /* I    LPC coefficients                            */
+    opus_int16                  xq[],                           /* O    Decoded speech                              */
+    opus_int32                  Gain_Q10,                       /* I    Subframe gain                               */
+    opus_int                    LPC_order,                      /* I    LPC order, 10 or 16                         */
+    opus_int                    length                          /* I    Subframe length                             */
+)
+{
+    opus_int   i, k, order_pad;
+    opus_int32 A_rev[ MAX_LPC_ORDER ];
+    opus_int32 *pLPC;
+    int32x4_t  s0, s1, s2, s3, a0, a1, a2, a3, acc;
+    int32x2_t  sum, gain;
+
+    silk_assert( LPC_order == 10 || LPC_order == 16 );
+    order_pad = ( LPC_order + 3 ) & ~3;
+    for( k = 0; k < order_pad; k++ ) {
+        opus_int m = order_pad - 1 - k;
+        A_rev[ k ] = m < LPC_order ? silk_LSHIFT( (opus_int32)A_Q12[ m ], 15 ) : 0;
+    }
+    a0 = vld1q_s32( &A_rev[ 0 ] );
+    a1 = vld1q_s32( &A_rev[ 4 ] );
+    a2 = vld1q_s32( &A_rev[ 8 ] );
+
+    pLPC = &sLPC_Q14[ MAX_LPC_ORDER - order_pad ];
+    s0 = vld1q_s32( &pLPC[ 0 ] );
+    s1 = vld1q_s32( &pLPC[ 4 ] );
+    s2 = vld1q_s32( &pLPC[ 8 ] );
+
+    if( LPC_order == 16 ) {
+        a3 = vld1q_s32( &A_rev[ 12 ] );
+        s3 = vld1q_s32( &pLPC[ 12 ] );
+        for( i = 0; i < length; i++ ) {
+            acc = vaddq_s32( silk_SMULWB_neon( s0, a0 ), silk_SMULWB_neon( s1, a1 ) );
+            acc = vaddq_s32( acc, silk_SMULWB_neon( s2, a2 ) );
+            acc = vaddq_s32( acc, silk_SMULWB_neon( s3, a3 ) );
+            sum = vadd_s32( vget_low_s32( acc ), vget_high_s32( acc ) );
+            sum = vpadd_s32( sum, sum );
+            /* Add prediction to LPC excitation, the bias avoids rounding to -inf */
+            sLPC_Q14[ MAX_LPC_ORDER + i ] = silk_ADD_LSHIFT32( pres_Q14[ i ],
+                silk_RSHIFT( LPC_order, 1 ) + vget_lane_s32( sum, 0 ), 4 );
+            s0 = vextq_s32( s0, s1, 1 );
+            s1 = vextq_s32( s1, s2, 1 );
+            s2 = vextq_s32( s2, s3, 1 );
+            s3 = vextq_s32( s3, vdupq_n_s32( sLPC_Q14[ MAX_LPC_ORDER + i ] ), 1 );
+        }
+    } else {
+        for( i = 0; i < length; i++ ) {
+            acc = vaddq_s32( silk_SMULWB_neon( s0, a0 ), silk_SMULWB_neon( s1, a1 ) );
+            acc = vaddq_s32( acc, silk_SMULWB_neon( s2, a2 ) );
+            sum = vadd_s32( vget_low_s32( acc ), vget_high_s32( acc ) );
+            sum = vpadd_s32( sum, sum );
+            sLPC_Q14[ MAX_LPC_ORDER + i ] = silk_ADD_LSHIFT32( pres_Q14[ i ],
+                silk_RSHIFT( LPC_order, 1 ) + vget_lane_s32( sum, 0 ), 4 );
+            s0 = vextq_s32( s0, s1, 1 );
+            s1 = vextq_s32( s1, s2, 1 );
+            s2 = vextq_s32( s2, vdupq_n_s32( sLPC_Q14[ MAX_LPC_ORDER + i ] ), 1 );
+        }
+    }
+
+    /* Scale with gain. The gain may exceed 16 bits, so use full 64-bit
+       products; vrshr and vqmovn match silk_RSHIFT_ROUND() and silk_SAT16(). */
+    gain = vdup_n_s32( Gain_Q10 );
+    for( i = 0; i + 4 <= length; i += 4 ) {
+        int32x4_t x = vld1q_s32( &sLPC_Q14[ MAX_LPC_ORDER + i ] );
+        int32x4_t y = vcombine_s32( vshrn_n_s64( vmull_s32( vget_low_s32( x ), gain ), 16 ),
+                                    vshrn_n_s64( vmull_s32( vget_high_s32( x ), gain ), 16 ) );
+        vst1_s16( &xq[ i ], vqmovn_s32( vrshrq_n_s32( y, 8 ) ) );
+    }
+    for( ; i < length; i++ ) {
+        xq[ i ] = (opus_int16)silk_SAT16( silk_RSHIFT_ROUND( silk_SMULWW( sLPC_Q14[ MAX_LPC_ORDER + i ], Gain_Q10 ), 8 ) );
+    }
+}
+
+#endif
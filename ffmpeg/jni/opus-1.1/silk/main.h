@@ -38,6 +38,15 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "entenc.h"
 #include "entdec.h"
 
+#if defined(OPUS_X86_MAY_HAVE_SSE4_1) && defined(FIXED_POINT)
+#include "x86/main_sse.h"
+#endif
+
+#if (defined(OPUS_ARM_MAY_HAVE_NEON_INTR) || defined(OPUS_ARM_PRESUME_NEON_INTR)) \
+  && defined(FIXED_POINT)
+#include "arm/main_arm.h"
+#endif
+
 /* Convert Left/Right stereo signal to adaptive Mid/Side representation */
 void silk_stereo_LR_to_MS(
     stereo_enc_state            *state,                         /* I/O  State                                       */
@@ -373,7 +382,8 @@ opus_int silk_decode_frame(
     opus_int16                  pOut[],                         /* O    Pointer to output speech frame              */
     opus_int32                  *pN,                            /* O    Pointer to size of output frame             */
     opus_int                    lostFlag,                       /* I    0: no loss, 1 loss, 2 decode fec            */
-    opus_int                    condCoding                      /* I    The type of conditional coding to use       */
+    opus_int                    condCoding,                     /* I    The type of conditional coding to use       */
+    int                         arch                            /* I    Run-time architecture                       */
 );
 
 /* Decode indices from bitstream */
@@ -397,9 +407,26 @@ void silk_decode_core(
     silk_decoder_state          *psDec,                         /* I/O  Decoder state                               */
     silk_decoder_control        *psDecCtrl,                     /* I    Decoder control                             */
     opus_int16                  xq[],                           /* O    Decoded speech                              */
-    const opus_int              pulses[ MAX_FRAME_LENGTH ]      /* I    Pulse signal                                */
+    const opus_int              pulses[ MAX_FRAME_LENGTH ],     /* I    Pulse signal                                */
+    int                         arch                            /* I    Run-time architecture                       */
 );
 
+/* Short-term (LPC) synthesis of one subframe */
+void silk_decode_short_term_prediction_c(
+    opus_int32                  sLPC_Q14[],                     /* I/O  LPC state                                   */
+    const opus_int32            pres_Q14[],                     /* I    LPC excitation                              */
+    const opus_int16            A_Q12[],                        /* I    LPC coefficients                            */
+    opus_int16                  xq[],                           /* O    Decoded speech                              */
+    opus_int32                  Gain_Q10,                       /* I    Subframe gain                               */
+    opus_int                    LPC_order,                      /* I    LPC order, 10 or 16                         */
+    opus_int                    length                          /* I    Subframe length                             */
+);
+
+#if !defined(OVERRIDE_silk_decode_short_term_prediction)
+#define silk_decode_short_term_prediction(sLPC_Q14, pres_Q14, A_Q12, xq, Gain_Q10, LPC_order, length, arch) \
+    ((void)(arch),silk_decode_short_term_prediction_c(sLPC_Q14, pres_Q14, A_Q12, xq, Gain_Q10, LPC_order, length))
+#endif
+
 /* Decode quantization indices of excitation (Shell coding) */
 void silk_decode_pulses(
     ec_dec                      *psRangeDec,                    /* I/O  Compressor data structure                   */
@@ -0,0 +1,139 @@
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_SSE4_1) && defined(FIXED_POINT)
+
+#include <smmintrin.h>
+#include "main.h"
+#include "x86/x86cpu.h"
+
+/* Returns floor( a * b / 65536 ) for each lane, i.e. the silk_SMULWW() result.
+   b_odd holds the odd lanes of b moved to the even ones. */
+static OPUS_INLINE OPUS_SSE4_1_TARGET __m128i silk_mul_Q16_sse4_1(
+    __m128i                     a,
+    __m128i                     b,
+    __m128i                     b_odd
+)
+{
+    __m128i lo, hi;
+    lo = _mm_srli_epi64( _mm_mul_epi32( a, b ), 16 );
+    hi = _mm_slli_epi64( _mm_mul_epi32( _mm_srli_epi64( a, 32 ), b_odd ), 16 );
+    return _mm_blend_epi16( lo, hi, 0xCC );
+}
+
+/* The last 16 (or 12 for order 10) samples of the LPC state are kept in
+   registers, oldest first, and shifted by one sample per output. The
+   coefficients are stored reversed to match, and zero padded for order 10. */
+OPUS_SSE4_1_TARGET
+void silk_decode_short_term_prediction_sse4_1(
+    opus_int32                  sLPC_Q14[],                     /* I/O  LPC state                                   */
+    const opus_int32            pres_Q14[],                     /* I    LPC excitation                              */
+    const opus_int16            A_Q12[],                        /* I    LPC coefficients                            */
+    opus_int16                  xq[],                           /* O    Decoded speech                              */
+    opus_int32                  Gain_Q10,                       /* I    Subframe gain                               */
+    opus_int                    LPC_order,                      /* I    LPC order, 10 or 16                         */
+    opus_int                    length                          /* I    Subframe length                             */
+)
+{
+    opus_int   i, k, order_pad;
+    opus_int32 A_rev[ MAX_LPC_ORDER ];
+    opus_int32 *pLPC;
+    __m128i    s0, s1, s2, s3, a0, a1, a2, a3, b0, b1, b2, b3, acc, gain, gain_odd;
+
+    silk_assert( LPC_order == 10 || LPC_order == 16 );
+    order_pad = ( LPC_order + 3 ) & ~3;
+    for( k = 0; k < order_pad; k++ ) {
+        opus_int m = order_pad - 1 - k;
+        A_rev[ k ] = m < LPC_order ? A_Q12[ m ] : 0;
+    }
+    a0 = _mm_loadu_si128( (__m128i *)&A_rev[ 0 ] );
+    a1 = _mm_loadu_si128( (__m128i *)&A_rev[ 4 ] );
+    a2 = _mm_loadu_si128( (__m128i *)&A_rev[ 8 ] );
+    b0 = _mm_srli_epi64( a0, 32 );
+    b1 = _mm_srli_epi64( a1, 32 );
+    b2 = _mm_srli_epi64( a2, 32 );
+
+    pLPC = &sLPC_Q14[ MAX_LPC_ORDER - order_pad ];
+    s0 = _mm_loadu_si128( (__m128i *)&pLPC[ 0 ] );
+    s1 = _mm_loadu_si128( (__m128i *)&pLPC[ 4 ] );
+    s2 = _mm_loadu_si128( (__m128i *)&pLPC[ 8 ] );
+
+    if( LPC_order == 16 ) {
+        a3 = _mm_loadu_si128( (__m128i *)&A_rev[ 12 ] );
+        b3 = _mm_srli_epi64( a3, 32 );
+        s3 = _mm_loadu_si128( (__m128i *)&pLPC[ 12 ] );
+        for( i = 0; i < length; i++ ) {
+            __m128i x;
+            acc = _mm_add_epi32( silk_mul_Q16_sse4_1( s0, a0, b0 ), silk_mul_Q16_sse4_1( s1, a1, b1 ) );
+            acc = _mm_add_epi32( acc, silk_mul_Q16_sse4_1( s2, a2, b2 ) );
+            acc = _mm_add_epi32( acc, silk_mul_Q16_sse4_1( s3, a3, b3 ) );
+            acc = _mm_add_epi32( acc, _mm_shuffle_epi32( acc, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+            acc = _mm_add_epi32( acc, _mm_shuffle_epi32( acc, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+            /* Add prediction to LPC excitation, the bias avoids rounding to -inf */
+            sLPC_Q14[ MAX_LPC_ORDER + i ] = silk_ADD_LSHIFT32( pres_Q14[ i ],
+                silk_RSHIFT( LPC_order, 1 ) + _mm_cvtsi128_si32( acc ), 4 );
+            x  = _mm_cvtsi32_si128( sLPC_Q14[ MAX_LPC_ORDER + i ] );
+            s0 = _mm_alignr_epi8( s1, s0, 4 );
+            s1 = _mm_alignr_epi8( s2, s1, 4 );
+            s2 = _mm_alignr_epi8( s3, s2, 4 );
+            s3 = _mm_alignr_epi8( x, s3, 4 );
+        }
+    } else {
+        for( i = 0; i < length; i++ ) {
+            __m128i x;
+            acc = _mm_add_epi32( silk_mul_Q16_sse4_1( s0, a0, b0 ), silk_mul_Q16_sse4_1( s1, a1, b1 ) );
+            acc = _mm_add_epi32( acc, silk_mul_Q16_sse4_1( s2, a2, b2 ) );
+            acc = _mm_add_epi32( acc, _mm_shuffle_epi32( acc, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+            acc = _mm_add_epi32( acc, _mm_shuffle_epi32( acc, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+            sLPC_Q14[ MAX_LPC_ORDER + i ] = silk_ADD_LSHIFT32( pres_Q14[ i ],
+                silk_RSHIFT( LPC_order, 1 ) + _mm_cvtsi128_si32( acc ), 4 );
+            x  = _mm_cvtsi32_si128( sLPC_Q14[ MAX_LPC_ORDER + i ] );
+            s0 = _mm_alignr_epi8( s1, s0, 4 );
+            s1 = _mm_alignr_epi8( s2, s1, 4 );
+            s2 = _mm_alignr_epi8( x, s2, 4 );
+        }
+    }
+
+    /* Scale with gain */
+    gain     = _mm_set1_epi32( Gain_Q10 );
+    gain_odd = _mm_srli_epi64( gain, 32 );
+    for( i = 0; i + 8 <= length; i += 8 ) {
+        __m128i y0, y1;
+        y0 = silk_mul_Q16_sse4_1( _mm_loadu_si128( (__m128i *)&sLPC_Q14[ MAX_LPC_ORDER + i ] ), gain, gain_odd );
+        y1 = silk_mul_Q16_sse4_1( _mm_loadu_si128( (__m128i *)&sLPC_Q14[ MAX_LPC_ORDER + i + 4 ] ), gain, gain_odd );
+        y0 = _mm_srai_epi32( _mm_add_epi32( _mm_srai_epi32( y0, 7 ), _mm_set1_epi32( 1 ) ), 1 );
+        y1 = _mm_srai_epi32( _mm_add_epi32( _mm_srai_epi32( y1, 7 ), _mm_set1_epi32( 1 ) ), 1 );
+        _mm_storeu_si128( (__m128i *)&xq[ i ], _mm_packs_epi32( y0, y1 ) );
+    }
+    for( ; i < length; i++ ) {
+        xq[ i ] = (opus_int16)silk_SAT16( silk_RSHIFT_ROUND( silk_SMULWW( sLPC_Q14[ MAX_LPC_ORDER + i ], Gain_Q10 ), 8 ) );
+    }
+}
+
+#endif
@@ -0,0 +1,60 @@
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef MAIN_SSE_H
+#define MAIN_SSE_H
+
+#include "cpu_support.h"
+
+void silk_decode_short_term_prediction_sse4_1(
+    opus_int32                  sLPC_Q14[],                     /* I/O  LPC state                                   */
+    const opus_int32            pres_Q14[],                     /* I    LPC excitation                              */
+    const opus_int16            A_Q12[],                        /* I    LPC coefficients                            */
+    opus_int16                  xq[],                           /* O    Decoded speech                              */
+    opus_int32                  Gain_Q10,                       /* I    Subframe gain                               */
+    opus_int                    LPC_order,                      /* I    LPC order, 10 or 16                         */
+    opus_int                    length                          /* I    Subframe length                             */
+);
+
+#if defined(OPUS_HAVE_RTCD)
+
+extern void (*const SILK_DECODE_SHORT_TERM_PREDICTION_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    opus_int32                  sLPC_Q14[],
+    const opus_int32            pres_Q14[],
+    const opus_int16            A_Q12[],
+    opus_int16                  xq[],
+    opus_int32                  Gain_Q10,
+    opus_int                    LPC_order,
+    opus_int                    length
+);
+
+#define OVERRIDE_silk_decode_short_term_prediction
+#define silk_decode_short_term_prediction(sLPC_Q14, pres_Q14, A_Q12, xq, Gain_Q10, LPC_order, length, arch) \
+    ((*SILK_DECODE_SHORT_TERM_PREDICTION_IMPL[ (arch) & OPUS_ARCHMASK ])(sLPC_Q14, pres_Q14, A_Q12, xq, \
+    Gain_Q10, LPC_order, length))
+
+#endif
+
+#endif
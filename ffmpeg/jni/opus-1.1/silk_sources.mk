@@ -76,6 +76,16 @@ silk/stereo_encode_pred.c \
 silk/stereo_find_predictor.c \
 silk/stereo_quant_pred.c
 
+SILK_SOURCES_SSE4_1 = \
+silk/x86/x86_silk_map.c \
+silk/x86/decode_core_sse4_1.c
+
+SILK_SOURCES_ARM = \
+silk/arm/arm_silk_map.c
+
+SILK_SOURCES_ARM_NEON_INTR = \
+silk/arm/decode_core_neon_intr.c
+
 
 SILK_SOURCES_FIXED = \
 silk/fixed/LTP_analysis_filter_FIX.c \
@@ -0,0 +1,271 @@
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* Decodes Opus test vectors (.bit files as written by opus_demo -e) once
+   with the plain C kernels and once with the SIMD kernels selected at run
+   time, checks that the output and the final range coder states are
+   identical, and prints the decoding time of both. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "opus.h"
+#include "opus_types.h"
+#include "opus_private.h"
+#include "cpu_support.h"
+
+#define MAX_PACKET 1500
+#define MAX_FRAME_SIZE (48000*2*60/1000)
+
+typedef struct {
+    int            count;
+    int           *len;
+    opus_uint32   *rng;
+    unsigned char *data;
+} Vector;
+
+static void print_usage(char *argv[])
+{
+    fprintf(stderr, "Usage: %s [options] <sampling rate (Hz)> <channels (1/2)> "
+        "<input.bit> [<input.bit> ...]\n", argv[0]);
+    fprintf(stderr, "options:\n");
+    fprintf(stderr, "-loss <perc>         : simulate packet loss, in percent (0-100); default: 0\n");
+    fprintf(stderr, "-runs <n>            : decode each vector n times, the best time is printed; default: 5\n");
+}
+
+static opus_uint32 char_to_int(unsigned char ch[4])
+{
+    return ((opus_uint32)ch[0]<<24) | ((opus_uint32)ch[1]<<16)
+         | ((opus_uint32)ch[2]<< 8) |  (opus_uint32)ch[3];
+}
+
+static int read_vector(const char *name, Vector *v)
+{
+    FILE *fin;
+    int size = 0, alloc = 0;
+    unsigned char ch[4];
+
+    memset(v, 0, sizeof(*v));
+    fin = fopen(name, "rb");
+    if (!fin)
+    {
+        fprintf(stderr, "Could not open input file %s\n", name);
+        return -1;
+    }
+    while (fread(ch, 1, 4, fin) == 4)
+    {
+        int len = char_to_int(ch);
+        if (len > MAX_PACKET || len < 0 || fread(ch, 1, 4, fin) != 4)
+        {
+            fprintf(stderr, "%s: invalid packet %d\n", name, v->count);
+            break;
+        }
+        if (v->count == alloc)
+        {
+            alloc = alloc ? 2*alloc : 256;
+            v->len = (int *)realloc(v->len, alloc*sizeof(*v->len));
+            v->rng = (opus_uint32 *)realloc(v->rng, alloc*sizeof(*v->rng));
+            v->data = (unsigned char *)realloc(v->data, alloc*MAX_PACKET);
+            if (!v->len || !v->rng || !v->data)
+            {
+                fprintf(stderr, "Out of memory\n");
+                fclose(fin);
+                return -1;
+            }
+        }
+        v->len[v->count] = len;
+        v->rng[v->count] = char_to_int(ch);
+        if (fread(v->data + size, 1, len, fin) != (size_t)len)
+        {
+            fprintf(stderr, "%s: ran out of input in packet %d\n", name, v->count);
+            break;
+        }
+        size += MAX_PACKET;
+        v->count++;
+    }
+    fclose(fin);
+    return 0;
+}
+
+/* Decodes the whole vector with the kernels of the given arch, returning the
+   number of samples written to pcm or a negative value on error. The final
+   range of each packet is stored in rng. */
+static int decode_vector(const Vector *v, opus_int32 Fs, int channels,
+      int arch, int loss, opus_int16 *pcm, opus_uint32 *rng, double *seconds)
+{
+    OpusDecoder *dec;
+    int i, err, total = 0;
+    opus_uint32 seed = 0x12345678;
+    clock_t start;
+
+    dec = opus_decoder_create(Fs, channels, &err);
+    if (err != OPUS_OK)
+    {
+        fprintf(stderr, "Cannot create decoder: %s\n", opus_strerror(err));
+        return -1;
+    }
+    opus_decoder_ctl(dec, OPUS_SET_ARCH(arch));
+
+    start = clock();
+    for (i=0;i<v->count;i++)
+    {
+        int lost, samples;
+        /* the same packets are lost in every run */
+        seed = 1664525*seed + 1013904223;
+        lost = v->len[i] == 0 || (int)((seed>>16)%100) < loss;
+        if (lost)
+        {
+            opus_decoder_ctl(dec, OPUS_GET_LAST_PACKET_DURATION(&samples));
+            if (samples <= 0)
+                samples = Fs/50;
+            samples = opus_decode(dec, NULL, 0, pcm + total*channels, samples, 0);
+        } else {
+            samples = opus_decode(dec, v->data + i*MAX_PACKET, v->len[i],
+                  pcm + total*channels, MAX_FRAME_SIZE, 0);
+        }
+        if (samples < 0)
+        {
+            fprintf(stderr, "error decoding packet %d: %s\n", i, opus_strerror(samples));
+            opus_decoder_destroy(dec);
+            return -1;
+        }
+        opus_decoder_ctl(dec, OPUS_GET_FINAL_RANGE(&rng[i]));
+        if (lost)
+            rng[i] = 0;
+        total += samples;
+    }
+    *seconds = (double)(clock() - start)/CLOCKS_PER_SEC;
+
+    opus_decoder_destroy(dec);
+    return total;
+}
+
+int main(int argc, char *argv[])
+{
+    int args = 1, channels, loss = 0, runs = 5, arch, failed = 0, i;
+    opus_int32 Fs;
+
+    while (args < argc && argv[args][0] == '-')
+    {
+        if (strcmp(argv[args], "-loss") == 0 && args + 1 < argc)
+            loss = atoi(argv[++args]);
+        else if (strcmp(argv[args], "-runs") == 0 && args + 1 < argc)
+            runs = atoi(argv[++args]);
+        else
+        {
+            print_usage(argv);
+            return EXIT_FAILURE;
+        }
+        args++;
+    }
+    if (argc - args < 3 || runs < 1)
+    {
+        print_usage(argv);
+        return EXIT_FAILURE;
+    }
+    Fs = (opus_int32)atol(argv[args]);
+    channels = atoi(argv[args + 1]);
+    args += 2;
+
+    arch = opus_select_arch();
+    fprintf(stderr, "%s, run-time arch %d\n", opus_get_version_string(), arch);
+    printf("%-32s %8s %10s %10s %8s\n", "vector", "packets", "C (ms)", "SIMD (ms)", "speedup");
+
+    for (; args < argc; args++)
+    {
+        Vector v;
+        opus_int16 *pcm[2];
+        opus_uint32 *rng[2];
+        double best[2];
+        int samples[2] = { 0, 0 };
+        int r, k;
+
+        if (read_vector(argv[args], &v) < 0)
+            return EXIT_FAILURE;
+        for (k=0;k<2;k++)
+        {
+            pcm[k] = (opus_int16 *)malloc(((size_t)v.count + 1)*MAX_FRAME_SIZE*channels*sizeof(opus_int16));
+            rng[k] = (opus_uint32 *)malloc(((size_t)v.count + 1)*sizeof(opus_uint32));
+            if (!pcm[k] || !rng[k])
+            {
+                fprintf(stderr, "Out of memory\n");
+                return EXIT_FAILURE;
+            }
+            best[k] = -1;
+        }
+
+        for (r=0;r<runs;r++)
+        {
+            for (k=0;k<2;k++)
+            {
+                double t;
+                samples[k] = decode_vector(&v, Fs, channels, k ? arch : 0, loss,
+                      pcm[k], rng[k], &t);
+                if (samples[k] < 0)
+                    return EXIT_FAILURE;
+                if (best[k] < 0 || t < best[k])
+                    best[k] = t;
+            }
+        }
+
+        printf("%-32s %8d %10.2f %10.2f %7.2fx\n", argv[args], v.count,
+              1000*best[0], 1000*best[1], best[1] > 0 ? best[0]/best[1] : 0.0);
+
+        if (samples[0] != samples[1]
+         || memcmp(pcm[0], pcm[1], samples[0]*channels*sizeof(opus_int16)))
+        {
+            fprintf(stderr, "%s: the SIMD output differs from the C output\n", argv[args]);
+            failed = 1;
+        }
+        for (i=0;i<v.count;i++)
+        {
+            if (rng[0][i] != rng[1][i] || (rng[0][i] && v.rng[i] && rng[0][i] != v.rng[i]))
+            {
+                fprintf(stderr, "%s: range coder state mismatch in packet %d: "
+                      "0x%8lx (C) 0x%8lx (SIMD) 0x%8lx (encoder)\n", argv[args], i,
+                      (unsigned long)rng[0][i], (unsigned long)rng[1][i],
+                      (unsigned long)v.rng[i]);
+                failed = 1;
+                break;
+            }
+        }
+
+        for (k=0;k<2;k++)
+        {
+            free(pcm[k]);
+            free(rng[k]);
+        }
+        free(v.len);
+        free(v.rng);
+        free(v.data);
+    }
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -82,6 +82,12 @@ int get_mono_channel(const ChannelLayout *layout, int stream_id, int prev);
 #define OPUS_SET_FORCE_MODE_REQUEST    11002
 #define OPUS_SET_FORCE_MODE(x) OPUS_SET_FORCE_MODE_REQUEST, __opus_check_int(x)
 
+/** Restricts the decoder to the kernels of the given run-time architecture
+  * (0 is plain C). Values above what the CPU supports are clamped.
+  * @hideinitializer */
+#define OPUS_SET_ARCH_REQUEST    11020
+#define OPUS_SET_ARCH(x) OPUS_SET_ARCH_REQUEST, __opus_check_int(x)
+
 typedef void (*downmix_func)(const void *, opus_val32 *, int, int, int, int, int);
 void downmix_float(const void *_x, opus_val32 *sub, int subframe, int offset, int c1, int c2, int C);
 void downmix_int(const void *_x, opus_val32 *sub, int subframe, int offset, int c1, int c2, int C);